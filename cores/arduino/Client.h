@@ -31,6 +31,7 @@ public:
   virtual size_t write(uint8_t) =0;
   virtual size_t write(const uint8_t *buf, size_t size) =0;
   virtual int available() = 0;
+  using Stream::read;
   virtual int read() = 0;
   virtual int read(uint8_t *buf, size_t size) = 0;
   virtual int peek() = 0;
@@ -0,0 +1,208 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Stackless coroutines run from the main() loop.
+
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "Arduino.h"
+
+Coroutine *Coroutine::_first = NULL;
+
+// Event of each external interrupt line, see CoroutineEvent::attachPin()
+static CoroutineEvent *edgeEvents[16] = {NULL};
+
+template<uint8_t line> static void edgeCallback(void)
+{
+  if (edgeEvents[line] != NULL) {
+    edgeEvents[line]->signal();
+  }
+}
+
+static void (* const edgeCallbacks[16])(void) = {
+  edgeCallback<0>, edgeCallback<1>, edgeCallback<2>, edgeCallback<3>,
+  edgeCallback<4>, edgeCallback<5>, edgeCallback<6>, edgeCallback<7>,
+  edgeCallback<8>, edgeCallback<9>, edgeCallback<10>, edgeCallback<11>,
+  edgeCallback<12>, edgeCallback<13>, edgeCallback<14>, edgeCallback<15>
+};
+
+CoroutineEvent::CoroutineEvent(void)
+{
+  _count = 0;
+  _pin = NUM_DIGITAL_PINS;
+}
+
+CoroutineEvent::~CoroutineEvent()
+{
+  detachPin();
+}
+
+void CoroutineEvent::signal(void)
+{
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  _count++;
+  __set_PRIMASK(primask);
+}
+
+bool CoroutineEvent::take(void)
+{
+  uint32_t primask;
+  bool taken = false;
+
+  if (_count == 0) {
+    return false;
+  }
+  primask = __get_PRIMASK();
+  __disable_irq();
+  if (_count > 0) {
+    _count--;
+    taken = true;
+  }
+  __set_PRIMASK(primask);
+  return taken;
+}
+
+void CoroutineEvent::clear(void)
+{
+  _count = 0;
+}
+
+void CoroutineEvent::attachPin(uint32_t pin, uint32_t mode)
+{
+  PinName p = digitalPinToPinName(pin);
+
+  detachPin();
+  if (p == NC) {
+    return;
+  }
+  _pin = pin;
+  edgeEvents[STM_PIN(p)] = this;
+  attachInterrupt(pin, edgeCallbacks[STM_PIN(p)], mode);
+}
+
+void CoroutineEvent::detachPin(void)
+{
+  if (_pin >= NUM_DIGITAL_PINS) {
+    return;
+  }
+  detachInterrupt(_pin);
+  if (edgeEvents[STM_PIN(digitalPinToPinName(_pin))] == this) {
+    edgeEvents[STM_PIN(digitalPinToPinName(_pin))] = NULL;
+  }
+  _pin = NUM_DIGITAL_PINS;
+}
+
+Coroutine::Coroutine(void)
+{
+  _coState = 0;
+  _coStart = 0;
+  _coDelay = 0;
+  _coRunning = false;
+  _coWaiting = false;
+  _coTimedOut = false;
+  _next = NULL;
+}
+
+Coroutine::~Coroutine()
+{
+  unlink();
+}
+
+void Coroutine::start(void)
+{
+  Coroutine *co;
+
+  _coState = 0;
+  _coWaiting = false;
+  _coTimedOut = false;
+  _coRunning = true;
+  // Still linked if stopped during the current pass
+  for (co = _first; co != NULL; co = co->_next) {
+    if (co == this) {
+      return;
+    }
+  }
+  _next = _first;
+  _first = this;
+}
+
+void Coroutine::stop(void)
+{
+  _coRunning = false;
+}
+
+bool Coroutine::isRunning(void)
+{
+  return _coRunning;
+}
+
+bool Coroutine::timedOut(void)
+{
+  return _coTimedOut;
+}
+
+void Coroutine::unlink(void)
+{
+  Coroutine **link;
+
+  for (link = &_first; *link != NULL; link = &((*link)->_next)) {
+    if (*link == this) {
+      *link = _next;
+      break;
+    }
+  }
+  _coRunning = false;
+}
+
+void Coroutine::runAll(void)
+{
+  Coroutine *co = _first;
+  Coroutine *next;
+
+  while (co != NULL) {
+    // run() could stop or start coroutines
+    next = co->_next;
+    if (co->_coRunning) {
+      co->run();
+    }
+    if (!co->_coRunning) {
+      co->unlink();
+    }
+    co = next;
+  }
+}
+
+void Coroutine::idle(void)
+{
+  Coroutine *co;
+
+  for (co = _first; co != NULL; co = co->_next) {
+    if (co->_coRunning && !co->_coWaiting) {
+      return;
+    }
+  }
+  // The awaited conditions change on interrupts (pin edge, UART, DMA) or
+  // with the time: both wake up the core.
+  TimeBaseIdle();
+}
+
+void coroutineRun(void)
+{
+  Coroutine::runAll();
+}
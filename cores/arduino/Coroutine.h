@@ -0,0 +1,141 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Stackless coroutines run from the main() loop.
+
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _COROUTINE_H_
+#define _COROUTINE_H_
+
+#ifdef __cplusplus
+
+/*
+ * A coroutine is a class derived from Coroutine whose run() function is
+ * written between CO_BEGIN() and CO_END(). run() is called after each loop()
+ * and returns at each CO_YIELD() or unsatisfied CO_AWAIT(), the next call
+ * resumes from there. Several flows are interleaved without any stack:
+ * - the local variables are lost when run() returns, use members,
+ * - switch statements can't contain CO_ macros.
+ *
+ * class Blink : public Coroutine {
+ *   bool on = false;
+ *   void run(void) {
+ *     CO_BEGIN();
+ *     for (;;) {
+ *       digitalWrite(LED_BUILTIN, on = !on);
+ *       CO_DELAY(500);
+ *     }
+ *     CO_END();
+ *   }
+ * };
+ */
+
+// Resumes at the last wait point
+#define CO_BEGIN()      switch (_coState) { case 0:
+
+// End of the flow, the coroutine is stopped
+#define CO_END()        } _coState = 0; _coRunning = false; return
+
+// Let the other flows and loop() run
+#define CO_YIELD()      do { _coState = __LINE__; _coWaiting = false; return; \
+                          case __LINE__:; } while (0)
+
+// Wait until cond is true, it is evaluated at each pass
+#define CO_AWAIT(cond)  do { if (0) { case __LINE__:; } \
+                          if (!(cond)) { _coState = __LINE__; _coWaiting = true; return; } \
+                          _coWaiting = false; } while (0)
+
+// Wait until cond is true or for ms milliseconds, see timedOut()
+#define CO_AWAIT_TIMEOUT(cond, ms) do { _coStart = millis(); _coDelay = (ms); \
+                          CO_AWAIT((_coTimedOut = false, (cond)) || \
+                                   (_coTimedOut = (millis() - _coStart >= _coDelay))); \
+                          } while (0)
+
+#define CO_DELAY(ms)    do { _coStart = millis(); _coDelay = (ms); \
+                          CO_AWAIT(millis() - _coStart >= _coDelay); } while (0)
+
+// Wait for count bytes in a Stream (Serial, Wire...)
+#define CO_AWAIT_AVAILABLE(stream, count) CO_AWAIT((stream).available() >= (int)(count))
+
+// Wait for a CoroutineEvent, the signal is consumed
+#define CO_AWAIT_EVENT(event) CO_AWAIT((event).take())
+
+// Flag set from an interrupt handler (DMA transfer complete callback for
+// example) or a pin edge, and awaited by a coroutine.
+class CoroutineEvent {
+  public:
+    CoroutineEvent(void);
+    ~CoroutineEvent();
+
+    // Could be called from an interrupt handler, the signals are counted
+    void signal(void);
+    // Consume one signal, false if there is none
+    bool take(void);
+    void clear(void);
+
+    // Signal on the edges of a pin: RISING, FALLING or CHANGE. One event
+    // per external interrupt line (PA0 and PB0 share the line 0).
+    void attachPin(uint32_t pin, uint32_t mode);
+    void detachPin(void);
+
+  private:
+    volatile uint32_t _count;
+    uint32_t _pin;        // NUM_DIGITAL_PINS if not attached
+};
+
+class Coroutine {
+  public:
+    Coroutine(void);
+    virtual ~Coroutine();
+
+    // Run from the beginning after the next loop(), or stop the flow
+    void start(void);
+    void stop(void);
+    bool isRunning(void);
+    // true if the last CO_AWAIT_TIMEOUT() ended by the timeout
+    bool timedOut(void);
+
+    // Called by main() after each loop()
+    static void runAll(void);
+    // Could be called at the end of loop(): sleeps until the next interrupt
+    // (at least the next tick) when all the coroutines are waiting.
+    static void idle(void);
+
+  protected:
+    virtual void run(void) = 0;
+
+    // State of the CO_ macros
+    uint32_t _coState;
+    uint32_t _coStart;
+    uint32_t _coDelay;
+    bool _coRunning;
+    bool _coWaiting;
+    bool _coTimedOut;
+
+  private:
+    Coroutine *_next;
+    static Coroutine *_first;
+
+    void unlink(void);
+};
+
+extern void coroutineRun(void) __attribute__((weak));
+
+#endif // __cplusplus
+
+#endif /* _COROUTINE_H_ */
@@ -170,13 +170,34 @@ void HardwareSerial::init(void)
   _serial.rx_buff = _rx_buffer;
   _serial.rx_head = 0;
   _serial.rx_tail = 0;
+  _serial.rx_delimiter = -1;
+  _serial.rx_frame_head = 0;
+  _serial.rx_frame_tail = 0;
+  _serial.pin_de = NC;
+  _serial.de_inverted = 0;
+  _serial.address = -1;
+  _frameEnd = -1;
+  memset(&_serial.stats, 0, sizeof(uart_stats_t));
   _serial.tx_buff = _tx_buffer;
   _serial.tx_head = 0;
   _serial.tx_tail = 0;
+  _serial.tx_written = 0;
 }
 
 // Actual interrupt handlers //////////////////////////////////////////////////////////////
 
+// Queue the end of the frame being received. When the queue is full it is
+// not recorded: the frame is merged with the next one.
+static void _rx_frame_end(serial_t* obj)
+{
+  uint8_t next = (obj->rx_frame_head + 1) % UART_FRAME_QUEUE;
+
+  if (next != obj->rx_frame_tail) {
+    obj->rx_frame_end[obj->rx_frame_head] = obj->rx_head;
+    obj->rx_frame_head = next;
+  }
+}
+
 void HardwareSerial::_rx_complete_irq(serial_t* obj)
 {
   // No Parity error, read byte and store it in the buffer if there is room
@@ -185,6 +206,7 @@ void HardwareSerial::_rx_complete_irq(serial_t* obj)
   if (uart_getc(obj, &c) == 0) {
 
     rx_buffer_index_t i = (unsigned int)(obj->rx_head + 1) % SERIAL_RX_BUFFER_SIZE;
+    rx_buffer_index_t used;
 
     // if we should be storing the received character into the location
     // just before the tail (meaning that the head would advance to the
@@ -193,8 +215,37 @@ void HardwareSerial::_rx_complete_irq(serial_t* obj)
     if (i != obj->rx_tail) {
       obj->rx_buff[obj->rx_head] = c;
       obj->rx_head = i;
+
+      used = (unsigned int)(SERIAL_RX_BUFFER_SIZE + i - obj->rx_tail) % SERIAL_RX_BUFFER_SIZE;
+      if (used > obj->stats.rxPeak) {
+        obj->stats.rxPeak = used;
+      }
+
+      // A frame filling the buffer is ended, so that it can be released
+      if ((c == obj->rx_delimiter) ||
+          ((obj->rx_frame_head == obj->rx_frame_tail) &&
+           ((rx_buffer_index_t)(i + 1) % SERIAL_RX_BUFFER_SIZE == obj->rx_tail))) {
+        _rx_frame_end(obj);
+      }
+    } else {
+      obj->stats.rxDropped++;
+    }
+  }
+}
+
+void HardwareSerial::_rx_idle_irq(serial_t* obj)
+{
+  uint8_t last = obj->rx_frame_head;
+
+  // Nothing received since the end of the last frame
+  if (last == obj->rx_frame_tail) {
+    if (obj->rx_head == obj->rx_tail) {
+      return;
     }
+  } else if (obj->rx_frame_end[(last + UART_FRAME_QUEUE - 1) % UART_FRAME_QUEUE] == obj->rx_head) {
+    return;
   }
+  _rx_frame_end(obj);
 }
 
 // Actual interrupt handlers //////////////////////////////////////////////////////////////
@@ -212,6 +263,31 @@ int HardwareSerial::_tx_complete_irq(serial_t* obj)
   return 0;
 }
 
+size_t HardwareSerial::_tx_write(serial_t* obj, const uint8_t *data, uint32_t size)
+{
+  tx_buffer_index_t head = obj->tx_head;
+  tx_buffer_index_t i;
+  uint32_t n = 0;
+
+  while (n < size) {
+    i = (head + 1) % SERIAL_TX_BUFFER_SIZE;
+    if (i == obj->tx_tail) {
+      break;
+    }
+    obj->tx_buff[head] = data[n++];
+    head = i;
+  }
+
+  if (n > 0) {
+    obj->tx_head = head;
+    obj->tx_written = 1;
+    if(!serial_tx_active(obj)) {
+      uart_attach_tx_callback(obj, _tx_complete_irq);
+    }
+  }
+  return n;
+}
+
 // Public Methods //////////////////////////////////////////////////////////////
 
 void HardwareSerial::begin(unsigned long baud, byte config)
@@ -231,6 +307,9 @@ void HardwareSerial::begin(unsigned long baud, byte config)
     case 0x06:
       databits = 8;
       break;
+    case 0x07:
+      databits = 9;
+      break;
     default:
       databits = 0;
       break;
@@ -273,6 +352,10 @@ void HardwareSerial::begin(unsigned long baud, byte config)
 
   uart_init(&_serial);
   uart_attach_rx_callback(&_serial, _rx_complete_irq);
+  if (_frameEnd >= 0) {
+    uart_attach_idle_callback(&_serial, _rx_idle_irq, _frameEnd);
+  }
+  uart_debug_attach(&_serial, _tx_write);
 }
 
 void HardwareSerial::end()
@@ -280,10 +363,12 @@ void HardwareSerial::end()
   // wait for transmission of outgoing data
   flush();
 
+  uart_debug_attach(&_serial, NULL);
   uart_deinit(&_serial);
 
   // clear any received data
   _serial.rx_head = _serial.rx_tail;
+  _serial.rx_frame_tail = _serial.rx_frame_head;
 }
 
 int HardwareSerial::available(void)
@@ -312,6 +397,121 @@ int HardwareSerial::read(void)
   }
 }
 
+int HardwareSerial::read(uint8_t *buffer, size_t size)
+{
+  rx_buffer_index_t head = _serial.rx_head;
+  rx_buffer_index_t tail = _serial.rx_tail;
+  size_t count = 0;
+
+  // At most two copies: up to the end of the ring, then from its start
+  while (count < size && tail != head) {
+    size_t n = ((head > tail) ? head : SERIAL_RX_BUFFER_SIZE) - tail;
+    if (n > size - count) n = size - count;
+    memcpy(buffer + count, &_serial.rx_buff[tail], n);
+    count += n;
+    tail = (rx_buffer_index_t)(tail + n) % SERIAL_RX_BUFFER_SIZE;
+  }
+  _serial.rx_tail = tail;
+  return count;
+}
+
+void HardwareSerial::setFrameDelimiter(int delimiter)
+{
+  _serial.rx_delimiter = (delimiter < 0) ? -1 : (uint8_t)delimiter;
+}
+
+void HardwareSerial::setFrameIdle(bool enable)
+{
+  _frameEnd = enable ? 0 : -1;
+  // Applied by begin() if the UART is not initialized yet
+  uart_attach_idle_callback(&_serial, enable ? _rx_idle_irq : NULL, 0);
+}
+
+bool HardwareSerial::setFrameTimeout(uint32_t bits)
+{
+  if (bits == 0) {
+    setFrameIdle(false);
+    return true;
+  }
+  if (!uart_attach_idle_callback(&_serial, _rx_idle_irq, bits)) {
+    _frameEnd = -1;
+    return false;
+  }
+  _frameEnd = bits;
+  return true;
+}
+
+bool HardwareSerial::readFrame(SerialFrame &frame)
+{
+  rx_buffer_index_t tail = _serial.rx_tail;
+  rx_buffer_index_t end;
+  size_t size;
+
+  if (_serial.rx_frame_head == _serial.rx_frame_tail) {
+    return false;
+  }
+  end = _serial.rx_frame_end[_serial.rx_frame_tail];
+  size = (unsigned int)(SERIAL_RX_BUFFER_SIZE + end - tail) % SERIAL_RX_BUFFER_SIZE;
+
+  frame.delimited = (size > 0) && (_serial.rx_delimiter >= 0) &&
+    (_serial.rx_buff[(rx_buffer_index_t)(end + SERIAL_RX_BUFFER_SIZE - 1) % SERIAL_RX_BUFFER_SIZE] == _serial.rx_delimiter);
+  if (frame.delimited) {
+    size--;
+  }
+  frame.data = &_serial.rx_buff[tail];
+  if (tail + size > SERIAL_RX_BUFFER_SIZE) {
+    frame.length = SERIAL_RX_BUFFER_SIZE - tail;
+    frame.wrap = _serial.rx_buff;
+    frame.wrapLength = size - frame.length;
+  } else {
+    frame.length = size;
+    frame.wrap = NULL;
+    frame.wrapLength = 0;
+  }
+  return true;
+}
+
+void HardwareSerial::releaseFrame(void)
+{
+  uint8_t index = _serial.rx_frame_tail;
+
+  if (index != _serial.rx_frame_head) {
+    _serial.rx_tail = _serial.rx_frame_end[index];
+    _serial.rx_frame_tail = (index + 1) % UART_FRAME_QUEUE;
+  }
+}
+
+void HardwareSerial::setRS485(uint32_t dePin, bool inverted)
+{
+  _serial.pin_de = digitalPinToPinName(dePin);
+  _serial.de_inverted = inverted ? 1 : 0;
+}
+
+bool HardwareSerial::setAddress(int address)
+{
+  if (address > UART_ADDRESS_MAX) {
+    return false;
+  }
+  _serial.address = (address < 0) ? -1 : address;
+  return true;
+}
+
+void HardwareSerial::mute(void)
+{
+  uart_mute(&_serial);
+}
+
+size_t HardwareSerial::writeAddress(uint8_t address)
+{
+  flush();
+  return uart_write_address(&_serial, address);
+}
+
+void HardwareSerial::getStats(uart_stats_t &stats, bool clear)
+{
+  uart_get_stats(&_serial, &stats, clear ? 1 : 0);
+}
+
 int HardwareSerial::availableForWrite(void)
 {
   tx_buffer_index_t head = _serial.tx_head;
@@ -326,7 +526,7 @@ void HardwareSerial::flush()
   // If we have never written a byte, no need to flush. This special
   // case is needed since there is no way to force the TXC (transmit
   // complete) bit to 1 during initialization
-  if (!_written)
+  if (!_serial.tx_written)
     return;
 
   while((_serial.tx_head != _serial.tx_tail)) {
@@ -338,7 +538,7 @@ void HardwareSerial::flush()
 
 size_t HardwareSerial::write(uint8_t c)
 {
-  _written = true;
+  _serial.tx_written = 1;
 
   tx_buffer_index_t i = (_serial.tx_head + 1) % SERIAL_TX_BUFFER_SIZE;
 
@@ -358,6 +558,19 @@ size_t HardwareSerial::write(uint8_t c)
   return 1;
 }
 
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size)
+{
+  size_t n = 0;
+
+  while (n < size) {
+    // If the output buffer is full, wait for the interrupt handler to
+    // empty it a bit
+    n += _tx_write(&_serial, buffer + n, size - n);
+  }
+
+  return size;
+}
+
 void HardwareSerial::setRx(uint32_t _rx) {
   _serial.pin_rx = digitalPinToPinName(_rx);
 }
@@ -85,13 +85,27 @@ typedef uint8_t rx_buffer_index_t;
 #define SERIAL_8O1 0x36
 #define SERIAL_7O2 0x3C
 #define SERIAL_8O2 0x3E
+// 9 data bits, no parity: multiprocessor mode
+#define SERIAL_9N1 0x07
+#define SERIAL_9N2 0x0F
+
+// Frame received, see HardwareSerial::readFrame(). The bytes are those of the
+// receive buffer: a frame which wraps around the end of the buffer is made
+// of two parts.
+struct SerialFrame {
+  const uint8_t *data;    // first part
+  size_t length;
+  const uint8_t *wrap;    // second part, at the start of the buffer, or NULL
+  size_t wrapLength;
+  bool delimited;         // ended by the delimiter, not included
+
+  size_t size(void) const { return length + wrapLength; }
+  uint8_t operator[](size_t i) const { return (i < length) ? data[i] : wrap[i - length]; }
+};
 
 class HardwareSerial : public Stream
 {
   protected:
-    // Has any byte been written to the UART since begin()
-    bool _written;
-
     // Don't put any members after these buffers, since only the first
     // 32 bytes of this struct can be accessed quickly using the ldd
     // instruction.
@@ -99,6 +113,7 @@ class HardwareSerial : public Stream
     unsigned char _tx_buffer[SERIAL_TX_BUFFER_SIZE];
 
     serial_t _serial;
+    int32_t _frameEnd;    // -1: none, 0: idle line, else timeout in bits
 
   public:
     HardwareSerial(PinName _rx, PinName _tx);
@@ -108,10 +123,13 @@ class HardwareSerial : public Stream
     void end();
     virtual int available(void);
     virtual int peek(void);
+    using Stream::read;
     virtual int read(void);
+    virtual int read(uint8_t *buffer, size_t size);
     int availableForWrite(void);
     virtual void flush(void);
     virtual size_t write(uint8_t);
+    virtual size_t write(const uint8_t *buffer, size_t size);
     inline size_t write(unsigned long n) { return write((uint8_t)n); }
     inline size_t write(long n) { return write((uint8_t)n); }
     inline size_t write(unsigned int n) { return write((uint8_t)n); }
@@ -119,6 +137,41 @@ class HardwareSerial : public Stream
     using Print::write; // pull in write(str) and write(buf, size) from Print
     operator bool() { return true; }
 
+    // Frame reader: a frame ends with the delimiter byte, when the line
+    // becomes idle if enabled, or when the receive buffer is full. It stays
+    // in the buffer, without copy, until it is released. Do not mix with the
+    // read functions.
+    void setFrameDelimiter(int delimiter);  // -1: none
+    void setFrameIdle(bool enable);
+    // End frames after a silence of bits bit times instead (receiver
+    // timeout, 0 to disable). false if the USART does not support it.
+    bool setFrameTimeout(uint32_t bits);
+    // false if no frame is complete. Returns the oldest frame until it is
+    // released.
+    bool readFrame(SerialFrame &frame);
+    void releaseFrame(void);
+
+    // RS-485: pin enabling the transceiver driver while transmitting, high
+    // unless inverted. Driven by the USART when it is its RTS pin and the
+    // series has the driver enable mode, from the interrupts otherwise.
+    // Call before begin().
+    void setRS485(uint32_t dePin, bool inverted = false);
+    // Multiprocessor mode with address mark, normally with SERIAL_9N1: the
+    // receiver ignores the bytes until an address (9th bit set) matching
+    // address is received, itself received as a normal byte. -1 to disable.
+    // Call before begin(). The address must fit in the data bits but the
+    // address mark: 0 to 127 with 8 data bits, to UART_ADDRESS_MAX (255)
+    // with 9 (or 15 without 7-bit address detection), else begin() fails.
+    bool setAddress(int address);
+    // Ignore the bytes until the next matching address
+    void mute(void);
+    // Send an address, after the bytes waiting in the transmit buffer
+    size_t writeAddress(uint8_t address);
+
+    // Counters since the creation of the object, see uart_stats_t. clear:
+    // set them to 0 after the copy.
+    void getStats(uart_stats_t &stats, bool clear = false);
+
     void setRx(uint32_t _rx);
     void setTx(uint32_t _tx);
     void setRx(PinName _rx);
@@ -126,7 +179,10 @@ class HardwareSerial : public Stream
 
     // Interrupt handlers
     static void _rx_complete_irq(serial_t* obj);
+    static void _rx_idle_irq(serial_t* obj);
     static int _tx_complete_irq(serial_t* obj);
+    // Copies what fits in the transmit buffer, without waiting: printf output
+    static size_t _tx_write(serial_t* obj, const uint8_t *data, uint32_t size);
   private:
     void init(void);
 };
@@ -0,0 +1,617 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  General purpose access to the STM32 timers.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "Arduino.h"
+#include "HardwareTimer.h"
+
+// Object owning each timer, indexed as in timer.c (TIMx -> x - 1)
+static HardwareTimer *HardwareTimer_Handle[TIMER_NUM] = {NULL};
+
+// Convert a channel number (1 to 4) to TIM_CHANNEL_x, 0xFFFFFFFF if invalid
+static uint32_t getChannel(uint32_t channel)
+{
+  switch(channel) {
+    case 1:
+      return TIM_CHANNEL_1;
+    case 2:
+      return TIM_CHANNEL_2;
+    case 3:
+      return TIM_CHANNEL_3;
+    case 4:
+      return TIM_CHANNEL_4;
+    default:
+      return 0xFFFFFFFF;
+  }
+}
+
+// Capture/compare interrupt of a channel number (1 to 4)
+static inline uint32_t getChannelIT(uint32_t channel)
+{
+  return TIM_IT_CC1 << (channel - 1);
+}
+
+// Kinds of channel initialized by the HAL on top of the time base
+enum {
+  HAL_INIT_OC = 0,
+  HAL_INIT_PWM,
+  HAL_INIT_IC
+};
+
+static inline bool isInputMode(TimerModes_t mode)
+{
+  return (mode == TIMER_INPUT_CAPTURE_RISING) ||
+         (mode == TIMER_INPUT_CAPTURE_FALLING) ||
+         (mode == TIMER_INPUT_CAPTURE_BOTHEDGE);
+}
+
+HardwareTimer::HardwareTimer(TIM_TypeDef *instance)
+{
+  TIM_HandleTypeDef *handle = &(_timerObj.handle);
+  int8_t index = getTimerIndex(instance);
+
+  memset(&_timerObj, 0, sizeof(stimer_t));
+  _timerObj.pin = NC;
+  _valid = false;
+  _maxReload = 0xFFFF;
+  _halInit = 0;
+  for(uint32_t i = 0; i < TIMER_CHANNELS; i++) {
+    _channelMode[i] = TIMER_DISABLED;
+    _channelPin[i] = NC;
+  }
+  for(uint32_t i = 0; i <= TIMER_CHANNELS; i++) {
+    _callbacks[i] = NULL;
+  }
+
+  // A HardwareTimer owns its timer, even against another HardwareTimer
+  if((index < 0) || (getTimerUser(instance) != TIMER_FREE) ||
+     !TimerAcquire(instance, TIMER_USED_HARDWARETIMER)) {
+    return;
+  }
+
+#if defined(IS_TIM_32B_COUNTER_INSTANCE)
+  if(IS_TIM_32B_COUNTER_INSTANCE(instance)) {
+    _maxReload = 0xFFFFFFFF;
+  }
+#endif
+
+  _timerObj.timer = instance;
+  _timerObj.irqHandle = updateCallback;
+  _timerObj.irqHandleOC = compareCallback;
+  _timerObj.irqHandleIC = captureCallback;
+
+  handle->Instance               = instance;
+  handle->Init.Prescaler         = 0;
+  handle->Init.Period            = _maxReload;
+  handle->Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
+  handle->Init.CounterMode       = TIM_COUNTERMODE_UP;
+#if !defined(STM32L0xx) && !defined(STM32L1xx)
+  handle->Init.RepetitionCounter = 0;
+#endif
+
+  HardwareTimer_Handle[index] = this;
+  if(HAL_TIM_Base_Init(handle) != HAL_OK) {
+    HardwareTimer_Handle[index] = NULL;
+    TimerRelease(instance, TIMER_USED_HARDWARETIMER);
+    return;
+  }
+  // HAL_TIM_Base_MspInit() only enables the update IRQ
+  if(getTimerCCIrq(instance) != getTimerIrq(instance)) {
+    HAL_NVIC_SetPriority((IRQn_Type)getTimerCCIrq(instance), 15, 0);
+    HAL_NVIC_EnableIRQ((IRQn_Type)getTimerCCIrq(instance));
+  }
+  _valid = true;
+}
+
+HardwareTimer::~HardwareTimer()
+{
+  if(!_valid) {
+    return;
+  }
+  pause();
+  if(getTimerCCIrq(_timerObj.timer) != getTimerIrq(_timerObj.timer)) {
+    HAL_NVIC_DisableIRQ((IRQn_Type)getTimerCCIrq(_timerObj.timer));
+  }
+  HAL_TIM_Base_DeInit(&(_timerObj.handle));
+  HardwareTimer_Handle[getTimerIndex(_timerObj.timer)] = NULL;
+  TimerRelease(_timerObj.timer, TIMER_USED_HARDWARETIMER);
+  _valid = false;
+}
+
+bool HardwareTimer::isValid(void)
+{
+  return _valid;
+}
+
+/**
+  * @brief  Stop the counter, the channels and their interrupts
+  * @retval None
+  */
+void HardwareTimer::pause(void)
+{
+  if(!_valid) {
+    return;
+  }
+  __HAL_TIM_DISABLE_IT(&(_timerObj.handle), TIM_IT_UPDATE);
+  for(uint32_t channel = 1; channel <= TIMER_CHANNELS; channel++) {
+    stopChannel(channel);
+  }
+  // __HAL_TIM_DISABLE() does nothing while a channel is enabled
+  _timerObj.timer->CR1 &= ~TIM_CR1_CEN;
+}
+
+/**
+  * @brief  Start the configured channels, the attached interrupts and the counter
+  * @retval None
+  */
+void HardwareTimer::resume(void)
+{
+  TIM_HandleTypeDef *handle = &(_timerObj.handle);
+
+  if(!_valid) {
+    return;
+  }
+  for(uint32_t channel = 1; channel <= TIMER_CHANNELS; channel++) {
+    startChannel(channel);
+  }
+  if(_callbacks[0] != NULL) {
+    __HAL_TIM_CLEAR_IT(handle, TIM_IT_UPDATE);
+    __HAL_TIM_ENABLE_IT(handle, TIM_IT_UPDATE);
+  }
+  __HAL_TIM_ENABLE(handle);
+}
+
+void HardwareTimer::startChannel(uint32_t channel)
+{
+  TIM_HandleTypeDef *handle = &(_timerObj.handle);
+  uint32_t timChannel = getChannel(channel);
+  TimerModes_t mode = _channelMode[channel - 1];
+
+  if(mode == TIMER_DISABLED) {
+    return;
+  }
+  if(isInputMode(mode)) {
+    HAL_TIM_IC_Start(handle, timChannel);
+  } else {
+#if !defined(STM32L0xx) && !defined(STM32L1xx)
+    PinName pin = _channelPin[channel - 1];
+    if((pin != NC) && STM_PIN_INVERTED(pinmap_function(pin, PinMap_PWM))) {
+      HAL_TIMEx_OCN_Start(handle, timChannel);
+    } else
+#endif
+    {
+      HAL_TIM_OC_Start(handle, timChannel);
+    }
+  }
+  if(_callbacks[channel] != NULL) {
+    __HAL_TIM_CLEAR_IT(handle, getChannelIT(channel));
+    __HAL_TIM_ENABLE_IT(handle, getChannelIT(channel));
+  }
+}
+
+void HardwareTimer::stopChannel(uint32_t channel)
+{
+  TIM_HandleTypeDef *handle = &(_timerObj.handle);
+  uint32_t timChannel = getChannel(channel);
+  TimerModes_t mode = _channelMode[channel - 1];
+
+  __HAL_TIM_DISABLE_IT(handle, getChannelIT(channel));
+  if(mode == TIMER_DISABLED) {
+    return;
+  }
+  if(isInputMode(mode)) {
+    HAL_TIM_IC_Stop(handle, timChannel);
+  } else {
+#if !defined(STM32L0xx) && !defined(STM32L1xx)
+    PinName pin = _channelPin[channel - 1];
+    if((pin != NC) && STM_PIN_INVERTED(pinmap_function(pin, PinMap_PWM))) {
+      HAL_TIMEx_OCN_Stop(handle, timChannel);
+    } else
+#endif
+    {
+      HAL_TIM_OC_Stop(handle, timChannel);
+    }
+  }
+}
+
+/**
+  * @brief  Set the counter clock divider, applied at the next overflow
+  *         or on refresh()
+  * @param  prescaler: 1 to 0x10000
+  * @retval None
+  */
+void HardwareTimer::setPrescaleFactor(uint32_t prescaler)
+{
+  if(!_valid || (prescaler == 0) || (prescaler > 0x10000)) {
+    return;
+  }
+  __HAL_TIM_SET_PRESCALER(&(_timerObj.handle), prescaler - 1);
+  _timerObj.handle.Init.Prescaler = prescaler - 1;
+}
+
+uint32_t HardwareTimer::getPrescaleFactor(void)
+{
+  return _timerObj.handle.Init.Prescaler + 1;
+}
+
+/**
+  * @brief  Set the counter period
+  * @param  val: number of ticks, period in microseconds or frequency in hertz
+  * @param  format: TICK_FORMAT, MICROSEC_FORMAT or HERTZ_FORMAT
+  * @retval None
+  */
+void HardwareTimer::setOverflow(uint32_t val, TimerFormat_t format)
+{
+  uint64_t cycles;
+  uint32_t prescaler;
+
+  if(!_valid || (val == 0)) {
+    return;
+  }
+  switch(format) {
+    case MICROSEC_FORMAT:
+      cycles = ((uint64_t)::getTimerClkFreq(_timerObj.timer) * val) / 1000000;
+      break;
+    case HERTZ_FORMAT:
+      cycles = ::getTimerClkFreq(_timerObj.timer) / val;
+      break;
+    case TICK_FORMAT:
+    default:
+      if((val - 1) > _maxReload) {
+        val = _maxReload + 1;
+      }
+      __HAL_TIM_SET_AUTORELOAD(&(_timerObj.handle), val - 1);
+      return;
+  }
+
+  // Smallest prescaler giving a period in the range of the auto-reload
+  prescaler = (uint32_t)(cycles / ((uint64_t)_maxReload + 1)) + 1;
+  if(prescaler > 0x10000) {
+    prescaler = 0x10000;
+  }
+  setPrescaleFactor(prescaler);
+  cycles /= prescaler;
+  if(cycles == 0) {
+    cycles = 1;
+  } else if(cycles > ((uint64_t)_maxReload + 1)) {
+    cycles = (uint64_t)_maxReload + 1;
+  }
+  __HAL_TIM_SET_AUTORELOAD(&(_timerObj.handle), (uint32_t)(cycles - 1));
+}
+
+uint32_t HardwareTimer::getOverflow(TimerFormat_t format)
+{
+  return ticksToFormat(__HAL_TIM_GET_AUTORELOAD(&(_timerObj.handle)) + 1, format);
+}
+
+void HardwareTimer::setCount(uint32_t val, TimerFormat_t format)
+{
+  if(!_valid) {
+    return;
+  }
+  __HAL_TIM_SET_COUNTER(&(_timerObj.handle), formatToTicks(val, format));
+}
+
+uint32_t HardwareTimer::getCount(TimerFormat_t format)
+{
+  if(!_valid) {
+    return 0;
+  }
+  return ticksToFormat(__HAL_TIM_GET_COUNTER(&(_timerObj.handle)), format);
+}
+
+/**
+  * @brief  Configure a channel. The channel is started at once if the
+  *         timer is running, else by resume(). The first channel of each
+  *         kind (output compare, PWM, input capture) also reloads the
+  *         prescaler and overflow like refresh().
+  * @param  channel: 1 to 4
+  * @param  mode: see TimerModes_t
+  * @param  pin: pin of the channel to drive or to capture, NC for none
+  * @retval None
+  */
+void HardwareTimer::setMode(uint32_t channel, TimerModes_t mode, PinName pin)
+{
+  TIM_HandleTypeDef *handle = &(_timerObj.handle);
+  TIM_OC_InitTypeDef ocConfig = {};
+  TIM_IC_InitTypeDef icConfig = {};
+  uint32_t timChannel = getChannel(channel);
+  HAL_StatusTypeDef status = HAL_OK;
+  uint8_t kind;
+
+  if(!_valid || !IS_TIM_CHANNELS(timChannel)) {
+    return;
+  }
+  if((pin != NC) &&
+     (((TIM_TypeDef *)pinmap_peripheral(pin, PinMap_PWM) != _timerObj.timer) ||
+      (STM_PIN_CHANNEL(pinmap_function(pin, PinMap_PWM)) != channel))) {
+    return;
+  }
+
+  stopChannel(channel);
+  _channelMode[channel - 1] = mode;
+  _channelPin[channel - 1] = pin;
+
+  ocConfig.Pulse        = __HAL_TIM_GET_COMPARE(handle, timChannel);
+  ocConfig.OCPolarity   = TIM_OCPOLARITY_HIGH;
+  ocConfig.OCFastMode   = TIM_OCFAST_DISABLE;
+#if !defined(STM32L0xx) && !defined(STM32L1xx)
+  ocConfig.OCNPolarity  = TIM_OCNPOLARITY_HIGH;
+  ocConfig.OCIdleState  = TIM_OCIDLESTATE_RESET;
+  ocConfig.OCNIdleState = TIM_OCNIDLESTATE_RESET;
+#endif
+  icConfig.ICSelection  = TIM_ICSELECTION_DIRECTTI;
+  icConfig.ICPrescaler  = TIM_ICPSC_DIV1;
+  icConfig.ICFilter     = 0;
+
+  switch(mode) {
+    case TIMER_OUTPUT_COMPARE:
+      ocConfig.OCMode = TIM_OCMODE_TIMING;
+      kind = HAL_INIT_OC;
+      break;
+    case TIMER_OUTPUT_COMPARE_ACTIVE:
+      ocConfig.OCMode = TIM_OCMODE_ACTIVE;
+      kind = HAL_INIT_OC;
+      break;
+    case TIMER_OUTPUT_COMPARE_INACTIVE:
+      ocConfig.OCMode = TIM_OCMODE_INACTIVE;
+      kind = HAL_INIT_OC;
+      break;
+    case TIMER_OUTPUT_COMPARE_TOGGLE:
+      ocConfig.OCMode = TIM_OCMODE_TOGGLE;
+      kind = HAL_INIT_OC;
+      break;
+    case TIMER_OUTPUT_COMPARE_PWM1:
+      ocConfig.OCMode = TIM_OCMODE_PWM1;
+      kind = HAL_INIT_PWM;
+      break;
+    case TIMER_OUTPUT_COMPARE_PWM2:
+      ocConfig.OCMode = TIM_OCMODE_PWM2;
+      kind = HAL_INIT_PWM;
+      break;
+    case TIMER_INPUT_CAPTURE_RISING:
+      icConfig.ICPolarity = TIM_INPUTCHANNELPOLARITY_RISING;
+      kind = HAL_INIT_IC;
+      break;
+    case TIMER_INPUT_CAPTURE_FALLING:
+      icConfig.ICPolarity = TIM_INPUTCHANNELPOLARITY_FALLING;
+      kind = HAL_INIT_IC;
+      break;
+    case TIMER_INPUT_CAPTURE_BOTHEDGE:
+      icConfig.ICPolarity = TIM_INPUTCHANNELPOLARITY_BOTHEDGE;
+      kind = HAL_INIT_IC;
+      break;
+    case TIMER_DISABLED:
+    default:
+      _channelMode[channel - 1] = TIMER_DISABLED;
+      return;
+  }
+
+  // The HAL configures a channel on top of the init of its kind. Done once
+  // per kind: the init rewrites the time base with an update event.
+  if(!(_halInit & (1 << kind))) {
+    if(kind == HAL_INIT_OC) {
+      status = HAL_TIM_OC_Init(handle);
+    } else if(kind == HAL_INIT_PWM) {
+      status = HAL_TIM_PWM_Init(handle);
+    } else {
+      status = HAL_TIM_IC_Init(handle);
+    }
+    if(status == HAL_OK) {
+      _halInit |= 1 << kind;
+    }
+  }
+  if(status == HAL_OK) {
+    if(kind == HAL_INIT_OC) {
+      status = HAL_TIM_OC_ConfigChannel(handle, &ocConfig, timChannel);
+    } else if(kind == HAL_INIT_PWM) {
+      status = HAL_TIM_PWM_ConfigChannel(handle, &ocConfig, timChannel);
+    } else {
+      status = HAL_TIM_IC_ConfigChannel(handle, &icConfig, timChannel);
+    }
+  }
+  if(status != HAL_OK) {
+    _channelMode[channel - 1] = TIMER_DISABLED;
+    return;
+  }
+
+  if(pin != NC) {
+    TimerChannelPinInit(pin, isInputMode(mode), GPIO_NOPULL);
+  }
+  if(_timerObj.timer->CR1 & TIM_CR1_CEN) {
+    startChannel(channel);
+  }
+}
+
+void HardwareTimer::setMode(uint32_t channel, TimerModes_t mode, uint32_t pin)
+{
+  setMode(channel, mode, digitalPinToPinName(pin));
+}
+
+/**
+  * @brief  Set the compare value of an output channel
+  * @param  channel: 1 to 4
+  * @param  compare: value in the unit of format
+  * @param  format: PERCENT_FORMAT is a percentage of the overflow
+  * @retval None
+  */
+void HardwareTimer::setCaptureCompare(uint32_t channel, uint32_t compare, TimerFormat_t format)
+{
+  uint32_t timChannel = getChannel(channel);
+
+  if(!_valid || !IS_TIM_CHANNELS(timChannel)) {
+    return;
+  }
+  __HAL_TIM_SET_COMPARE(&(_timerObj.handle), timChannel, formatToTicks(compare, format));
+}
+
+/**
+  * @brief  Get the compare value or the last captured value of a channel
+  * @param  channel: 1 to 4
+  * @param  format: unit of the returned value
+  * @retval Compare or capture value
+  */
+uint32_t HardwareTimer::getCaptureCompare(uint32_t channel, TimerFormat_t format)
+{
+  uint32_t timChannel = getChannel(channel);
+
+  if(!_valid || !IS_TIM_CHANNELS(timChannel)) {
+    return 0;
+  }
+  return ticksToFormat(__HAL_TIM_GET_COMPARE(&(_timerObj.handle), timChannel), format);
+}
+
+void HardwareTimer::attachInterrupt(timerCallback_t callback)
+{
+  TIM_HandleTypeDef *handle = &(_timerObj.handle);
+
+  if(!_valid) {
+    return;
+  }
+  _callbacks[0] = callback;
+  if((callback != NULL) && (_timerObj.timer->CR1 & TIM_CR1_CEN)) {
+    __HAL_TIM_CLEAR_IT(handle, TIM_IT_UPDATE);
+    __HAL_TIM_ENABLE_IT(handle, TIM_IT_UPDATE);
+  }
+}
+
+void HardwareTimer::detachInterrupt(void)
+{
+  if(!_valid) {
+    return;
+  }
+  __HAL_TIM_DISABLE_IT(&(_timerObj.handle), TIM_IT_UPDATE);
+  _callbacks[0] = NULL;
+}
+
+void HardwareTimer::attachInterrupt(uint32_t channel, timerCallback_t callback)
+{
+  TIM_HandleTypeDef *handle = &(_timerObj.handle);
+
+  if(!_valid || (channel < 1) || (channel > TIMER_CHANNELS)) {
+    return;
+  }
+  _callbacks[channel] = callback;
+  if((callback != NULL) && (_channelMode[channel - 1] != TIMER_DISABLED) &&
+     (_timerObj.timer->CR1 & TIM_CR1_CEN)) {
+    __HAL_TIM_CLEAR_IT(handle, getChannelIT(channel));
+    __HAL_TIM_ENABLE_IT(handle, getChannelIT(channel));
+  }
+}
+
+void HardwareTimer::detachInterrupt(uint32_t channel)
+{
+  if(!_valid || (channel < 1) || (channel > TIMER_CHANNELS)) {
+    return;
+  }
+  __HAL_TIM_DISABLE_IT(&(_timerObj.handle), getChannelIT(channel));
+  _callbacks[channel] = NULL;
+}
+
+/**
+  * @brief  Generate an update event: the counter is reset and the new
+  *         prescaler and overflow are applied at once. The overflow
+  *         callback is called if attached.
+  * @retval None
+  */
+void HardwareTimer::refresh(void)
+{
+  if(!_valid) {
+    return;
+  }
+  HAL_TIM_GenerateEvent(&(_timerObj.handle), TIM_EVENTSOURCE_UPDATE);
+}
+
+uint32_t HardwareTimer::getTimerClkFreq(void)
+{
+  if(!_valid) {
+    return 0;
+  }
+  return ::getTimerClkFreq(_timerObj.timer);
+}
+
+uint32_t HardwareTimer::ticksToFormat(uint32_t ticks, TimerFormat_t format)
+{
+  uint64_t prescaler = getPrescaleFactor();
+  uint32_t clkFreq = ::getTimerClkFreq(_timerObj.timer);
+
+  switch(format) {
+    case MICROSEC_FORMAT:
+      return (uint32_t)(((uint64_t)ticks * prescaler * 1000000) / clkFreq);
+    case HERTZ_FORMAT:
+      return (ticks == 0) ? 0 : (uint32_t)(clkFreq / (prescaler * ticks));
+    case PERCENT_FORMAT:
+      return (uint32_t)(((uint64_t)ticks * 100) /
+                        ((uint64_t)__HAL_TIM_GET_AUTORELOAD(&(_timerObj.handle)) + 1));
+    case TICK_FORMAT:
+    default:
+      return ticks;
+  }
+}
+
+uint32_t HardwareTimer::formatToTicks(uint32_t val, TimerFormat_t format)
+{
+  uint64_t prescaler = getPrescaleFactor();
+  uint32_t clkFreq = ::getTimerClkFreq(_timerObj.timer);
+
+  switch(format) {
+    case MICROSEC_FORMAT:
+      return (uint32_t)(((uint64_t)clkFreq * val) / (prescaler * 1000000));
+    case HERTZ_FORMAT:
+      return (val == 0) ? 0 : (uint32_t)(clkFreq / (prescaler * val));
+    case PERCENT_FORMAT:
+      return (uint32_t)((((uint64_t)__HAL_TIM_GET_AUTORELOAD(&(_timerObj.handle)) + 1) * val) / 100);
+    case TICK_FORMAT:
+    default:
+      return val;
+  }
+}
+
+HardwareTimer *HardwareTimer::getObject(stimer_t *obj)
+{
+  int8_t index = getTimerIndex(obj->timer);
+
+  return (index < 0) ? NULL : HardwareTimer_Handle[index];
+}
+
+void HardwareTimer::updateCallback(stimer_t *obj)
+{
+  HardwareTimer *timer = getObject(obj);
+
+  if((timer != NULL) && (timer->_callbacks[0] != NULL)) {
+    timer->_callbacks[0](timer);
+  }
+}
+
+// channel is TIM_CHANNEL_x / 4, see HAL_TIM_OC_DelayElapsedCallback()
+void HardwareTimer::compareCallback(stimer_t *obj, uint32_t channel)
+{
+  HardwareTimer *timer = getObject(obj);
+
+  if((timer != NULL) && (channel < TIMER_CHANNELS) &&
+     (timer->_callbacks[channel + 1] != NULL)) {
+    timer->_callbacks[channel + 1](timer);
+  }
+}
+
+// channel is TIM_CHANNEL_x, see HAL_TIM_IC_CaptureCallback()
+void HardwareTimer::captureCallback(stimer_t *obj, uint32_t channel)
+{
+  compareCallback(obj, channel / 4);
+}
@@ -0,0 +1,122 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  General purpose access to the STM32 timers.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _HARDWARETIMER_H_
+#define _HARDWARETIMER_H_
+
+#ifdef __cplusplus
+
+#define TIMER_CHANNELS 4    // channels 1 to 4 of a timer
+
+typedef enum {
+  TIMER_DISABLED,
+  // Output compare, the channel interrupt is raised but the pin is not driven
+  TIMER_OUTPUT_COMPARE,
+  // Pin set active, set inactive or toggled on compare match
+  TIMER_OUTPUT_COMPARE_ACTIVE,
+  TIMER_OUTPUT_COMPARE_INACTIVE,
+  TIMER_OUTPUT_COMPARE_TOGGLE,
+  // PWM1: pin active while count < compare, PWM2: the opposite
+  TIMER_OUTPUT_COMPARE_PWM1,
+  TIMER_OUTPUT_COMPARE_PWM2,
+  // Counter captured on the edges of the pin
+  TIMER_INPUT_CAPTURE_RISING,
+  TIMER_INPUT_CAPTURE_FALLING,
+  TIMER_INPUT_CAPTURE_BOTHEDGE,
+} TimerModes_t;
+
+typedef enum {
+  TICK_FORMAT,      // timer counter ticks
+  MICROSEC_FORMAT,  // microseconds
+  HERTZ_FORMAT,     // frequency, overflow and compare only
+  PERCENT_FORMAT,   // percentage of the overflow, compare only
+} TimerFormat_t;
+
+class HardwareTimer;
+typedef void (*timerCallback_t)(HardwareTimer *);
+
+class HardwareTimer {
+  public:
+    // The timer is reserved for this object, see isValid()
+    HardwareTimer(TIM_TypeDef *instance);
+    ~HardwareTimer();
+
+    // false if the timer is already used by Servo, Tone, analogWrite...
+    bool isValid(void);
+
+    void pause(void);
+    void resume(void);
+
+    // Counter clock = timer clock / prescaler, prescaler from 1 to 0x10000
+    void setPrescaleFactor(uint32_t prescaler);
+    uint32_t getPrescaleFactor(void);
+
+    // Period of the counter. MICROSEC_FORMAT and HERTZ_FORMAT also compute
+    // the prescaler to get the best resolution.
+    void setOverflow(uint32_t val, TimerFormat_t format = TICK_FORMAT);
+    uint32_t getOverflow(TimerFormat_t format = TICK_FORMAT);
+
+    void setCount(uint32_t val, TimerFormat_t format = TICK_FORMAT);
+    uint32_t getCount(TimerFormat_t format = TICK_FORMAT);
+
+    // channel from 1 to 4, pin must be connected to this channel (see PinMap_PWM)
+    void setMode(uint32_t channel, TimerModes_t mode, PinName pin = NC);
+    void setMode(uint32_t channel, TimerModes_t mode, uint32_t pin);
+
+    void setCaptureCompare(uint32_t channel, uint32_t compare, TimerFormat_t format = TICK_FORMAT);
+    uint32_t getCaptureCompare(uint32_t channel, TimerFormat_t format = TICK_FORMAT);
+
+    // Overflow (update) interrupt
+    void attachInterrupt(timerCallback_t callback);
+    void detachInterrupt(void);
+    // Capture/compare interrupt of a channel
+    void attachInterrupt(uint32_t channel, timerCallback_t callback);
+    void detachInterrupt(uint32_t channel);
+
+    // Reload the prescaler and overflow and reset the counter
+    void refresh(void);
+
+    uint32_t getTimerClkFreq(void);
+
+  private:
+    stimer_t _timerObj;
+    bool _valid;
+    uint32_t _maxReload;
+    // HAL_TIM_OC/PWM/IC_Init() done, bits 1 << kind (see HardwareTimer.cpp)
+    uint8_t _halInit;
+    TimerModes_t _channelMode[TIMER_CHANNELS];
+    PinName _channelPin[TIMER_CHANNELS];
+    // [0] overflow, [1..4] channels
+    timerCallback_t _callbacks[1 + TIMER_CHANNELS];
+
+    void startChannel(uint32_t channel);
+    void stopChannel(uint32_t channel);
+    uint32_t ticksToFormat(uint32_t ticks, TimerFormat_t format);
+    uint32_t formatToTicks(uint32_t val, TimerFormat_t format);
+
+    static HardwareTimer *getObject(stimer_t *obj);
+    static void updateCallback(stimer_t *obj);
+    static void compareCallback(stimer_t *obj, uint32_t channel);
+    static void captureCallback(stimer_t *obj, uint32_t channel);
+};
+
+#endif // __cplusplus
+
+#endif /* _HARDWARETIMER_H_ */
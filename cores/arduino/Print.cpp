@@ -27,6 +27,20 @@
 #include "Arduino.h"
 
 #include "Print.h"
+#include "numfmt.h"
+
+// printf() output: the buffer is written when full and at the end
+struct PrintfOutput {
+  Print *print;
+  size_t n;
+};
+
+static void printfFlush(void *arg, const char *text, size_t len)
+{
+  PrintfOutput *out = (PrintfOutput *)arg;
+
+  out->n += out->print->write(text, len);
+}
 
 // Public Methods //////////////////////////////////////////////////////////////
 
@@ -81,12 +95,8 @@ size_t Print::print(long n, int base)
   if (base == 0) {
     return write(n);
   } else if (base == 10) {
-    if (n < 0) {
-      int t = print('-');
-      n = -n;
-      return printNumber(n, 10) + t;
-    }
-    return printNumber(n, 10);
+    char buf[NUMFMT_LONG_SIZE];
+    return write(buf, numfmt_long(buf, n, 10, 1));
   } else {
     return printNumber(n, base);
   }
@@ -190,69 +200,49 @@ size_t Print::println(const Printable& x)
   return n;
 }
 
+size_t Print::printf(const char *format, ...)
+{
+  va_list ap;
+  size_t n;
+
+  va_start(ap, format);
+  n = vprintf(format, ap);
+  va_end(ap);
+  return n;
+}
+
+size_t Print::vprintf(const char *format, va_list ap)
+{
+  char buf[PRINTF_BUFFER_SIZE];
+  PrintfOutput out = {this, 0};
+
+  numfmt_vformat(buf, sizeof(buf), printfFlush, &out, format, ap);
+  return out.n;
+}
+
 // Private Methods /////////////////////////////////////////////////////////////
 
 size_t Print::printNumber(unsigned long n, uint8_t base) {
-  char buf[8 * sizeof(long) + 1]; // Assumes 8-bit chars plus zero byte.
-  char *str = &buf[sizeof(buf) - 1];
-
-  *str = '\0';
+  char buf[NUMFMT_LONG_SIZE];
 
   // prevent crash if called with base == 1
   if (base < 2) base = 10;
 
-  do {
-    unsigned long m = n;
-    n /= base;
-    char c = m - base * n;
-    *--str = c < 10 ? c + '0' : c + 'A' - 10;
-  } while(n);
-
-  return write(str);
+  return write(buf, numfmt_ulong(buf, n, base, 1));
 }
 
-size_t Print::printFloat(double number, uint8_t digits) 
-{ 
-  size_t n = 0;
-  
-  if (isnan(number)) return print("nan");
-  if (isinf(number)) return print("inf");
-  if (number > 4294967040.0) return print ("ovf");  // constant determined empirically
-  if (number <-4294967040.0) return print ("ovf");  // constant determined empirically
-  
-  // Handle negative numbers
-  if (number < 0.0)
-  {
-     n += print('-');
-     number = -number;
-  }
-
-  // Round correctly so that print(1.999, 2) prints as "2.00"
-  double rounding = 0.5;
-  for (uint8_t i=0; i<digits; ++i)
-    rounding /= 10.0;
-  
-  number += rounding;
-
-  // Extract the integer part of the number and print it
-  unsigned long int_part = (unsigned long)number;
-  double remainder = number - (double)int_part;
-  n += print(int_part);
-
-  // Print the decimal point, but only if there are digits beyond
-  if (digits > 0) {
-    n += print("."); 
+size_t Print::printFloat(double number, uint8_t digits)
+{
+  char buf[NUMFMT_DOUBLE_SIZE];
+  size_t len = numfmt_double(buf, number, digits);
+  size_t n = write(buf, len);
+
+  // Digits beyond the precision of the conversion
+  if (digits > NUMFMT_DOUBLE_MAX_PREC && isdigit((unsigned char)buf[len - 1])) {
+    for (digits -= NUMFMT_DOUBLE_MAX_PREC; digits > 0; digits--) {
+      n += write('0');
+    }
   }
-
-  // Extract digits from the remainder one at a time
-  while (digits-- > 0)
-  {
-    remainder *= 10.0;
-    int toPrint = int(remainder);
-    n += print(toPrint);
-    remainder -= toPrint; 
-  } 
-  
   return n;
 }
 
@@ -289,22 +279,8 @@ void Print::print(uint64_t n, uint8_t base)
 
 void Print::printLLNumber(uint64_t n, uint8_t base)
 {
-  unsigned char buf[16 * sizeof(long)];
-  unsigned int i = 0;
-
-  if (n == 0)
-  {
-    print((char)'0');
-	return;
-  }
-
-  while (n > 0)
-  {
-    buf[i++] = n % base;
-    n /= base;
-  }
+  char buf[NUMFMT_LLONG_SIZE];
 
-  for (; i > 0; i--)
-    print((char) (buf[i - 1] < 10 ? '0' + buf[i - 1] : 'A' + buf[i - 1] - 10));
+  write(buf, numfmt_ullong(buf, n, base, 1));
 }
 #endif
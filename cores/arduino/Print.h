@@ -22,6 +22,7 @@
 
 #include <inttypes.h>
 #include <stdio.h> // for size_t
+#include <stdarg.h>
 
 #include "WString.h"
 #include "Printable.h"
@@ -31,6 +32,11 @@
 #define OCT 8
 #define BIN 2
 
+// printf() formats in a buffer of this size on the stack, written at once
+#ifndef PRINTF_BUFFER_SIZE
+#define PRINTF_BUFFER_SIZE 64
+#endif
+
 // uncomment next line to support printing of 64 bit ints.
 #define SUPPORT_LONGLONG
 
@@ -85,6 +91,12 @@ class Print
     size_t println(double, int = 2);
     size_t println(const Printable&);
     size_t println(void);
+
+    // Conversions of numfmt_vformat() (numfmt.h), standard ones only: the
+    // format is checked by the compiler. Longer outputs are written in
+    // several parts of PRINTF_BUFFER_SIZE.
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+    size_t vprintf(const char *format, va_list ap);
 #ifdef SUPPORT_LONGLONG
     void println(int64_t, uint8_t = DEC);
     void print(int64_t, uint8_t = DEC);
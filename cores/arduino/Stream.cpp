@@ -30,7 +30,8 @@
 // private method to read stream with timeout
 int Stream::timedRead()
 {
-  int c;
+  int c = read();
+  if (c >= 0) return c;  // no need for the time when data is waiting
   _startMillis = millis();
   do {
     c = read();
@@ -42,7 +43,8 @@ int Stream::timedRead()
 // private method to peek stream with timeout
 int Stream::timedPeek()
 {
-  int c;
+  int c = peek();
+  if (c >= 0) return c;
   _startMillis = millis();
   do {
     c = peek();
@@ -84,6 +86,17 @@ int Stream::peekNextDigit(LookaheadMode lookahead, bool detectDecimal )
 // Public Methods
 //////////////////////////////////////////////////////////////
 
+// default bulk read: byte per byte
+int Stream::read(uint8_t *buffer, size_t size)
+{
+  size_t count = 0;
+  int c;
+  while (count < size && (c = read()) >= 0) {
+    buffer[count++] = (uint8_t)c;
+  }
+  return count;
+}
+
 void Stream::setTimeout(unsigned long timeout)  // sets the maximum number of milliseconds to wait
 {
   _timeout = timeout;
@@ -202,11 +215,15 @@ float Stream::parseFloat(LookaheadMode lookahead, char ignore)
 size_t Stream::readBytes(char *buffer, size_t length)
 {
   size_t count = 0;
+  _startMillis = millis();
   while (count < length) {
-    int c = timedRead();
-    if (c < 0) break;
-    *buffer++ = (char)c;
-    count++;
+    int n = read((uint8_t *)buffer + count, length - count);
+    if (n > 0) {
+      count += n;
+      _startMillis = millis();
+    } else if (millis() - _startMillis >= _timeout) {
+      break;
+    }
   }
   return count;
 }
@@ -232,11 +249,13 @@ size_t Stream::readBytesUntil(char terminator, char *buffer, size_t length)
 String Stream::readString()
 {
   String ret;
-  int c = timedRead();
-  while (c >= 0)
+  char buf[64 + 1];
+  size_t n;
+  while ((n = readBytes(buf, sizeof(buf) - 1)) > 0)
   {
-    ret += (char)c;
-    c = timedRead();
+    buf[n] = '\0';
+    ret += buf;
+    if (n < sizeof(buf) - 1) break;  // timeout
   }
   return ret;
 }
@@ -261,10 +280,55 @@ int Stream::findMulti( struct Stream::MultiTarget *targets, int tCount) {
       return t - targets;
   }
 
+  // Targets that fit in a StreamMatcher are searched with the prefix tables,
+  // a mismatch does not walk back through the target.
+  StreamMatcher matcher;
+  int i;
+  for (i = 0; i < tCount; i++) {
+    if (targets[i].index != 0 || matcher.add(targets[i].str, targets[i].len) != i)
+      break;
+  }
+  if (i == tCount) {
+    while (1) {
+      int found = matcher.poll(*this);
+      if (found >= 0)
+        return found;
+      int c = timedRead();
+      if (c < 0)
+        return -1;
+      found = matcher.feed(c);
+      if (found >= 0)
+        return found;
+    }
+  }
+
+  // Bytes are read by blocks that cannot go past the end of a match: the
+  // index of a target grows by one per byte at most, so no target can be
+  // completed before the last byte of a block shorter than len - index.
+  uint8_t buf[16];
+  int pos = 0, count = 0;
+
   while (1) {
-    int c = timedRead();
-    if (c < 0)
-      return -1;
+    int c;
+    if (pos < count) {
+      c = buf[pos++];
+    } else {
+      size_t want = sizeof(buf);
+      for (struct MultiTarget *t = targets; t < targets+tCount; ++t) {
+        if (t->len - t->index < want)
+          want = t->len - t->index;
+      }
+      count = (want > 1) ? read(buf, want) : 0;
+      if (count > 0) {
+        c = buf[0];
+        pos = 1;
+      } else {
+        count = pos = 0;
+        c = timedRead();
+        if (c < 0)
+          return -1;
+      }
+    }
 
     for (struct MultiTarget *t = targets; t < targets+tCount; ++t) {
       // the simple case is if we match, deal with that first.
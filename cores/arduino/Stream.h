@@ -60,6 +60,9 @@ class Stream : public Print
     virtual int read() = 0;
     virtual int peek() = 0;
     virtual void flush() = 0;
+    // reads up to size bytes already received, without waiting, and returns
+    // their number. Streams with a receive buffer override it to copy from it.
+    virtual int read(uint8_t *buffer, size_t size);
 
     Stream() {_timeout=1000;}
 
@@ -0,0 +1,144 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Incremental search of several strings in a Stream or a buffer.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "Arduino.h"
+#include "StreamMatcher.h"
+
+StreamMatcher::StreamMatcher(void)
+{
+  clear();
+}
+
+int StreamMatcher::add(const char *str)
+{
+  return add(str, strlen(str));
+}
+
+int StreamMatcher::add(const char *str, size_t length)
+{
+  Target *t = &_targets[_count];
+  uint8_t *prefix = &_prefix[_used];
+  size_t i;
+  uint8_t k = 0;
+
+  if ((length == 0) || (length > 255) || (_count >= STREAM_MATCHER_TARGETS) ||
+      (length > (size_t)(STREAM_MATCHER_CHARS - _used))) {
+    return -1;
+  }
+
+  prefix[0] = 0;
+  for (i = 1; i < length; i++) {
+    while ((k > 0) && (str[i] != str[k])) {
+      k = prefix[k - 1];
+    }
+    if (str[i] == str[k]) {
+      k++;
+    }
+    prefix[i] = k;
+  }
+
+  t->str = str;
+  t->len = length;
+  t->state = 0;
+  t->prefix = _used;
+  _used += length;
+  return _count++;
+}
+
+void StreamMatcher::clear(void)
+{
+  _count = 0;
+  _used = 0;
+}
+
+void StreamMatcher::reset(void)
+{
+  for (uint8_t i = 0; i < _count; i++) {
+    _targets[i].state = 0;
+  }
+}
+
+int StreamMatcher::feed(uint8_t c)
+{
+  for (uint8_t i = 0; i < _count; i++) {
+    Target *t = &_targets[i];
+    uint8_t q = t->state;
+
+    while ((q > 0) && (c != (uint8_t)t->str[q])) {
+      q = _prefix[t->prefix + q - 1];
+    }
+    if (c == (uint8_t)t->str[q]) {
+      q++;
+    }
+    if (q == t->len) {
+      reset();
+      return i;
+    }
+    t->state = q;
+  }
+  return -1;
+}
+
+int StreamMatcher::feed(const uint8_t *data, size_t length, size_t *used)
+{
+  size_t n = 0;
+  int found = -1;
+
+  while ((n < length) && (found < 0)) {
+    found = feed(data[n++]);
+  }
+  if (used != NULL) {
+    *used = n;
+  }
+  return found;
+}
+
+// Bytes that can be read at once without going past a match: the state of
+// a string grows by one per byte at most, it cannot be completed before
+// len - state bytes.
+size_t StreamMatcher::pollSize(void)
+{
+  size_t size = 16;
+
+  for (uint8_t i = 0; i < _count; i++) {
+    if ((size_t)(_targets[i].len - _targets[i].state) < size) {
+      size = _targets[i].len - _targets[i].state;
+    }
+  }
+  return size;
+}
+
+int StreamMatcher::poll(Stream &stream)
+{
+  uint8_t buf[16];
+  int n;
+  int found;
+
+  if (_count == 0) {
+    return -1;
+  }
+  while ((n = stream.read(buf, pollSize())) > 0) {
+    found = feed(buf, n);
+    if (found >= 0) {
+      return found;
+    }
+  }
+  return -1;
+}
@@ -0,0 +1,96 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Incremental search of several strings in a Stream or a buffer.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _STREAM_MATCHER_H_
+#define _STREAM_MATCHER_H_
+
+#ifdef __cplusplus
+
+#include <stddef.h>
+#include <stdint.h>
+
+class Stream;
+
+// Capacity of a matcher: number of strings and their total length
+#ifndef STREAM_MATCHER_TARGETS
+#define STREAM_MATCHER_TARGETS  4
+#endif
+#ifndef STREAM_MATCHER_CHARS
+#define STREAM_MATCHER_CHARS    64
+#endif
+
+/*
+ * Knuth-Morris-Pratt search of several strings at once. The partial
+ * matches are kept between the calls, so the input can be given as it
+ * arrives and is never read twice. Each string has a prefix table, a
+ * mismatch falls back to the longest prefix which is also a suffix of what
+ * was matched.
+ *
+ * StreamMatcher reply;
+ * reply.add("OK\r\n");     // index 0
+ * reply.add("ERROR");      // index 1
+ * ...
+ * switch (reply.poll(Serial1)) {  // in loop(), does not wait
+ *   case 0: ... break;
+ *   case 1: ... break;
+ *   default: break;        // not found yet
+ * }
+ */
+class StreamMatcher {
+  public:
+    StreamMatcher(void);
+
+    // The string is not copied, it must stay valid. Returns its index, or
+    // -1 if it is empty or does not fit (see STREAM_MATCHER_CHARS).
+    int add(const char *str);
+    int add(const char *str, size_t length);
+    // Remove all the strings
+    void clear(void);
+    // Forget the partial matches. Done after each match.
+    void reset(void);
+
+    // Return the index of the string ended by c, -1 if none
+    int feed(uint8_t c);
+    // Stops at the end of the first match. used: if not NULL, number of
+    // bytes consumed.
+    int feed(const uint8_t *data, size_t length, size_t *used = NULL);
+    // Consumes the bytes available in stream without waiting, up to the end
+    // of the first match, and returns the index of the string found or -1.
+    int poll(Stream &stream);
+
+  private:
+    struct Target {
+      const char *str;
+      uint8_t len;
+      uint8_t state;      // number of characters matched
+      uint8_t prefix;     // index of the prefix table in _prefix
+    };
+    Target _targets[STREAM_MATCHER_TARGETS];
+    // For each string position, length of the longest proper prefix of
+    // str[0..i] which is also a suffix of it
+    uint8_t _prefix[STREAM_MATCHER_CHARS];
+    uint8_t _count;
+    uint8_t _used;      // entries of _prefix used
+
+    size_t pollSize(void);
+};
+
+#endif // __cplusplus
+#endif // _STREAM_MATCHER_H_
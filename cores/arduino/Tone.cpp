@@ -21,20 +21,155 @@
 
 #include "Arduino.h"
 
+#ifndef TONE_MAX_NB
+#define TONE_MAX_NB 4   // tones played at the same time by hardware
+#endif
+
+// A tone on a pin with a timer channel (see PinMap_PWM) is generated by
+// the timer in output compare toggle mode: no interrupt per edge and
+// several tones could be played at the same time on pins of different
+// timers. The update interrupt is only used to count the duration.
+// Other pins are toggled by software on TIMER_TONE, one at a time.
+typedef struct {
+  bool used;
+  PinName pin;
+  HardwareTimer *timer;
+  volatile int32_t count;   // remaining toggles, -1 if no duration
+  volatile bool done;       // duration elapsed, timer to be released
+} tone_t;
+
+static tone_t tones[TONE_MAX_NB];
+
 PinName g_lastPin = NC;
 static stimer_t _timer;
 
+static void toneUpdateCallback(HardwareTimer *timer)
+{
+  for(uint8_t i = 0; i < TONE_MAX_NB; i++) {
+    tone_t *t = &tones[i];
+    if(t->used && (t->timer == timer)) {
+      if((t->count > 0) && (--t->count == 0)) {
+        timer->pause();
+        digital_io_init(t->pin, GPIO_MODE_OUTPUT_PP, GPIO_NOPULL);
+        digital_io_write(get_GPIO_Port(STM_PORT(t->pin)), STM_GPIO_PIN(t->pin), 0);
+        t->done = true;
+      }
+      break;
+    }
+  }
+}
+
+static tone_t *toneFind(PinName p)
+{
+  for(uint8_t i = 0; i < TONE_MAX_NB; i++) {
+    if(tones[i].used && (tones[i].pin == p)) {
+      return &tones[i];
+    }
+  }
+  return NULL;
+}
+
+static void toneFree(tone_t *t)
+{
+  delete t->timer;
+  t->timer = NULL;
+  t->used = false;
+}
+
+// Timers can't be deleted from the interrupt, finished tones are released here
+static void toneFreeFinished(void)
+{
+  for(uint8_t i = 0; i < TONE_MAX_NB; i++) {
+    if(tones[i].used && tones[i].done) {
+      toneFree(&tones[i]);
+    }
+  }
+}
+
+// Reserve the timer of the pin, NULL if it has none or if it is already used
+static tone_t *toneAllocate(PinName p)
+{
+  tone_t *t = NULL;
+  HardwareTimer *timer;
+
+  if(!pin_in_pinmap(p, PinMap_PWM)) {
+    return NULL;
+  }
+  for(uint8_t i = 0; i < TONE_MAX_NB; i++) {
+    if(!tones[i].used) {
+      t = &tones[i];
+      break;
+    }
+  }
+  if(t == NULL) {
+    return NULL;
+  }
+  timer = new HardwareTimer((TIM_TypeDef *)pinmap_peripheral(p, PinMap_PWM));
+  if(!timer->isValid()) {
+    delete timer;
+    return NULL;
+  }
+  t->used = true;
+  t->pin = p;
+  t->timer = timer;
+  t->count = -1;
+  t->done = false;
+  return t;
+}
+
+static void tonePlay(tone_t *t, uint32_t frequency, uint32_t duration)
+{
+  uint32_t channel = STM_PIN_CHANNEL(pinmap_function(t->pin, PinMap_PWM));
+  HardwareTimer *timer = t->timer;
+
+  timer->pause();
+  t->done = false;
+  if(duration > 0) {
+    // one toggle per period of the timer, at twice the tone frequency
+    t->count = (int32_t)(((uint64_t)2 * frequency * duration) / 1000);
+    if(t->count == 0) {
+      t->count = 1;
+    }
+    timer->attachInterrupt(toneUpdateCallback);
+  } else {
+    t->count = -1;
+    timer->detachInterrupt();
+  }
+  timer->setOverflow(2 * frequency, HERTZ_FORMAT);
+  timer->setCaptureCompare(channel, 0);
+  timer->setMode(channel, TIMER_OUTPUT_COMPARE_TOGGLE, t->pin);
+  timer->refresh();
+  timer->resume();
+}
+
 // frequency (in hertz) and duration (in milliseconds).
 
 void tone(uint8_t _pin, unsigned int frequency, unsigned long duration)
 {
   PinName p = digitalPinToPinName(_pin);
-  if(p != NC) {
-    if((g_lastPin == NC) || (g_lastPin == p)) {
-      _timer.pin = p;
-      TimerPinInit(&_timer, frequency, duration);
-      g_lastPin = p;
+  tone_t *t;
+
+  if((p == NC) || (frequency == 0) || (frequency > MAX_FREQ)) {
+    return;
+  }
+  toneFreeFinished();
+  t = toneFind(p);
+  if((t == NULL) && (g_lastPin != p)) {
+    t = toneAllocate(p);
+  }
+  if(t != NULL) {
+    tonePlay(t, frequency, duration);
+    return;
+  }
+
+  if((g_lastPin == NC) || (g_lastPin == p)) {
+    // TIMER_TONE could be shared with another driver (see variant.h)
+    if((g_lastPin == NC) && !TimerAcquire(TIMER_TONE, TIMER_USED_TONE)) {
+      return;
     }
+    _timer.pin = p;
+    TimerPinInit(&_timer, frequency, duration);
+    g_lastPin = p;
   }
 }
 
@@ -42,9 +177,19 @@ void tone(uint8_t _pin, unsigned int frequency, unsigned long duration)
 void noTone(uint8_t _pin)
 {
   PinName p = digitalPinToPinName(_pin);
+  tone_t *t;
+
   if(p != NC) {
-    TimerPinDeinit(&_timer);
+    toneFreeFinished();
+    t = toneFind(p);
+    if(t != NULL) {
+      toneFree(t);
+      digital_io_init(p, GPIO_MODE_OUTPUT_PP, GPIO_NOPULL);
+    } else if(g_lastPin == p) {
+      TimerPinDeinit(&_timer);
+      TimerRelease(TIMER_TONE, TIMER_USED_TONE);
+      g_lastPin = NC;
+    }
     digitalWrite(_pin, 0);
-    g_lastPin = NC;
   }
 }
@@ -0,0 +1,123 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Serial port over the USB CDC class (virtual COM port).
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "Arduino.h"
+
+#if defined(USBCON) && defined(USBD_USE_CDC)
+
+USBSerial SerialUSB;
+
+void USBSerial::begin(uint32_t baud)
+{
+  UNUSED(baud);
+}
+
+void USBSerial::end(void)
+{
+  flush();
+}
+
+int USBSerial::available(void)
+{
+  return usbd_interface_cdc_available();
+}
+
+int USBSerial::peek(void)
+{
+  return usbd_interface_cdc_peek();
+}
+
+int USBSerial::read(void)
+{
+  uint8_t c;
+
+  if(usbd_interface_cdc_read(&c, 1) == 0) {
+    return -1;
+  }
+  return c;
+}
+
+int USBSerial::read(uint8_t *buffer, size_t size)
+{
+  return usbd_interface_cdc_read(buffer, size);
+}
+
+int USBSerial::availableForWrite(void)
+{
+  return usbd_interface_cdc_write_free();
+}
+
+void USBSerial::flush(void)
+{
+  uint32_t start = millis();
+
+  while(usbd_interface_cdc_tx_pending() && (__get_IPSR() == 0) &&
+        ((millis() - start) < USBSERIAL_WRITE_TIMEOUT)) {
+    yield();
+  }
+}
+
+size_t USBSerial::write(uint8_t c)
+{
+  return write(&c, 1);
+}
+
+size_t USBSerial::write(const uint8_t *buffer, size_t size)
+{
+  size_t written = 0;
+  uint32_t start = millis();
+  uint32_t n;
+
+  while((written < size) && usbd_interface_cdc_configured()) {
+    n = usbd_interface_cdc_write(&buffer[written], size - written);
+    if(n != 0) {
+      written += n;
+      start = millis();
+    } else if((__get_IPSR() != 0) || ((millis() - start) >= USBSERIAL_WRITE_TIMEOUT)) {
+      // Cannot wait in an interrupt, or the host does not read: drop the rest
+      break;
+    } else {
+      yield();
+    }
+  }
+  return written;
+}
+
+USBSerial::operator bool(void)
+{
+  return dtr();
+}
+
+uint32_t USBSerial::baud(void)
+{
+  return usbd_interface_cdc_baudrate();
+}
+
+bool USBSerial::dtr(void)
+{
+  return (usbd_interface_cdc_line_state() & CDC_SERIAL_LINE_DTR) != 0;
+}
+
+bool USBSerial::rts(void)
+{
+  return (usbd_interface_cdc_line_state() & CDC_SERIAL_LINE_RTS) != 0;
+}
+
+#endif // USBCON && USBD_USE_CDC
@@ -0,0 +1,66 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Serial port over the USB CDC class (virtual COM port).
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _USBSERIAL_H_
+#define _USBSERIAL_H_
+
+#if defined(USBCON) && defined(USBD_USE_CDC)
+
+#include "Stream.h"
+
+// Time without any transmission progress after which write() drops the
+// data: the host does not read the port.
+#ifndef USBSERIAL_WRITE_TIMEOUT
+#define USBSERIAL_WRITE_TIMEOUT 100
+#endif
+
+class USBSerial : public Stream
+{
+  public:
+    // The USB device is started before setup(), the baud rate is ignored
+    void begin(uint32_t baud = 0);
+    void end(void);
+
+    virtual int available(void);
+    virtual int peek(void);
+    using Stream::read;
+    virtual int read(void);
+    virtual int read(uint8_t *buffer, size_t size);
+    int availableForWrite(void);
+    // Wait for the transmission of the buffered data
+    virtual void flush(void);
+    virtual size_t write(uint8_t);
+    // Waits for room in the transmit buffer, unless called from an interrupt
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    using Print::write; // pull in write(str) from Print
+
+    // true when a terminal has opened the port (DTR set)
+    operator bool(void);
+
+    // Line settings chosen by the host, only informative
+    uint32_t baud(void);
+    bool dtr(void);
+    bool rts(void);
+};
+
+extern USBSerial SerialUSB;
+
+#endif // USBCON && USBD_USE_CDC
+#endif // _USBSERIAL_H_
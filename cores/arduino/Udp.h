@@ -66,6 +66,7 @@ public:
   // Number of bytes remaining in the current packet
   virtual int available() =0;
   // Read a single byte from the current packet
+  using Stream::read;
   virtual int read() =0;
   // Read up to len bytes from the current packet and place them into buffer
   // Returns the number of bytes read, or 0 if none are available
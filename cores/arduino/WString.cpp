@@ -22,6 +22,7 @@
 #include "WString.h"
 #include "itoa.h"
 #include "avr/dtostrf.h"
+#include "mem_pool.h"
 
 /*********************************************/
 /*  Constructors                             */
@@ -123,7 +124,7 @@ String::String(double value, unsigned char decimalPlaces)
 
 String::~String()
 {
-	free(buffer);
+	if (isHeap()) mem_pool_free(buffer);
 }
 
 /*********************************************/
@@ -139,7 +140,7 @@ inline void String::init(void)
 
 void String::invalidate(void)
 {
-	if (buffer) free(buffer);
+	if (isHeap()) mem_pool_free(buffer);
 	buffer = NULL;
 	capacity = len = 0;
 }
@@ -156,13 +157,36 @@ unsigned char String::reserve(unsigned int size)
 
 unsigned char String::changeBuffer(unsigned int maxStrLen)
 {
-	char *newbuffer = (char *)realloc(buffer, maxStrLen + 1);
-	if (newbuffer) {
-		buffer = newbuffer;
-		capacity = maxStrLen;
+	char *newbuffer;
+	unsigned int newcap = maxStrLen;
+
+	if (!buffer && maxStrLen < STRING_SSO_SIZE) {
+		buffer = sso;
+		capacity = STRING_SSO_SIZE - 1;
 		return 1;
 	}
-	return 0;
+	// A growing string grows by half at least, rounded to the malloc
+	// granularity, so appends do not realloc each time
+	if (buffer && newcap < capacity + capacity / 2) {
+		newcap = capacity + capacity / 2;
+	}
+	newcap = ((newcap + 8) & ~7U) - 1;
+	for (;;) {
+		if (isHeap()) {
+			newbuffer = (char *)mem_pool_realloc(buffer, newcap + 1);
+		} else {
+			newbuffer = (char *)mem_pool_alloc(newcap + 1);
+			if (newbuffer && buffer) memcpy(newbuffer, buffer, len + 1);
+		}
+		if (newbuffer) {
+			buffer = newbuffer;
+			capacity = newcap;
+			return 1;
+		}
+		if (newcap == maxStrLen) return 0;
+		// Out of memory: the exact size may still fit
+		newcap = maxStrLen;
+	}
 }
 
 /*********************************************/
@@ -194,18 +218,29 @@ String & String::copy(const __FlashStringHelper *pstr, unsigned int length)
 #if __cplusplus >= 201103L || defined(__GXX_EXPERIMENTAL_CXX0X__)
 void String::move(String &rhs)
 {
+	if (!rhs.buffer) {
+		invalidate();
+		return;
+	}
 	if (buffer) {
 		if (capacity >= rhs.len) {
 			strcpy(buffer, rhs.buffer);
 			len = rhs.len;
 			rhs.len = 0;
 			return;
-		} else {
-			free(buffer);
+		} else if (isHeap()) {
+			mem_pool_free(buffer);
 		}
 	}
-	buffer = rhs.buffer;
-	capacity = rhs.capacity;
+	if (rhs.isHeap()) {
+		buffer = rhs.buffer;
+		capacity = rhs.capacity;
+	} else {
+		// Short string: copied, its buffer is in rhs
+		strcpy(sso, rhs.buffer);
+		buffer = sso;
+		capacity = STRING_SSO_SIZE - 1;
+	}
 	len = rhs.len;
 	rhs.buffer = NULL;
 	rhs.capacity = 0;
@@ -267,9 +302,17 @@ unsigned char String::concat(const char *cstr, unsigned int length)
 	unsigned int newlen = len + length;
 	if (!cstr) return 0;
 	if (length == 0) return 1;
-	if (!reserve(newlen)) return 0;
-	strcpy(buffer + len, cstr);
+	if (buffer && cstr >= buffer && cstr < buffer + len) {
+		// A part of this string, the buffer may move
+		unsigned int offset = cstr - buffer;
+		if (!reserve(newlen)) return 0;
+		cstr = buffer + offset;
+	} else if (!reserve(newlen)) {
+		return 0;
+	}
+	memcpy(buffer + len, cstr, length);
 	len = newlen;
+	buffer[len] = 0;
 	return 1;
 }
 
@@ -281,10 +324,10 @@ unsigned char String::concat(const char *cstr)
 
 unsigned char String::concat(char c)
 {
-	char buf[2];
-	buf[0] = c;
-	buf[1] = 0;
-	return concat(buf, 1);
+	if (!reserve(len + 1)) return 0;
+	buffer[len++] = c;
+	buffer[len] = 0;
+	return 1;
 }
 
 unsigned char String::concat(unsigned char num)
@@ -34,6 +34,12 @@
 //     -felide-constructors
 //     -std=c++0x
 
+// Strings up to STRING_SSO_SIZE - 1 characters are stored in the object
+// itself, without heap allocation. 12 holds any 32-bit integer.
+#ifndef STRING_SSO_SIZE
+#define STRING_SSO_SIZE 12
+#endif
+
 class __FlashStringHelper;
 #define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(PSTR(string_literal)))
 
@@ -191,8 +197,10 @@ protected:
 	char *buffer;	        // the actual char array
 	unsigned int capacity;  // the array length minus one (for the '\0')
 	unsigned int len;       // the String length (not counting the '\0')
+	char sso[STRING_SSO_SIZE]; // buffer of the short strings
 protected:
 	void init(void);
+	inline bool isHeap(void) const {return buffer && buffer != sso;}
 	void invalidate(void);
 	unsigned char changeBuffer(unsigned int maxStrLen);
 	unsigned char concat(const char *cstr, unsigned int length);
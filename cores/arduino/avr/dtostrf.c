@@ -21,6 +21,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
+#include "numfmt.h"
 
 char *dtostrf (double val, signed char width, unsigned char prec, char *sout) {
   //Commented code is the original version
@@ -29,61 +31,28 @@ char *dtostrf (double val, signed char width, unsigned char prec, char *sout) {
   sprintf(sout, fmt, val);
   return sout;*/
 
-  // Handle negative numbers
-  unsigned int negative = 0;
-  if (val < 0.0)
-  {
-     negative = 1;
-     val = -val;
-  }
-
-  // Round correctly so that print(1.999, 2) prints as "2.00"
-  double rounding = 0.5;
-  for (int i=0; i<prec; ++i)
-    rounding /= 10.0;
-
-  val += rounding;
-
-  // Extract the integer part of the number
-  unsigned long int_part = (unsigned long)val;
-  double remainder = val - (double)int_part;
+  size_t len = numfmt_double(sout, val, prec);
 
-  if(negative)
-    int_part = -int_part;
-
-  // Extract digits from the remainder
-  unsigned long dec_part = 0;
-  double decade = 1.0;
-  for(int i=0; i < prec; i++)
-    decade *= 10.0;
-  remainder *= decade;
-  dec_part = (int)remainder;
-
-  sprintf(sout, "%ld.%ld", int_part, dec_part);
+  // Digits beyond the precision of the conversion
+  if (prec > NUMFMT_DOUBLE_MAX_PREC && isdigit((unsigned char)sout[len - 1])) {
+    memset(sout + len, '0', prec - NUMFMT_DOUBLE_MAX_PREC);
+    len += prec - NUMFMT_DOUBLE_MAX_PREC;
+    sout[len] = '\0';
+  }
 
   // Handle minimum field width of the output string
   // width is signed value, negative for left adjustment.
   // Range -128,127
-  char fmt[129] = "";
-  unsigned int w = width;
-  if (width < 0) {
-    negative = 1;
-    w = -width;
-  } else {
-    negative = 0;
-  }
+  unsigned int w = (width < 0) ? -width : width;
 
-  if(strlen(sout) < w) {
-    memset(fmt, ' ', 128);
-    fmt[w-strlen(sout)] = '\0';
-	if(negative == 0) {
-      char *tmp = strdup(sout);
-      strcpy(sout,fmt);
-      strcat(sout, tmp);
-      free(tmp);
+  if (len < w) {
+    if (width > 0) {
+      memmove(sout + w - len, sout, len + 1);
+      memset(sout, ' ', w - len);
     } else {
       // left adjustment
-       strcat(sout, fmt);
+      memset(sout + len, ' ', w - len);
+      sout[w] = '\0';
     }
   }
 
@@ -8,11 +8,14 @@
 #include "clock.h"
 #include "core_callback.h"
 #include "digital_io.h"
-#include "hal_uart_emul.h"
 #include "hw_config.h"
 #include "interrupt.h"
+#include "low_power.h"
+#include "mem_pool.h"
+#include "rtc.h"
 #include "spi_com.h"
 #include "stm32_eeprom.h"
+#include "stm32_memory.h"
 #include "timer.h"
 #include "twi.h"
 #include "uart.h"
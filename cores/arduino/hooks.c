@@ -16,6 +16,10 @@
   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
+#if defined(CORE_CALLBACK)
+#include "core_callback.h"
+#endif
+
 /**
  * Empty yield() hook.
  *
@@ -23,10 +27,13 @@
  * libraries or sketches that supports cooperative threads.
  *
  * Its defined as a weak symbol and it can be redefined to implement a
- * real cooperative scheduler.
+ * real cooperative scheduler. With CORE_CALLBACK, the default one calls
+ * the due core tasks, so they keep running during delay().
  */
 static void __empty() {
-	// Empty
+#if defined(CORE_CALLBACK)
+	CoreCallback();
+#endif
 }
 void yield(void) __attribute__ ((weak, alias("__empty")));
 
@@ -17,6 +17,7 @@
 */
 
 #include "itoa.h"
+#include "numfmt.h"
 #include <string.h>
 
 #ifdef __cplusplus
@@ -73,13 +74,6 @@ extern char* itoa( int value, char *string, int radix )
 
 extern char* ltoa( long value, char *string, int radix )
 {
-  char tmp[33];
-  char *tp = tmp;
-  long i;
-  unsigned long v;
-  int sign;
-  char *sp;
-
   if ( string == NULL )
   {
     return 0 ;
@@ -90,33 +84,7 @@ extern char* ltoa( long value, char *string, int radix )
     return 0 ;
   }
 
-  sign = (radix == 10 && value < 0);
-  if (sign)
-  {
-    v = -value;
-  }
-  else
-  {
-    v = (unsigned long)value;
-  }
-
-  while (v || tp == tmp)
-  {
-    i = v % radix;
-    v = v / radix;
-    if (i < 10)
-      *tp++ = i+'0';
-    else
-      *tp++ = i + 'a' - 10;
-  }
-
-  sp = string;
-
-  if (sign)
-    *sp++ = '-';
-  while (tp > tmp)
-    *sp++ = *--tp;
-  *sp = 0;
+  numfmt_long(string, value, radix, 0);
 
   return string;
 }
@@ -132,12 +100,6 @@ extern char* utoa( unsigned long value, char *string, int radix )
 
 extern char* ultoa( unsigned long value, char *string, int radix )
 {
-  char tmp[33];
-  char *tp = tmp;
-  long i;
-  unsigned long v = value;
-  char *sp;
-
   if ( string == NULL )
   {
     return 0;
@@ -147,23 +109,8 @@ extern char* ultoa( unsigned long value, char *string, int radix )
   {
     return 0;
   }
- 
-  while (v || tp == tmp)
-  {
-    i = v % radix;
-    v = v / radix;
-    if (i < 10)
-      *tp++ = i+'0';
-    else
-      *tp++ = i + 'a' - 10;
-  }
-
-  sp = string;
 
- 
-  while (tp > tmp)
-    *sp++ = *--tp;
-  *sp = 0;
+  numfmt_ulong(string, value, radix, 0);
 
   return string;
 }
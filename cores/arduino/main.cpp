@@ -29,6 +29,8 @@ void initVariant() { }
 // Force init to be called *first*, i.e. before static object allocation.
 // Otherwise, statically allocated objects that need HAL may fail.
  __attribute__(( constructor (101))) void premain() {
+    // Before any stack use that should be measured (see stm32_memory.c)
+    stack_paint();
     init();
 }
 
@@ -52,6 +54,7 @@ int main( void )
 #endif
     loop();
     if (serialEventRun) serialEventRun();
+    if (coroutineRun) coroutineRun();
   }
 
   return 0;
@@ -17,20 +17,21 @@
 */
 
 #include <stdlib.h>
+#include "mem_pool.h"
 
 void *operator new(size_t size) {
-  return malloc(size);
+  return mem_pool_alloc(size);
 }
 
 void *operator new[](size_t size) {
-  return malloc(size);
+  return mem_pool_alloc(size);
 }
 
 void operator delete(void * ptr) {
-  free(ptr);
+  mem_pool_free(ptr);
 }
 
 void operator delete[](void * ptr) {
-  free(ptr);
+  mem_pool_free(ptr);
 }
 
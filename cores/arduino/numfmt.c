@@ -0,0 +1,693 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Number to text conversion shared by Print, String, itoa and dtostrf.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "numfmt.h"
+#include <math.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The digits are written backward, from the end of a temporary buffer.
+//
+// Base 10 avoids the division instruction: Cortex-M0 has none (it is a
+// library call) and its udiv takes up to 12 cycles on the others.
+// - Cortex-M3 and up: /100 is a multiplication by the reciprocal (umull)
+//   and two digits are taken at once from a table.
+// - Cortex-M0 has no 32x32->64 multiply either: /10 with shifts and adds.
+// Bases 2, 8 and 16 are shifts, the other ones divide.
+
+#if defined(__ARM_ARCH_6M__)
+// Hacker's Delight, exact for all the 32-bit values
+static inline uint32_t div10(uint32_t n)
+{
+  uint32_t q = (n >> 1) + (n >> 2);
+  uint32_t r;
+
+  q += q >> 4;
+  q += q >> 8;
+  q += q >> 16;
+  q >>= 3;
+  r = n - ((q << 2) + q) * 2;
+  return q + (r > 9);
+}
+#else
+static const char digitPairs[200] = {
+  '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+  '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+  '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+  '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+  '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+  '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+  '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+  '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+  '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+  '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9'
+};
+#endif
+
+// Decimal digits of value, at least width, ending at end. Returns the first.
+static char *dec32(char *end, uint32_t value, uint8_t width)
+{
+  char *p = end;
+
+#if defined(__ARM_ARCH_6M__)
+  do {
+    uint32_t q = div10(value);
+    *--p = '0' + (value - q * 10);
+    value = q;
+  } while(value != 0);
+#else
+  while(value >= 100) {
+    uint32_t q = value / 100;
+    uint32_t r = (value - q * 100) * 2;
+    *--p = digitPairs[r + 1];
+    *--p = digitPairs[r];
+    value = q;
+  }
+  if(value >= 10) {
+    *--p = digitPairs[value * 2 + 1];
+    *--p = digitPairs[value * 2];
+  } else {
+    *--p = '0' + value;
+  }
+#endif
+  while((end - p) < width) {
+    *--p = '0';
+  }
+  return p;
+}
+
+static char *any32(char *end, uint32_t value, uint8_t base, uint8_t upper)
+{
+  char *p = end;
+  char alpha = (upper ? 'A' : 'a') - 10;
+  uint8_t shift = 0;
+  uint32_t d;
+
+  if(base == 10) {
+    return dec32(end, value, 1);
+  }
+  if((base & (base - 1)) == 0) {
+    shift = __builtin_ctz(base);
+  }
+  do {
+    if(shift != 0) {
+      d = value & (base - 1);
+      value >>= shift;
+    } else {
+      uint32_t q = value / base;
+      d = value - q * base;
+      value = q;
+    }
+    *--p = (d < 10) ? ('0' + d) : (alpha + d);
+  } while(value != 0);
+  return p;
+}
+
+static size_t output(char *buf, const char *start, const char *end)
+{
+  size_t len = end - start;
+
+  memmove(buf, start, len);
+  buf[len] = '\0';
+  return len;
+}
+
+size_t numfmt_ulong(char *buf, unsigned long value, uint8_t base, uint8_t upper)
+{
+  char tmp[NUMFMT_LONG_SIZE];
+  char *end = tmp + sizeof(tmp);
+
+  if((base < 2) || (base > 36)) {
+    base = 10;
+  }
+  return output(buf, any32(end, value, base, upper), end);
+}
+
+size_t numfmt_long(char *buf, long value, uint8_t base, uint8_t upper)
+{
+  char tmp[NUMFMT_LONG_SIZE];
+  char *end = tmp + sizeof(tmp);
+  char *p;
+
+  if((base < 2) || (base > 36)) {
+    base = 10;
+  }
+  if((base == 10) && (value < 0)) {
+    p = dec32(end, -(unsigned long)value, 1);
+    *--p = '-';
+  } else {
+    p = any32(end, (unsigned long)value, base, upper);
+  }
+  return output(buf, p, end);
+}
+
+size_t numfmt_ullong(char *buf, uint64_t value, uint8_t base, uint8_t upper)
+{
+  char tmp[NUMFMT_LLONG_SIZE];
+  char *end = tmp + sizeof(tmp);
+  char *p = end;
+  uint64_t q;
+
+  if((base < 2) || (base > 36)) {
+    base = 10;
+  }
+  if(base == 10) {
+    // 9 digits at a time: a single 64-bit division for each
+    while(value > 0xFFFFFFFFULL) {
+      q = value / 1000000000UL;
+      p = dec32(p, (uint32_t)(value - q * 1000000000UL), 9);
+      value = q;
+    }
+  } else if((base & (base - 1)) == 0) {
+    // Power of 2: groups of whole digits of 30 bits or less
+    uint8_t bits = __builtin_ctz(base);
+    uint8_t group = (30 / bits) * bits;
+    while(value > 0xFFFFFFFFULL) {
+      char *start = any32(p, (uint32_t)value & ((1UL << group) - 1), base, upper);
+      while((p - start) < (group / bits)) {
+        *--start = '0';
+      }
+      p = start;
+      value >>= group;
+    }
+  } else {
+    while(value > 0xFFFFFFFFULL) {
+      uint32_t d;
+      q = value / base;
+      d = (uint32_t)(value - q * base);
+      *--p = (d < 10) ? ('0' + d) : ((upper ? 'A' : 'a') - 10 + d);
+      value = q;
+    }
+  }
+  return output(buf, any32(p, (uint32_t)value, base, upper), end);
+}
+
+size_t numfmt_double(char *buf, double value, uint8_t prec)
+{
+  char *p = buf;
+  double scale = 1.0;
+  double frac;
+  uint32_t ipart;
+  uint64_t fpart;
+  uint8_t i;
+
+  if(isnan(value)) {
+    strcpy(buf, "nan");
+    return 3;
+  }
+  if(isinf(value)) {
+    strcpy(buf, "inf");
+    return 3;
+  }
+  if((value > 4294967040.0) || (value < -4294967040.0)) {
+    strcpy(buf, "ovf");
+    return 3;
+  }
+  if(value < 0.0) {
+    *p++ = '-';
+    value = -value;
+  }
+  if(prec > NUMFMT_DOUBLE_MAX_PREC) {
+    prec = NUMFMT_DOUBLE_MAX_PREC;
+  }
+  for(i = 0; i < prec; i++) {
+    scale *= 10.0;
+  }
+
+  // Rounded once, on the scaled fraction: the carry goes to the integer
+  ipart = (uint32_t)value;
+  frac = (value - (double)ipart) * scale + 0.5;
+  fpart = (uint64_t)frac;
+  if(fpart >= (uint64_t)scale) {
+    fpart -= (uint64_t)scale;
+    ipart++;
+  }
+
+  p += numfmt_ulong(p, ipart, 10, 0);
+  if(prec > 0) {
+    char tmp[NUMFMT_DOUBLE_MAX_PREC];
+    char *end = tmp + sizeof(tmp);
+    char *start = end;
+
+    // By chunks of 9 digits from the last one: up to 19 digits do not fit
+    // in 32 bits, even split in two
+    while(prec > 9) {
+      uint64_t q = fpart / 1000000000UL;
+      start = dec32(start, (uint32_t)(fpart - q * 1000000000UL), 9);
+      fpart = q;
+      prec -= 9;
+    }
+    start = dec32(start, (uint32_t)fpart, prec);
+    *p++ = '.';
+    p += output(p, start, end);
+  } else {
+    *p = '\0';
+  }
+  return p - buf;
+}
+
+// value > 0 as m * 10^exp10 with m in [1, 10). The greedy steps by 10^(2^i)
+// take at most 9 divisions or multiplications, at the cost of a rounding in
+// the last digits of the long precisions.
+static const double pow10Steps[] = {1e1, 1e2, 1e4, 1e8, 1e16, 1e32, 1e64, 1e128, 1e256};
+
+static double scale10(double value, int *exp10)
+{
+  int e = 0;
+  int8_t i;
+
+  if(value >= 10.0) {
+    for(i = 8; i >= 0; i--) {
+      if(value >= pow10Steps[i]) {
+        value /= pow10Steps[i];
+        e += 1 << i;
+      }
+    }
+  } else if(value < 1.0) {
+    for(i = 8; i >= 0; i--) {
+      if(value * pow10Steps[i] < 10.0) {
+        value *= pow10Steps[i];
+        e -= 1 << i;
+      }
+    }
+  }
+  // The divisions above are not exact
+  if(value >= 10.0) {
+    value /= 10.0;
+    e++;
+  } else if(value < 1.0) {
+    value *= 10.0;
+    e--;
+  }
+  *exp10 = e;
+  return value;
+}
+
+// Mantissa of value >= 0 (not nan or inf) in exponent form with prec digits
+// after the point, the exponent in *exp10. Returns the length.
+static size_t numfmt_exp(char *buf, double value, uint8_t prec, int *exp10)
+{
+  double m = 0.0;
+  size_t len;
+
+  *exp10 = 0;
+  if(value > 0.0) {
+    m = scale10(value, exp10);
+  }
+  len = numfmt_double(buf, m, prec);
+  if(buf[1] == '0') {
+    // Rounded up to 10
+    len = numfmt_double(buf, m / 10.0, prec);
+    (*exp10)++;
+  }
+  return len;
+}
+
+// e+dd, at least 2 digits
+static size_t exp_text(char *buf, int exp10, uint8_t upper)
+{
+  buf[0] = upper ? 'E' : 'e';
+  buf[1] = (exp10 < 0) ? '-' : '+';
+  if(exp10 < 0) {
+    exp10 = -exp10;
+  }
+  if(exp10 < 10) {
+    buf[2] = '0';
+    return 3 + numfmt_ulong(buf + 3, exp10, 10, 0);
+  }
+  return 2 + numfmt_ulong(buf + 2, exp10, 10, 0);
+}
+
+// Formatted output: buf filled then given to flush
+typedef struct {
+  char *buf;
+  size_t limit;
+  size_t pos;
+  size_t total;
+  numfmt_flush_t flush;
+  void *arg;
+} numfmt_out_t;
+
+static void out_text(numfmt_out_t *out, const char *text, size_t len)
+{
+  size_t n;
+
+  out->total += len;
+  while(len > 0) {
+    if(out->pos >= out->limit) {
+      if(out->flush == NULL) {
+        return;
+      }
+      out->flush(out->arg, out->buf, out->pos);
+      out->pos = 0;
+    }
+    n = out->limit - out->pos;
+    if(n > len) {
+      n = len;
+    }
+    memcpy(out->buf + out->pos, text, n);
+    out->pos += n;
+    text += n;
+    len -= n;
+  }
+}
+
+static void out_fill(numfmt_out_t *out, char c, size_t count)
+{
+  char fill[8];
+
+  memset(fill, c, sizeof(fill));
+  while(count > sizeof(fill)) {
+    out_text(out, fill, sizeof(fill));
+    count -= sizeof(fill);
+  }
+  out_text(out, fill, count);
+}
+
+#define FLAG_LEFT   0x01
+#define FLAG_PLUS   0x02
+#define FLAG_SPACE  0x04
+#define FLAG_ALT    0x08
+#define FLAG_ZERO   0x10
+
+// [padding][sign][prefix][zeros][text][trailing zeros][suffix][padding]
+static void out_field(numfmt_out_t *out, uint8_t flags, size_t width, char sign,
+                      const char *prefix, size_t zeros, const char *text,
+                      size_t len, size_t trailing, const char *suffix)
+{
+  size_t prefixLen = strlen(prefix);
+  size_t suffixLen = strlen(suffix);
+  size_t total = (sign ? 1 : 0) + prefixLen + zeros + len + trailing + suffixLen;
+  size_t pad = (width > total) ? width - total : 0;
+
+  if(!(flags & (FLAG_LEFT | FLAG_ZERO))) {
+    out_fill(out, ' ', pad);
+  }
+  if(sign) {
+    out_text(out, &sign, 1);
+  }
+  out_text(out, prefix, prefixLen);
+  if((flags & (FLAG_LEFT | FLAG_ZERO)) == FLAG_ZERO) {
+    out_fill(out, '0', pad);
+  }
+  out_fill(out, '0', zeros);
+  out_text(out, text, len);
+  out_fill(out, '0', trailing);
+  out_text(out, suffix, suffixLen);
+  if(flags & FLAG_LEFT) {
+    out_fill(out, ' ', pad);
+  }
+}
+
+size_t numfmt_vformat(char *buf, size_t size, numfmt_flush_t flush, void *arg,
+                      const char *format, va_list ap)
+{
+  numfmt_out_t out;
+  char tmp[NUMFMT_LLONG_SIZE > NUMFMT_DOUBLE_SIZE ? NUMFMT_LLONG_SIZE : NUMFMT_DOUBLE_SIZE];
+  const char *p;
+
+  out.buf = buf;
+  out.limit = (flush != NULL) ? size : ((size > 0) ? size - 1 : 0);
+  out.pos = 0;
+  out.total = 0;
+  out.flush = flush;
+  out.arg = arg;
+
+  while(*format != '\0') {
+    uint8_t flags = 0;
+    size_t width = 0;
+    int prec = -1;
+    uint8_t lng = 0;    // number of 'l', 0 for int and shorter
+    uint8_t shrt = 0;   // number of 'h'
+    uint8_t base = 10;
+    uint8_t upper = 0;
+    const char *prefix = "";
+    char sign = 0;
+    size_t len;
+    char conv;
+
+    if(*format != '%') {
+      for(p = format; (*p != '\0') && (*p != '%'); p++);
+      out_text(&out, format, p - format);
+      format = p;
+      continue;
+    }
+    p = format++;
+
+    for(;; format++) {
+      if(*format == '-') {
+        flags |= FLAG_LEFT;
+      } else if(*format == '+') {
+        flags |= FLAG_PLUS;
+      } else if(*format == ' ') {
+        flags |= FLAG_SPACE;
+      } else if(*format == '#') {
+        flags |= FLAG_ALT;
+      } else if(*format == '0') {
+        flags |= FLAG_ZERO;
+      } else {
+        break;
+      }
+    }
+    if(*format == '*') {
+      int w = va_arg(ap, int);
+      if(w < 0) {
+        flags |= FLAG_LEFT;
+        w = -w;
+      }
+      width = w;
+      format++;
+    } else {
+      while((*format >= '0') && (*format <= '9')) {
+        width = width * 10 + (*format++ - '0');
+      }
+    }
+    if(*format == '.') {
+      format++;
+      prec = 0;
+      if(*format == '*') {
+        prec = va_arg(ap, int);
+        format++;
+      } else {
+        while((*format >= '0') && (*format <= '9')) {
+          prec = prec * 10 + (*format++ - '0');
+        }
+      }
+    }
+    // int, long, size_t, intmax_t and ptrdiff_t are 32-bit here
+    while((*format == 'h') || (*format == 'l') || (*format == 'z') ||
+          (*format == 'j') || (*format == 't')) {
+      if(*format == 'l') {
+        lng++;
+      } else if(*format == 'h') {
+        shrt++;
+      }
+      format++;
+    }
+
+    conv = *format++;
+    switch(conv) {
+      case 'd':
+      case 'i':
+        if(lng >= 2) {
+          long long v = va_arg(ap, long long);
+          sign = (v < 0) ? '-' : 0;
+          len = numfmt_ullong(tmp, (v < 0) ? -(unsigned long long)v : (unsigned long long)v, 10, 0);
+        } else {
+          long v = (lng == 1) ? va_arg(ap, long) : va_arg(ap, int);
+          if(lng == 0) {
+            // Promoted to int: truncated back like printf
+            v = (shrt >= 2) ? (signed char)v : (shrt == 1) ? (short)v : v;
+          }
+          sign = (v < 0) ? '-' : 0;
+          len = numfmt_ulong(tmp, (v < 0) ? -(unsigned long)v : (unsigned long)v, 10, 0);
+        }
+        if(!sign) {
+          sign = (flags & FLAG_PLUS) ? '+' : (flags & FLAG_SPACE) ? ' ' : 0;
+        }
+        goto integer;
+      case 'X':
+        upper = 1;
+        // fall through
+      case 'x':
+        base = 16;
+        goto unsigned_integer;
+      case 'o':
+        base = 8;
+        goto unsigned_integer;
+      case 'u':
+      unsigned_integer:
+        if(lng >= 2) {
+          unsigned long long v = va_arg(ap, unsigned long long);
+          len = numfmt_ullong(tmp, v, base, upper);
+        } else {
+          unsigned long v = (lng == 1) ? va_arg(ap, unsigned long) : va_arg(ap, unsigned int);
+          if(lng == 0) {
+            v = (shrt >= 2) ? (unsigned char)v : (shrt == 1) ? (unsigned short)v : v;
+          }
+          len = numfmt_ulong(tmp, v, base, upper);
+        }
+        if((flags & FLAG_ALT) && !((len == 1) && (tmp[0] == '0'))) {
+          prefix = (base == 16) ? (upper ? "0X" : "0x") : (base == 8) ? "0" : "";
+        }
+      integer:
+        if(prec >= 0) {
+          // Precision: minimum number of digits, 0 prints nothing
+          flags &= ~FLAG_ZERO;
+          if((prec == 0) && (len == 1) && (tmp[0] == '0')) {
+            len = 0;
+            if((flags & FLAG_ALT) && (base == 8)) {
+              prefix = "0";
+            }
+          }
+        }
+        out_field(&out, flags, width, sign, prefix,
+                  ((prec > 0) && ((size_t)prec > len)) ? prec - len : 0, tmp, len, 0, "");
+        break;
+      case 'p':
+        len = numfmt_ulong(tmp, (unsigned long)(uintptr_t)va_arg(ap, void *), 16, 0);
+        out_field(&out, flags & ~FLAG_ZERO, width, 0, "0x", 0, tmp, len, 0, "");
+        break;
+      case 'f':
+      case 'F':
+      case 'e':
+      case 'E':
+      case 'g':
+      case 'G': {
+        double v = va_arg(ap, double);
+        char form = conv | 0x20;
+        char expBuf[8] = "";
+        uint8_t strip = 0;
+        size_t digits;      // computed after the point, prec with zeros
+        size_t i;
+        int exp10;
+
+        if(prec < 0) {
+          prec = 6;
+        }
+        if(v < 0.0) {
+          sign = '-';
+          v = -v;
+        } else {
+          sign = (flags & FLAG_PLUS) ? '+' : (flags & FLAG_SPACE) ? ' ' : 0;
+        }
+        if(isnan(v) || isinf(v)) {
+          form = 'f';
+        } else if(form == 'g') {
+          // Precision: significant digits. Fixed form if the exponent is in
+          // [-4, precision), with the point of the mantissa moved when
+          // numfmt_double cannot write the value.
+          if(prec == 0) {
+            prec = 1;
+          }
+          len = numfmt_exp(tmp, v, (prec > NUMFMT_DOUBLE_MAX_PREC) ? NUMFMT_DOUBLE_MAX_PREC : prec - 1,
+                           &exp10);
+          if((exp10 < -4) || (exp10 >= prec) ||
+             ((v > 4294967040.0) && (exp10 > NUMFMT_DOUBLE_MAX_PREC))) {
+            form = 'e';
+            prec -= 1;
+          } else if(v > 4294967040.0) {
+            form = 'm';
+            memmove(tmp + 1, tmp + 2, exp10);
+            tmp[exp10 + 1] = '.';
+            digits = len - 2 - exp10;
+            prec -= 1 + exp10;
+          } else {
+            form = 'f';
+            prec -= 1 + exp10;
+          }
+          strip = !(flags & FLAG_ALT);
+        }
+        if(form != 'm') {
+          digits = (prec > NUMFMT_DOUBLE_MAX_PREC) ? NUMFMT_DOUBLE_MAX_PREC : prec;
+          if(form == 'e') {
+            len = numfmt_exp(tmp, v, digits, &exp10);
+            exp_text(expBuf, exp10, !(conv & 0x20));
+          } else {
+            len = numfmt_double(tmp, v, digits);
+          }
+        }
+        if(tmp[len - 1] > '9') {
+          // nan, inf, ovf
+          flags &= ~FLAG_ZERO;
+          for(i = 0; !(conv & 0x20) && (i < len); i++) {
+            tmp[i] &= ~0x20;
+          }
+          digits = prec;
+        } else if(strip) {
+          // %g: no trailing zeros, no point at the end
+          if(memchr(tmp, '.', len) != NULL) {
+            while(tmp[len - 1] == '0') {
+              len--;
+            }
+            if(tmp[len - 1] == '.') {
+              len--;
+            }
+          }
+          digits = prec;
+        } else if((flags & FLAG_ALT) && (memchr(tmp, '.', len) == NULL)) {
+          tmp[len++] = '.';
+        }
+        out_field(&out, flags, width, sign, "", 0, tmp, len, prec - digits, expBuf);
+        break;
+      }
+      case 'c':
+        tmp[0] = (char)va_arg(ap, int);
+        out_field(&out, flags & ~FLAG_ZERO, width, 0, "", 0, tmp, 1, 0, "");
+        break;
+      case 's': {
+        const char *s = va_arg(ap, const char *);
+
+        if(s == NULL) {
+          s = "(null)";
+        }
+        for(len = 0; (s[len] != '\0') && ((prec < 0) || (len < (size_t)prec)); len++);
+        out_field(&out, flags & ~FLAG_ZERO, width, 0, "", 0, s, len, 0, "");
+        break;
+      }
+      case '%':
+        out_text(&out, "%", 1);
+        break;
+      default:
+        // Unknown conversion: written as is
+        if(conv == '\0') {
+          format--;
+        }
+        out_text(&out, p, format - p);
+        break;
+    }
+  }
+
+  if(flush != NULL) {
+    if(out.pos > 0) {
+      flush(arg, buf, out.pos);
+    }
+  } else if(size > 0) {
+    buf[out.pos] = '\0';
+  }
+  return out.total;
+}
+
+#ifdef __cplusplus
+}
+#endif
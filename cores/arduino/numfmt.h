@@ -0,0 +1,70 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Number to text conversion shared by Print, String, itoa and dtostrf.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _NUMFMT_H_
+#define _NUMFMT_H_
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Buffer sizes, terminating zero included
+#define NUMFMT_LONG_SIZE        (8 * sizeof(long) + 2)      // base 2, sign
+#define NUMFMT_LLONG_SIZE       (8 * sizeof(uint64_t) + 2)
+// Digits after the point computed, the others are zeros
+#define NUMFMT_DOUBLE_MAX_PREC  19
+#define NUMFMT_DOUBLE_SIZE      (1 + 10 + 1 + NUMFMT_DOUBLE_MAX_PREC + 1)
+
+// The functions write the number and a terminating zero to buf and return
+// its length. base is 2 to 36, the letters are uppercase if upper is not 0.
+size_t numfmt_ulong(char *buf, unsigned long value, uint8_t base, uint8_t upper);
+// The sign is written in base 10 only, the other bases give the two's
+// complement like ltoa().
+size_t numfmt_long(char *buf, long value, uint8_t base, uint8_t upper);
+size_t numfmt_ullong(char *buf, uint64_t value, uint8_t base, uint8_t upper);
+// Fixed point, rounded to prec digits after the point (no point if 0).
+// "nan", "inf" or "ovf" (beyond +/-4294967040) if it cannot be written.
+// prec is limited to NUMFMT_DOUBLE_MAX_PREC.
+size_t numfmt_double(char *buf, double value, uint8_t prec);
+
+// printf-like formatting into buf. When buf is full and at the end, the
+// text is given to flush, so the output is not limited by size. Without
+// flush the text is truncated to size - 1 and terminated like vsnprintf.
+// Returns the length of the whole text.
+// Flags - + space # 0, width and precision (number or *), lengths hh h l ll
+// z j t, conversions d i u o x X c s p f F e E g G %. Like printf, except:
+// - f F: see numfmt_double for the range, beyond it "ovf"
+// - e E g G: the 19 first digits after the point are computed, the others
+//   are zeros; the last ones of the longer precisions may differ from printf
+// - the exact ties are rounded away from zero
+// - the unknown conversions are written as is.
+typedef void (*numfmt_flush_t)(void *arg, const char *text, size_t len);
+size_t numfmt_vformat(char *buf, size_t size, numfmt_flush_t flush, void *arg,
+                      const char *format, va_list ap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _NUMFMT_H_
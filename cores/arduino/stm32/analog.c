@@ -46,6 +46,8 @@
 /** @addtogroup STM32F4xx_System_Private_Includes
   * @{
   */
+#include <math.h>
+#include <stdlib.h>
 #include "stm32_def.h"
 #include "analog.h"
 #include "timer.h"
@@ -195,30 +197,6 @@ static uint32_t get_adc_channel(PinName pin)
   return channel;
 }
 
-static uint32_t get_pwm_channel(PinName pin)
-{
-  uint32_t function = pinmap_function(pin, PinMap_PWM);
-  uint32_t channel = 0;
-  switch(STM_PIN_CHANNEL(function)) {
-    case 1:
-      channel = TIM_CHANNEL_1;
-      break;
-    case 2:
-      channel = TIM_CHANNEL_2;
-      break;
-    case 3:
-      channel = TIM_CHANNEL_3;
-      break;
-    case 4:
-      channel = TIM_CHANNEL_4;
-      break;
-    default:
-      channel = 0;
-    break;
-   }
-  return channel;
-}
-
 #ifdef HAL_DAC_MODULE_ENABLED
 static uint32_t get_dac_channel(PinName pin)
 {
@@ -245,6 +223,8 @@ static uint32_t get_dac_channel(PinName pin)
   return channel;
 }
 
+static uint8_t dac_stream_active(void);
+
 ////////////////////////// DAC INTERFACE FUNCTIONS /////////////////////////////
 
 /**
@@ -301,7 +281,9 @@ void dac_write_value(PinName pin, uint32_t value, uint8_t do_init)
   if (!IS_DAC_CHANNEL(dacChannel)) return;
   if(do_init == 1) {
 
-    if (HAL_DAC_DeInit(&DacHandle) != HAL_OK)
+    dac_stream_stop(pin);
+    /* Do not reset the DAC while the other channel plays a stream */
+    if ((dac_stream_active() == 0) && (HAL_DAC_DeInit(&DacHandle) != HAL_OK))
     {
       /* DeInitialization Error */
       return;
@@ -370,14 +352,645 @@ void dac_stop(PinName pin)
   dacChannel = get_dac_channel(pin);
   if (!IS_DAC_CHANNEL(dacChannel)) return;
 
+  dac_stream_stop(pin);
   HAL_DAC_Stop(&DacHandle, dacChannel);
 
-  if (HAL_DAC_DeInit(&DacHandle) != HAL_OK)
+  if ((dac_stream_active() == 0) && (HAL_DAC_DeInit(&DacHandle) != HAL_OK))
   {
     /* DeInitialization Error */
     return;
   }
 }
+
+////////////////////////// DAC STREAM FUNCTIONS ////////////////////////////////
+
+/* The DAC output settles in about 1us */
+#define DAC_MAX_SAMPLE_RATE   1000000
+#define DAC_MAX_VALUE         4095
+#define DAC_SINE_MAX_SAMPLES  256
+#define DAC_STREAM_NB         2   /* one per DAC channel */
+
+#if defined(DAC1)
+#define DAC_STREAM_INSTANCE   DAC1
+#else
+#define DAC_STREAM_INSTANCE   DAC
+#endif
+
+#ifdef DAC_DMA_STREAM
+/* DMA requests of the DAC channels */
+#if defined(STM32F2xx) || defined(STM32F4xx) || defined(STM32F7xx)
+#define DAC_DMA_CH1_INSTANCE    DMA1_Stream5
+#define DAC_DMA_CH1_REQUEST     DMA_CHANNEL_7
+#define DAC_DMA_CH1_IRQn        DMA1_Stream5_IRQn
+#define DAC_DMA_CH1_IRQHandler  DMA1_Stream5_IRQHandler
+#define DAC_DMA_CH2_INSTANCE    DMA1_Stream6
+#define DAC_DMA_CH2_REQUEST     DMA_CHANNEL_7
+#define DAC_DMA_CH2_IRQn        DMA1_Stream6_IRQn
+#define DAC_DMA_CH2_IRQHandler  DMA1_Stream6_IRQHandler
+#elif defined(STM32F3xx)
+/* Remapped from DMA2 on the devices having it, see dac_dma_config() */
+#define DAC_DMA_CH1_INSTANCE    DMA1_Channel3
+#define DAC_DMA_CH1_IRQn        DMA1_Channel3_IRQn
+#define DAC_DMA_CH1_IRQHandler  DMA1_Channel3_IRQHandler
+#define DAC_DMA_CH2_INSTANCE    DMA1_Channel4
+#define DAC_DMA_CH2_IRQn        DMA1_Channel4_IRQn
+#define DAC_DMA_CH2_IRQHandler  DMA1_Channel4_IRQHandler
+#elif defined(STM32L0xx)
+#define DAC_DMA_CH1_INSTANCE    DMA1_Channel2
+#define DAC_DMA_CH1_REQUEST     DMA_REQUEST_9
+#define DAC_DMA_CH1_IRQn        DMA1_Channel2_3_IRQn
+#define DAC_DMA_CH1_IRQHandler  DMA1_Channel2_3_IRQHandler
+#define DAC_DMA_CH2_INSTANCE    DMA1_Channel4
+#define DAC_DMA_CH2_REQUEST     DMA_REQUEST_15
+#define DAC_DMA_CH2_IRQn        DMA1_Channel4_5_6_7_IRQn
+#define DAC_DMA_CH2_IRQHandler  DMA1_Channel4_5_6_7_IRQHandler
+#elif defined(STM32L1xx)
+#define DAC_DMA_CH1_INSTANCE    DMA1_Channel2
+#define DAC_DMA_CH1_IRQn        DMA1_Channel2_IRQn
+#define DAC_DMA_CH1_IRQHandler  DMA1_Channel2_IRQHandler
+#define DAC_DMA_CH2_INSTANCE    DMA1_Channel3
+#define DAC_DMA_CH2_IRQn        DMA1_Channel3_IRQn
+#define DAC_DMA_CH2_IRQHandler  DMA1_Channel3_IRQHandler
+#elif defined(STM32L4xx)
+#define DAC_DMA_CH1_INSTANCE    DMA1_Channel3
+#define DAC_DMA_CH1_REQUEST     DMA_REQUEST_6
+#define DAC_DMA_CH1_IRQn        DMA1_Channel3_IRQn
+#define DAC_DMA_CH1_IRQHandler  DMA1_Channel3_IRQHandler
+#define DAC_DMA_CH2_INSTANCE    DMA1_Channel4
+#define DAC_DMA_CH2_REQUEST     DMA_REQUEST_5
+#define DAC_DMA_CH2_IRQn        DMA1_Channel4_IRQn
+#define DAC_DMA_CH2_IRQHandler  DMA1_Channel4_IRQHandler
+#endif
+#endif /* DAC_DMA_STREAM */
+
+typedef struct {
+  stimer_t timer;             /* trigger timer, TRGO on update */
+#ifdef DAC_DMA_STREAM
+  DMA_HandleTypeDef hdma;
+#endif
+  uint32_t channel;           /* DAC_CHANNEL_x, 0 when stopped */
+  uint16_t *buffer;
+  uint32_t length;
+  uint16_t *sine;             /* table allocated by dac_wave_start() */
+  dacStreamCallback_t refill;
+  volatile uint8_t busy;
+} dac_stream_t;
+
+static DAC_HandleTypeDef DacStreamHandle;
+static dac_stream_t dac_streams[DAC_STREAM_NB];
+
+static const uint32_t dac_triangle_amplitude[12] = {
+  DAC_TRIANGLEAMPLITUDE_1, DAC_TRIANGLEAMPLITUDE_3, DAC_TRIANGLEAMPLITUDE_7,
+  DAC_TRIANGLEAMPLITUDE_15, DAC_TRIANGLEAMPLITUDE_31, DAC_TRIANGLEAMPLITUDE_63,
+  DAC_TRIANGLEAMPLITUDE_127, DAC_TRIANGLEAMPLITUDE_255, DAC_TRIANGLEAMPLITUDE_511,
+  DAC_TRIANGLEAMPLITUDE_1023, DAC_TRIANGLEAMPLITUDE_2047, DAC_TRIANGLEAMPLITUDE_4095
+};
+
+static const uint32_t dac_lfsr_mask[12] = {
+  DAC_LFSRUNMASK_BIT0, DAC_LFSRUNMASK_BITS1_0, DAC_LFSRUNMASK_BITS2_0,
+  DAC_LFSRUNMASK_BITS3_0, DAC_LFSRUNMASK_BITS4_0, DAC_LFSRUNMASK_BITS5_0,
+  DAC_LFSRUNMASK_BITS6_0, DAC_LFSRUNMASK_BITS7_0, DAC_LFSRUNMASK_BITS8_0,
+  DAC_LFSRUNMASK_BITS9_0, DAC_LFSRUNMASK_BITS10_0, DAC_LFSRUNMASK_BITS11_0
+};
+
+/**
+  * @brief  Return the stream of a DAC pin
+  * @param  pin : the gpio pin to use
+  * @param  channel : set to the DAC channel of the pin
+  * @retval stream or NULL if the pin has no DAC channel
+  */
+static dac_stream_t *dac_get_stream(PinName pin, uint32_t *channel)
+{
+  if (pinmap_peripheral(pin, PinMap_DAC) != DAC_STREAM_INSTANCE) {
+    return NULL;
+  }
+  *channel = get_dac_channel(pin);
+  if (*channel == DAC_CHANNEL_1) {
+    return &dac_streams[0];
+  }
+#ifdef DAC_CHANNEL_2
+  if (*channel == DAC_CHANNEL_2) {
+    return &dac_streams[1];
+  }
+#endif
+  return NULL;
+}
+
+/**
+  * @brief  Check if a DAC channel plays a stream or a wave
+  * @param  None
+  * @retval 1 if a channel is used
+  */
+static uint8_t dac_stream_active(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < DAC_STREAM_NB; i++) {
+    if (dac_streams[i].channel != 0) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+  * @brief  Reserve TIM6 or TIM7 and set its update rate, the update event
+  *         triggers the DAC conversions. The timer is not started.
+  * @param  stream : stream to trigger
+  * @param  rate : trigger frequency in Hz
+  * @param  trigger : set to the DAC trigger of the timer
+  * @retval 1 if done, 0 if no timer is free or rate is out of range
+  */
+static uint8_t dac_trigger_init(dac_stream_t *stream, uint32_t rate, uint32_t *trigger)
+{
+  TIM_HandleTypeDef *handle = &(stream->timer.handle);
+  TIM_MasterConfigTypeDef masterConfig = {};
+  TIM_TypeDef *tim = NULL;
+  uint32_t ticks;
+  uint32_t prescaler;
+
+  if ((rate == 0) || (rate > DAC_MAX_SAMPLE_RATE)) {
+    return 0;
+  }
+  if ((getTimerUser(TIM6) == TIMER_FREE) && TimerAcquire(TIM6, TIMER_USED_DAC)) {
+    tim = TIM6;
+    *trigger = DAC_TRIGGER_T6_TRGO;
+  }
+#if defined(TIM7)
+  else if ((getTimerUser(TIM7) == TIMER_FREE) && TimerAcquire(TIM7, TIMER_USED_DAC)) {
+    tim = TIM7;
+    *trigger = DAC_TRIGGER_T7_TRGO;
+  }
+#endif
+  if (tim == NULL) {
+    return 0;
+  }
+
+  /* Basic timers are 16-bit: prescaler and period up to 0x10000 */
+  ticks = (getTimerClkFreq(tim) + rate / 2) / rate;
+  prescaler = ticks / 0x10000 + 1;
+  ticks = (ticks + prescaler / 2) / prescaler;
+  if (ticks < 2) {
+    TimerRelease(tim, TIMER_USED_DAC);
+    return 0;
+  }
+
+  memset(&(stream->timer), 0, sizeof(stimer_t));
+  stream->timer.timer = tim;
+  handle->Instance               = tim;
+  handle->Init.Prescaler         = prescaler - 1;
+  handle->Init.CounterMode       = TIM_COUNTERMODE_UP;
+  handle->Init.Period            = ticks - 1;
+  handle->Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
+#if !defined(STM32L0xx) && !defined(STM32L1xx)
+  handle->Init.RepetitionCounter = 0x0000;
+#endif
+  masterConfig.MasterOutputTrigger = TIM_TRGO_UPDATE;
+  masterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+  if ((HAL_TIM_Base_Init(handle) != HAL_OK) ||
+      (HAL_TIMEx_MasterConfigSynchronization(handle, &masterConfig) != HAL_OK)) {
+    HAL_TIM_Base_DeInit(handle);
+    TimerRelease(tim, TIMER_USED_DAC);
+    return 0;
+  }
+  return 1;
+}
+
+/**
+  * @brief  Configure a DAC channel converting on a trigger
+  * @param  pin : the gpio pin to use
+  * @param  channel : DAC channel of the pin
+  * @param  trigger : DAC_TRIGGER_x
+  * @retval 1 if done
+  */
+static uint8_t dac_channel_config(PinName pin, uint32_t channel, uint32_t trigger)
+{
+  DAC_ChannelConfTypeDef dacChannelConf = {};
+
+  /* The MSP also sets the pin in analog mode, required for each channel */
+  g_current_pin = pin;
+  DacStreamHandle.Instance = DAC_STREAM_INSTANCE;
+  if (DacStreamHandle.State == HAL_DAC_STATE_RESET) {
+    if (HAL_DAC_Init(&DacStreamHandle) != HAL_OK) {
+      return 0;
+    }
+  } else {
+    HAL_DAC_MspInit(&DacStreamHandle);
+  }
+
+  dacChannelConf.DAC_Trigger = trigger;
+  dacChannelConf.DAC_OutputBuffer = DAC_OUTPUTBUFFER_ENABLE;
+  return (HAL_DAC_ConfigChannel(&DacStreamHandle, &dacChannelConf, channel) == HAL_OK);
+}
+
+#ifdef DAC_DMA_STREAM
+/**
+  * @brief  Configure the DMA request of a DAC channel
+  * @param  stream : stream of the channel
+  * @param  channel : DAC channel
+  * @param  circular : 1 to restart from the beginning of the buffer at the end
+  * @retval 1 if done
+  */
+static uint8_t dac_dma_config(dac_stream_t *stream, uint32_t channel, uint8_t circular)
+{
+  DMA_HandleTypeDef *hdma = &(stream->hdma);
+  IRQn_Type irq;
+
+  memset(hdma, 0, sizeof(DMA_HandleTypeDef));
+  __HAL_RCC_DMA1_CLK_ENABLE();
+  if (channel == DAC_CHANNEL_1) {
+    hdma->Instance = DAC_DMA_CH1_INSTANCE;
+#ifdef DAC_DMA_CH1_REQUEST
+#if defined(STM32L0xx) || defined(STM32L4xx)
+    hdma->Init.Request = DAC_DMA_CH1_REQUEST;
+#else
+    hdma->Init.Channel = DAC_DMA_CH1_REQUEST;
+#endif
+#endif
+#if defined(SYSCFG_CFGR1_TIM6DAC1Ch1_DMA_RMP) && defined(DMA2)
+    __HAL_RCC_SYSCFG_CLK_ENABLE();
+    SET_BIT(SYSCFG->CFGR1, SYSCFG_CFGR1_TIM6DAC1Ch1_DMA_RMP);
+#endif
+    irq = DAC_DMA_CH1_IRQn;
+    __HAL_LINKDMA(&DacStreamHandle, DMA_Handle1, *hdma);
+  }
+#ifdef DAC_CHANNEL_2
+  else {
+    hdma->Instance = DAC_DMA_CH2_INSTANCE;
+#ifdef DAC_DMA_CH2_REQUEST
+#if defined(STM32L0xx) || defined(STM32L4xx)
+    hdma->Init.Request = DAC_DMA_CH2_REQUEST;
+#else
+    hdma->Init.Channel = DAC_DMA_CH2_REQUEST;
+#endif
+#endif
+#if defined(SYSCFG_CFGR1_TIM7DAC1Ch2_DMA_RMP) && defined(DMA2)
+    __HAL_RCC_SYSCFG_CLK_ENABLE();
+    SET_BIT(SYSCFG->CFGR1, SYSCFG_CFGR1_TIM7DAC1Ch2_DMA_RMP);
+#endif
+    irq = DAC_DMA_CH2_IRQn;
+    __HAL_LINKDMA(&DacStreamHandle, DMA_Handle2, *hdma);
+  }
+#else
+  else {
+    return 0;
+  }
+#endif
+
+  hdma->Init.Direction = DMA_MEMORY_TO_PERIPH;
+  hdma->Init.PeriphInc = DMA_PINC_DISABLE;
+  hdma->Init.MemInc = DMA_MINC_ENABLE;
+  hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+  hdma->Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+  hdma->Init.Mode = (circular) ? DMA_CIRCULAR : DMA_NORMAL;
+  hdma->Init.Priority = DMA_PRIORITY_HIGH;
+#if defined(STM32F2xx) || defined(STM32F4xx) || defined(STM32F7xx)
+  hdma->Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+#endif
+  if (HAL_DMA_Init(hdma) != HAL_OK) {
+    hdma->Instance = NULL;
+    return 0;
+  }
+
+  /* The refill callback must run before the DMA reaches the other half */
+  HAL_NVIC_SetPriority(irq, 1, 0);
+  HAL_NVIC_EnableIRQ(irq);
+  return 1;
+}
+
+/**
+  * @brief  Start the DMA transfer of a buffer to a DAC channel
+  * @param  stream : stream of the channel, stopped
+  * @param  pin : the gpio pin to use
+  * @param  channel : DAC channel of the pin
+  * @param  buffer : 12-bit right aligned samples
+  * @param  length : number of samples, up to 0xFFFF
+  * @param  sampleRate : samples per second
+  * @param  circular : 1 to replay the buffer, 0 to play it once
+  * @param  refill : called to fill each half of the buffer, NULL if none
+  * @retval 1 if started
+  */
+static uint8_t dac_dma_start(dac_stream_t *stream, PinName pin, uint32_t channel,
+                             uint16_t *buffer, uint32_t length, uint32_t sampleRate,
+                             uint8_t circular, dacStreamCallback_t refill)
+{
+  uint32_t trigger;
+
+  if (!dac_trigger_init(stream, sampleRate, &trigger)) {
+    return 0;
+  }
+  stream->channel = channel;
+  stream->buffer = buffer;
+  stream->length = length;
+  stream->refill = refill;
+  stream->busy = 1;
+  if (!dac_channel_config(pin, channel, trigger) ||
+      !dac_dma_config(stream, channel, circular) ||
+      (HAL_DAC_Start_DMA(&DacStreamHandle, channel, (uint32_t *)buffer, length, DAC_ALIGN_12B_R) != HAL_OK)) {
+    dac_stream_stop(pin);
+    return 0;
+  }
+  /* The underrun interrupt shares its vector with TIM6, not handled */
+#ifdef DAC_IT_DMAUDR2
+  __HAL_DAC_DISABLE_IT(&DacStreamHandle, (channel == DAC_CHANNEL_1) ? DAC_IT_DMAUDR1 : DAC_IT_DMAUDR2);
+#else
+  __HAL_DAC_DISABLE_IT(&DacStreamHandle, DAC_IT_DMAUDR1);
+#endif
+  HAL_TIM_Base_Start(&(stream->timer.handle));
+  return 1;
+}
+#endif /* DAC_DMA_STREAM */
+
+/**
+  * @brief  Play samples on a DAC pin, transferred by DMA at each update of
+  *         a trigger timer (TIM6 or TIM7)
+  * @param  pin : the gpio pin to use
+  * @param  buffer : 12-bit right aligned samples, must stay valid while played
+  * @param  length : number of samples, up to 0xFFFF
+  * @param  sampleRate : samples per second, up to 1MHz
+  * @param  circular : 1 to replay the buffer until dac_stream_stop(), 0 to
+  *         play it once
+  * @param  refill : if not NULL, the buffer is played as a double buffer:
+  *         refill is called to fill it before the start, then to fill each
+  *         half while the DMA plays the other one. circular is ignored.
+  * @retval 1 if started, 0 if the pin has no DAC DMA request or no timer is free
+  */
+uint8_t dac_stream_start(PinName pin, uint16_t *buffer, uint32_t length, uint32_t sampleRate, uint8_t circular, dacStreamCallback_t refill)
+{
+#ifdef DAC_DMA_STREAM
+  dac_stream_t *stream;
+  uint32_t channel;
+
+  if ((buffer == NULL) || (length == 0) || (length > 0xFFFF) ||
+      ((refill != NULL) && (length < 2))) {
+    return 0;
+  }
+  stream = dac_get_stream(pin, &channel);
+  if (stream == NULL) {
+    return 0;
+  }
+  dac_stream_stop(pin);
+
+  if (refill != NULL) {
+    refill(buffer, length);
+    circular = 1;
+  }
+  return dac_dma_start(stream, pin, channel, buffer, length, sampleRate, circular, refill);
+#else
+  UNUSED(pin);
+  UNUSED(buffer);
+  UNUSED(length);
+  UNUSED(sampleRate);
+  UNUSED(circular);
+  UNUSED(refill);
+  return 0;
+#endif
+}
+
+/**
+  * @brief  Generate a waveform on a DAC pin, centered on the middle of the
+  *         DAC range. Triangle and noise use the DAC generators, their
+  *         amplitude is rounded down to a power of 2 minus 1. The sine is a
+  *         table played by DMA.
+  * @param  pin : the gpio pin to use
+  * @param  wave : DAC_SINE_WAVE, DAC_TRIANGLE_WAVE or DAC_NOISE_WAVE
+  * @param  frequency : signal frequency in Hz, samples per second for the noise
+  * @param  amplitude : peak to peak amplitude, up to 4095
+  * @retval 1 if started
+  */
+uint8_t dac_wave_start(PinName pin, dacWave_t wave, uint32_t frequency, uint32_t amplitude)
+{
+  dac_stream_t *stream;
+  uint32_t channel;
+  uint32_t trigger;
+  uint32_t rate;
+  uint32_t bits;
+  uint32_t top;
+
+  stream = dac_get_stream(pin, &channel);
+  if ((stream == NULL) || (frequency == 0) || (amplitude == 0)) {
+    return 0;
+  }
+  dac_stream_stop(pin);
+  if (amplitude > DAC_MAX_VALUE) {
+    amplitude = DAC_MAX_VALUE;
+  }
+
+  if (wave == DAC_SINE_WAVE) {
+#ifdef DAC_DMA_STREAM
+    uint32_t samples = DAC_MAX_SAMPLE_RATE / frequency;
+    uint16_t *table;
+    uint32_t i;
+
+    if (samples > DAC_SINE_MAX_SAMPLES) {
+      samples = DAC_SINE_MAX_SAMPLES;
+    }
+    if (samples < 4) {
+      return 0;
+    }
+    table = (uint16_t *)malloc(samples * sizeof(uint16_t));
+    if (table == NULL) {
+      return 0;
+    }
+    for (i = 0; i < samples; i++) {
+      table[i] = (uint16_t)((DAC_MAX_VALUE + 1) / 2 +
+                            lrintf((float)amplitude / 2.0f * sinf(2.0f * (float)M_PI * (float)i / (float)samples)));
+      if (table[i] > DAC_MAX_VALUE) {
+        table[i] = DAC_MAX_VALUE;
+      }
+    }
+    if (!dac_dma_start(stream, pin, channel, table, samples, frequency * samples, 1, NULL)) {
+      free(table);
+      return 0;
+    }
+    stream->sine = table;
+    return 1;
+#else
+    return 0;
+#endif
+  }
+
+  /* Largest 2^bits - 1 amplitude, a triangle period takes 2 * top triggers */
+  for (bits = 12; bits > 1; bits--) {
+    top = (1UL << bits) - 1;
+    if ((top <= amplitude) &&
+        ((wave == DAC_NOISE_WAVE) || (2 * top * frequency <= DAC_MAX_SAMPLE_RATE))) {
+      break;
+    }
+  }
+  top = (1UL << bits) - 1;
+  rate = (wave == DAC_TRIANGLE_WAVE) ? 2 * top * frequency : frequency;
+
+  if (!dac_trigger_init(stream, rate, &trigger)) {
+    return 0;
+  }
+  stream->channel = channel;
+  stream->busy = 1;
+  if (!dac_channel_config(pin, channel, trigger)) {
+    dac_stream_stop(pin);
+    return 0;
+  }
+  if (wave == DAC_TRIANGLE_WAVE) {
+    HAL_DACEx_TriangleWaveGenerate(&DacStreamHandle, channel, dac_triangle_amplitude[bits - 1]);
+  } else {
+    HAL_DACEx_NoiseWaveGenerate(&DacStreamHandle, channel, dac_lfsr_mask[bits - 1]);
+  }
+  /* The generator value is added to the data register */
+  HAL_DAC_SetValue(&DacStreamHandle, channel, DAC_ALIGN_12B_R, (DAC_MAX_VALUE - top) / 2);
+  HAL_DAC_Start(&DacStreamHandle, channel);
+  HAL_TIM_Base_Start(&(stream->timer.handle));
+  return 1;
+}
+
+/**
+  * @brief  Stop the stream or wave of a DAC pin, the output keeps its
+  *         last value
+  * @param  pin : the gpio pin to use
+  * @retval None
+  */
+void dac_stream_stop(PinName pin)
+{
+  dac_stream_t *stream;
+  uint32_t channel;
+
+  stream = dac_get_stream(pin, &channel);
+  if ((stream == NULL) || (stream->channel == 0)) {
+    return;
+  }
+
+  HAL_TIM_Base_Stop(&(stream->timer.handle));
+  HAL_TIM_Base_DeInit(&(stream->timer.handle));
+  TimerRelease(stream->timer.timer, TIMER_USED_DAC);
+#ifdef DAC_DMA_STREAM
+  if (stream->hdma.Instance != NULL) {
+    HAL_DAC_Stop_DMA(&DacStreamHandle, channel);
+    HAL_NVIC_DisableIRQ((channel == DAC_CHANNEL_1) ? DAC_DMA_CH1_IRQn : DAC_DMA_CH2_IRQn);
+    HAL_DMA_DeInit(&(stream->hdma));
+    stream->hdma.Instance = NULL;
+  } else
+#endif
+  {
+    HAL_DAC_Stop(&DacStreamHandle, channel);
+  }
+
+  if (stream->sine != NULL) {
+    free(stream->sine);
+    stream->sine = NULL;
+  }
+  stream->refill = NULL;
+  stream->busy = 0;
+  stream->channel = 0;
+}
+
+/**
+  * @brief  Check if a DAC pin plays a stream or a wave
+  * @param  pin : the gpio pin to use
+  * @retval 1 until the end of a buffer played once or dac_stream_stop()
+  */
+uint8_t dac_stream_busy(PinName pin)
+{
+  dac_stream_t *stream;
+  uint32_t channel;
+
+  stream = dac_get_stream(pin, &channel);
+  return (stream != NULL) && stream->busy;
+}
+
+#ifdef DAC_DMA_STREAM
+/**
+  * @brief  Half of the buffer transferred: refill it
+  * @param  stream : stream of the channel
+  * @retval None
+  */
+static void dac_stream_half(dac_stream_t *stream)
+{
+  if (stream->refill != NULL) {
+    stream->refill(stream->buffer, stream->length / 2);
+  }
+}
+
+/**
+  * @brief  End of the buffer: refill the second half or end the transfer
+  * @param  stream : stream of the channel
+  * @retval None
+  */
+static void dac_stream_complete(dac_stream_t *stream)
+{
+  if (stream->refill != NULL) {
+    stream->refill(stream->buffer + stream->length / 2, stream->length - stream->length / 2);
+  } else if (stream->hdma.Init.Mode == DMA_NORMAL) {
+    /* Played once: the output keeps the last sample */
+    HAL_TIM_Base_Stop(&(stream->timer.handle));
+    stream->busy = 0;
+  }
+}
+
+/**
+  * @brief  Conversion half DMA transfer callback of the DAC channel 1
+  * @param  hdac : DAC handle
+  * @retval None
+  */
+void HAL_DAC_ConvHalfCpltCallbackCh1(DAC_HandleTypeDef *hdac)
+{
+  UNUSED(hdac);
+  dac_stream_half(&dac_streams[0]);
+}
+
+/**
+  * @brief  Conversion complete callback of the DAC channel 1
+  * @param  hdac : DAC handle
+  * @retval None
+  */
+void HAL_DAC_ConvCpltCallbackCh1(DAC_HandleTypeDef *hdac)
+{
+  UNUSED(hdac);
+  dac_stream_complete(&dac_streams[0]);
+}
+
+/**
+  * @brief  DMA IRQ handler of the DAC channel 1
+  * @param  None
+  * @retval None
+  */
+void DAC_DMA_CH1_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&(dac_streams[0].hdma));
+}
+
+#ifdef DAC_CHANNEL_2
+/**
+  * @brief  Conversion half DMA transfer callback of the DAC channel 2
+  * @param  hdac : DAC handle
+  * @retval None
+  */
+void HAL_DACEx_ConvHalfCpltCallbackCh2(DAC_HandleTypeDef *hdac)
+{
+  UNUSED(hdac);
+  dac_stream_half(&dac_streams[1]);
+}
+
+/**
+  * @brief  Conversion complete callback of the DAC channel 2
+  * @param  hdac : DAC handle
+  * @retval None
+  */
+void HAL_DACEx_ConvCpltCallbackCh2(DAC_HandleTypeDef *hdac)
+{
+  UNUSED(hdac);
+  dac_stream_complete(&dac_streams[1]);
+}
+
+/**
+  * @brief  DMA IRQ handler of the DAC channel 2
+  * @param  None
+  * @retval None
+  */
+void DAC_DMA_CH2_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&(dac_streams[1].hdma));
+}
+#endif /* DAC_CHANNEL_2 */
+#endif /* DAC_DMA_STREAM */
 #endif //HAL_DAC_MODULE_ENABLED
 
 
@@ -677,29 +1290,12 @@ uint16_t adc_read_value(PinName pin)
   */
 void HAL_TIM_PWM_MspInit(TIM_HandleTypeDef *htim)
 {
-  GPIO_InitTypeDef   GPIO_InitStruct;
-  GPIO_TypeDef *port;
-  uint32_t function = pinmap_function(g_current_pin, PinMap_PWM);
   /*##-1- Enable peripherals and GPIO Clocks #################################*/
   /* TIMx Peripheral clock enable */
   timer_enable_clock(htim);
 
-  /* Enable GPIO Channels Clock */
-  /* Enable GPIO clock ****************************************/
-  port = set_GPIO_Port_Clock(STM_PORT(g_current_pin));
-
-  /* Common configuration for all channels */
-  GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
-  GPIO_InitStruct.Pull = GPIO_NOPULL;
-  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
-#ifdef STM32F1xx
-  pin_SetF1AFPin(STM_PIN_AFNUM(function));
-#else
-  GPIO_InitStruct.Alternate = STM_PIN_AFNUM(function);
-#endif /* STM32F1xx */
-  GPIO_InitStruct.Pin = STM_GPIO_PIN(g_current_pin);
-
-  HAL_GPIO_Init(port, &GPIO_InitStruct);
+  /* Configure the pin in alternate function of its timer channel */
+  TimerChannelPinInit(g_current_pin, 0, GPIO_NOPULL);
 }
 
 /**
@@ -720,10 +1316,11 @@ void HAL_TIM_PWM_MspDeInit(TIM_HandleTypeDef *htim)
   * @param  period : period of the tim counter
   * @param  value : the value to push on the PWM output
   * @param  do_init : if set to 1 the initialization of the PWM is done
-  * @retval None
+  * @retval 1 if the PWM is started, 0 if the pin has no timer channel or if
+  *         its timer is already used by another driver (see TimerAcquire())
   */
-void pwm_start(PinName pin, uint32_t clock_freq,
-                uint32_t period, uint32_t value, uint8_t do_init)
+uint8_t pwm_start(PinName pin, uint32_t clock_freq,
+                  uint32_t period, uint32_t value, uint8_t do_init)
 {
   TIM_HandleTypeDef timHandle = {};
   TIM_OC_InitTypeDef timConfig = {};
@@ -731,7 +1328,9 @@ void pwm_start(PinName pin, uint32_t clock_freq,
 
   /* Compute the prescaler value to have TIM counter clock equal to clock_freq Hz */
   timHandle.Instance               = pinmap_peripheral(pin, PinMap_PWM);
-  if (timHandle.Instance == NP) return;
+  if (timHandle.Instance == NP) return 0;
+  timChannel = getTimerChannel(pin);
+  if (!IS_TIM_CHANNELS(timChannel)) return 0;
   timHandle.Init.Prescaler         = (uint32_t)(getTimerClkFreq(timHandle.Instance) / clock_freq) - 1;
   timHandle.Init.Period            = period -1;
   timHandle.Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
@@ -743,13 +1342,16 @@ void pwm_start(PinName pin, uint32_t clock_freq,
   // TBC: is timHandle.State field should be saved ?
 
   if (do_init == 1) {
+    /* One reference per channel, released by pwm_stop() */
+    if (!TimerAcquire(timHandle.Instance, TIMER_USED_PWM)) {
+      return 0;
+    }
     g_current_pin = pin;
     if (HAL_TIM_PWM_Init(&timHandle) != HAL_OK) {
-      return;
+      TimerRelease(timHandle.Instance, TIMER_USED_PWM);
+      return 0;
     }
   }
-  timChannel = get_pwm_channel(pin);
-  if (!IS_TIM_CHANNELS(timChannel)) return;
   //HAL_TIM_PWM_Stop(&timHandle, timChannel);
 
   /*##-2- Configure the PWM channels #########################################*/
@@ -767,7 +1369,10 @@ void pwm_start(PinName pin, uint32_t clock_freq,
   if (HAL_TIM_PWM_ConfigChannel(&timHandle, &timConfig, timChannel) != HAL_OK)
   {
     /*##-2- Configure the PWM channels #########################################*/
-    return;
+    if (do_init == 1) {
+      TimerRelease(timHandle.Instance, TIMER_USED_PWM);
+    }
+    return 0;
   }
 
 #if !defined(STM32L0xx) && !defined(STM32L1xx)
@@ -778,6 +1383,7 @@ void pwm_start(PinName pin, uint32_t clock_freq,
   {
     HAL_TIM_PWM_Start(&timHandle, timChannel);
   }
+  return 1;
 }
 
 /**
@@ -793,7 +1399,7 @@ void pwm_stop(PinName pin)
 
   timHandle.Instance = pinmap_peripheral(pin, PinMap_PWM);
   if (timHandle.Instance == NP) return;
-  timChannel = get_pwm_channel(pin);
+  timChannel = getTimerChannel(pin);
   if (!IS_TIM_CHANNELS(timChannel)) return;
 
 #if !defined(STM32L0xx) && !defined(STM32L1xx)
@@ -805,7 +1411,11 @@ void pwm_stop(PinName pin)
     HAL_TIM_PWM_Stop(&timHandle, timChannel);
   }
 
-  HAL_TIM_PWM_DeInit(&timHandle);
+  /* Other channels of the timer could still be in use */
+  TimerRelease(timHandle.Instance, TIMER_USED_PWM);
+  if (getTimerUser(timHandle.Instance) == TIMER_FREE) {
+    HAL_TIM_PWM_DeInit(&timHandle);
+  }
 }
 
 
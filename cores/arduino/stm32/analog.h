@@ -48,13 +48,35 @@
 #endif
 
 /* Exported types ------------------------------------------------------------*/
+/* Waveforms of dac_wave_start() */
+typedef enum {
+  DAC_SINE_WAVE,      // table played by DMA
+  DAC_TRIANGLE_WAVE,  // DAC triangle generator
+  DAC_NOISE_WAVE,     // DAC pseudo random generator
+} dacWave_t;
+
+/* Fills count samples of a stream buffer, called from the DMA interrupt */
+typedef void (*dacStreamCallback_t)(uint16_t *samples, uint32_t count);
+
 /* Exported constants --------------------------------------------------------*/
+/* DAC streams need a DMA request mapping, see analog.c */
+#if defined(HAL_DAC_MODULE_ENABLED) && defined(HAL_DMA_MODULE_ENABLED) &&\
+   (defined(STM32F2xx) || defined(STM32F3xx) || defined(STM32F4xx) ||\
+    defined(STM32F7xx) || defined(STM32L0xx) || defined(STM32L1xx) ||\
+    defined(STM32L4xx))
+#define DAC_DMA_STREAM
+#endif
+
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
 void dac_write_value(PinName pin, uint32_t value, uint8_t do_init);
 void dac_stop(PinName pin);
+uint8_t dac_stream_start(PinName pin, uint16_t *buffer, uint32_t length, uint32_t sampleRate, uint8_t circular, dacStreamCallback_t refill);
+uint8_t dac_wave_start(PinName pin, dacWave_t wave, uint32_t frequency, uint32_t amplitude);
+void dac_stream_stop(PinName pin);
+uint8_t dac_stream_busy(PinName pin);
 uint16_t adc_read_value(PinName pin);
-void pwm_start(PinName pin, uint32_t clock_freq, uint32_t period, uint32_t value, uint8_t do_init);
+uint8_t pwm_start(PinName pin, uint32_t clock_freq, uint32_t period, uint32_t value, uint8_t do_init);
 void pwm_stop(PinName pin);
 
 #ifdef __cplusplus
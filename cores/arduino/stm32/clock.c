@@ -47,6 +47,7 @@
   * @{
   */
 #include "stm32_def.h"
+#include "clock.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -83,6 +84,16 @@
 /** @addtogroup STM32F4xx_System_Private_Variables
   * @{
   */
+/* Upper 32 bits of the millisecond counter (HAL tick) */
+static volatile uint32_t tickMilliHigh = 0;
+#ifdef CLOCK_DWT_CYCCNT
+/* DWT cycle counter value at the last SysTick reload */
+static volatile uint32_t tickCycles = 0;
+#endif
+/* HCLK cycles per microsecond */
+static uint32_t cyclesPerMicro = 1;
+/* HAL tick counter, see stm32yyxx_hal.c */
+extern __IO uint32_t uwTick;
 
 /**
   * @}
@@ -96,6 +107,63 @@
   * @}
   */
 
+/**
+  * @brief  Initialize the time base used by micros() once the system clock
+  *         is configured. Must be called again if the clock is changed.
+  *         On Cortex-M3/M4/M7 the DWT cycle counter is enabled.
+  * @param  None
+  * @retval None
+  */
+void TimeBaseInit(void)
+{
+  /* SysTick is clocked by HCLK and reloaded every millisecond */
+  cyclesPerMicro = (SysTick->LOAD + 1) / 1000;
+  if(cyclesPerMicro == 0) {
+    cyclesPerMicro = 1;
+  }
+#ifdef CLOCK_DWT_CYCCNT
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if (__CORTEX_M == 0x07U)
+  /* Unlock DWT registers */
+  DWT->LAR = 0xC5ACCE55;
+#endif
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+  tickCycles = DWT->CYCCNT - (SysTick->LOAD - SysTick->VAL);
+#endif
+}
+
+/**
+  * @brief  Return a coherent snapshot of the time base
+  * @param  ms: current millisecond (lower 32 bits)
+  * @param  msHigh: upper 32 bits of the millisecond counter
+  * @retval HCLK cycles elapsed since the millisecond started
+  */
+static inline uint32_t GetTimeBase(uint32_t *ms, uint32_t *msHigh)
+{
+  uint32_t cycles;
+  uint32_t m;
+
+  do {
+    m = HAL_GetTick();
+    *msHigh = tickMilliHigh;
+#ifdef CLOCK_DWT_CYCCNT
+    cycles = DWT->CYCCNT - tickCycles;
+#else
+    uint32_t load = SysTick->LOAD;
+    uint32_t val = SysTick->VAL;
+    cycles = load - val;
+    /* Reload occurred but SysTick_Handler not yet served */
+    if((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) && (val > (load >> 1))) {
+      cycles += load + 1;
+    }
+#endif
+  } while(m != HAL_GetTick());
+
+  *ms = m;
+  return cycles;
+}
+
 /**
   * @brief  Function called to read the current micro second
   * @param  None
@@ -103,16 +171,204 @@
   */
 uint32_t GetCurrentMicro(void)
 {
-  uint32_t m0 = HAL_GetTick();
-  uint32_t u0 = SysTick->LOAD - SysTick->VAL;
-  uint32_t m1 = HAL_GetTick();
-  uint32_t u1 = SysTick->LOAD - SysTick->VAL;
+  uint32_t ms, msHigh;
+  uint32_t cycles = GetTimeBase(&ms, &msHigh);
+
+  return (ms * 1000) + (cycles / cyclesPerMicro);
+}
+
+/**
+  * @brief  Function called to read the current micro second on 64 bits
+  * @param  None
+  * @retval Microseconds since startup, never wraps
+  */
+uint64_t GetCurrentMicro64(void)
+{
+  uint32_t ms, msHigh;
+  uint32_t cycles = GetTimeBase(&ms, &msHigh);
+
+  return ((((uint64_t)msHigh << 32) | ms) * 1000) + (cycles / cyclesPerMicro);
+}
 
-  if (m1 > m0) {
-    return ( m1 * 1000 + (u1 * 1000) / SysTick->LOAD);
+/**
+  * @brief  Function called to read the current nano second
+  * @param  None
+  * @retval Nanoseconds since startup, resolution is one HCLK cycle
+  */
+uint64_t GetCurrentNano(void)
+{
+  uint32_t ms, msHigh;
+  uint32_t cycles = GetTimeBase(&ms, &msHigh);
+  uint64_t ns = (((uint64_t)msHigh << 32) | ms) * 1000000;
+
+  if(cycles < (0xFFFFFFFFU / 1000)) {
+    ns += (cycles * 1000) / cyclesPerMicro;
   } else {
-    return ( m0 * 1000 + (u0 * 1000) / SysTick->LOAD);
+    ns += ((uint64_t)cycles * 1000) / cyclesPerMicro;
   }
+  return ns;
+}
+
+/**
+  * @brief  Function called to read the cycle counter. With DWT this is the
+  *         core cycle counter, which does not count while the core sleeps.
+  * @param  None
+  * @retval Cycle counter, wraps on 32 bits
+  */
+uint32_t GetCurrentCycle(void)
+{
+#ifdef CLOCK_DWT_CYCCNT
+  return DWT->CYCCNT;
+#else
+  uint32_t ms, msHigh;
+  uint32_t cycles = GetTimeBase(&ms, &msHigh);
+
+  return (ms * (SysTick->LOAD + 1)) + cycles;
+#endif
+}
+
+/**
+  * @brief  Re-align the cycle counter on the SysTick phase. Required after
+  *         the core slept: the DWT cycle counter stops in sleep mode.
+  *         Must be called with interrupts disabled.
+  * @param  None
+  * @retval None
+  */
+static inline void TimeBaseResync(void)
+{
+#ifdef CLOCK_DWT_CYCCNT
+  uint32_t cycles = SysTick->LOAD - SysTick->VAL;
+
+  /* Reload occurred but SysTick_Handler not yet served */
+  if(SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) {
+    cycles += SysTick->LOAD + 1;
+  }
+  tickCycles = DWT->CYCCNT - cycles;
+#endif
+}
+
+/**
+  * @brief  Add milliseconds elapsed while the SysTick interrupt was off
+  * @param  ms: number of milliseconds
+  * @retval None
+  */
+static inline void TimeBaseAddMilli(uint32_t ms)
+{
+  uint32_t tick = uwTick;
+
+  uwTick = tick + ms;
+  if(uwTick < tick) {
+    tickMilliHigh++;
+  }
+}
+
+/**
+  * @brief  Enter sleep mode until the next interrupt (at least the next
+  *         SysTick), keeping micros() coherent on wakeup.
+  * @param  None
+  * @retval None
+  */
+void TimeBaseIdle(void)
+{
+  uint32_t primask = __get_PRIMASK();
+
+  /* Wakeup interrupt is served once the time base is re-aligned */
+  __disable_irq();
+  __DSB();
+  __WFI();
+  TimeBaseResync();
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Tickless idle: SysTick is reprogrammed to fire only at the
+  *         deadline, then the core sleeps until it or another interrupt
+  *         wakes it up. Milliseconds elapsed are added to the tick.
+  *         SysTick keeps counting from HCLK in sleep mode so no time is lost.
+  * @param  ms: number of milliseconds to sleep at most
+  * @retval None
+  */
+void TimeBaseTicklessIdle(uint32_t ms)
+{
+  uint32_t primask;
+  uint32_t reload = SysTick->LOAD + 1;
+  uint32_t remaining, sleepLoad, elapsed, ticks, ctrl;
+
+  /* 24 bits SysTick counter limits the sleep duration */
+  if(ms > (SysTick_LOAD_RELOAD_Msk / reload)) {
+    ms = SysTick_LOAD_RELOAD_Msk / reload;
+  }
+  if(ms < 2) {
+    TimeBaseIdle();
+    return;
+  }
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+
+  SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+  if(SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) {
+    /* Tick to serve first */
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    __set_PRIMASK(primask);
+    return;
+  }
+  /* Cycles left in the current millisecond */
+  remaining = SysTick->VAL;
+  if(remaining == 0) {
+    remaining = reload;
+  }
+  sleepLoad = remaining + ((ms - 1) * reload) - 1;
+  SysTick->LOAD = sleepLoad;
+  SysTick->VAL = 0;
+  SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+  __DSB();
+  __WFI();
+
+  ctrl = SysTick->CTRL;
+  SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_Msk;
+  if(ctrl & SysTick_CTRL_COUNTFLAG_Msk) {
+    /* Deadline reached: counter reloaded with sleepLoad */
+    elapsed = sleepLoad + 1 + (sleepLoad - SysTick->VAL);
+    SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
+  } else {
+    /* Woken up earlier by another interrupt */
+    elapsed = sleepLoad - SysTick->VAL;
+  }
+
+  /* Elapsed milliseconds and cycles left until the next one */
+  if(elapsed < remaining) {
+    ticks = 0;
+    remaining -= elapsed;
+  } else {
+    elapsed -= remaining;
+    ticks = 1 + (elapsed / reload);
+    remaining = reload - (elapsed % reload);
+  }
+  TimeBaseAddMilli(ticks);
+
+  /* Restart SysTick on the same phase, then back to a 1 ms period */
+  SysTick->LOAD = remaining - 1;
+  SysTick->VAL = 0;
+  SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+  SysTick->LOAD = reload - 1;
+
+  TimeBaseResync();
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Restore the time base after stop mode, where SysTick and the core
+  *         clocks are off. Must be called with interrupts disabled, once the
+  *         system clock is configured again.
+  * @param  ms: number of milliseconds spent in stop mode
+  * @retval None
+  */
+void TimeBaseResume(uint32_t ms)
+{
+  TimeBaseAddMilli(ms);
+  TimeBaseResync();
 }
 
 /**
@@ -132,7 +388,40 @@ uint32_t GetCurrentMilli(void)
   */
 void SysTick_Handler(void)
 {
+#ifdef CLOCK_DWT_CYCCNT
+  uint32_t period = SysTick->LOAD + 1;
+  uint32_t pending;
+  int32_t elapsed;
+#endif
+
   HAL_IncTick();
+  if(HAL_GetTick() == 0) {
+    tickMilliHigh++;
+  }
+#ifdef CLOCK_DWT_CYCCNT
+  /* The millisecond starts one period after the previous one, not when the
+     interrupt is served: the cycles counted while it was masked stay in
+     micros(), which does not go back. The periods missed meanwhile are added
+     to the tick, but the last one if it is pending: it is served next. */
+  tickCycles += period;
+  do {
+    pending = SCB->ICSR & SCB_ICSR_PENDSTSET_Msk;
+    elapsed = (int32_t)(DWT->CYCCNT - tickCycles);
+  } while(pending != (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk));
+  if(elapsed < 0) {
+    /* Cycle counter stopped by a sleep out of TimeBaseIdle() */
+    TimeBaseResync();
+  } else {
+    if(pending) {
+      elapsed -= period;
+    }
+    while(elapsed >= (int32_t)period) {
+      TimeBaseAddMilli(1);
+      tickCycles += period;
+      elapsed -= period;
+    }
+  }
+#endif
   HAL_SYSTICK_IRQHandler();
 }
 
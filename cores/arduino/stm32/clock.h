@@ -48,10 +48,22 @@
 
 /* Exported types ------------------------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
+#if (__CORTEX_M >= 0x03U)
+/* Cortex-M3/M4/M7: time base uses the DWT cycle counter */
+#define CLOCK_DWT_CYCCNT
+#endif
+
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
+void TimeBaseInit(void);
 uint32_t GetCurrentMilli(void);
 uint32_t GetCurrentMicro(void);
+uint64_t GetCurrentMicro64(void);
+uint64_t GetCurrentNano(void);
+uint32_t GetCurrentCycle(void);
+void TimeBaseIdle(void);
+void TimeBaseTicklessIdle(uint32_t ms);
+void TimeBaseResume(uint32_t ms);
 void delayInsideIT(uint32_t delay_us);
 
 #ifdef __cplusplus
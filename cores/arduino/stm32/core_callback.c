@@ -37,11 +37,19 @@
 
 /*
  * @NOTE
- * This file provides methods to add callback in the main() function loop.
- * If you need to call as often as possible a function to update your system and
- * you want to be sure this function to be called, you can add it to the callback
- * list. Otherwise, your function should be called inside the loop() function of
- * the sketch.
+ * This file provides a cooperative scheduler for the background work of the
+ * core and of the libraries. A task is a function called from the main()
+ * function loop and from yield() (so during delay()) when it is due:
+ * - period 0: called at each pass, as the callbacks of the previous
+ *   versions added with registerCoreCallback(). They do not keep delay()
+ *   from sleeping: they are called again once an interrupt wakes it up,
+ * - period n: called every n milliseconds. A late task is called once and
+ *   rescheduled from the current time, missed periods are not replayed.
+ * Due tasks are called by decreasing priority. The tasks are kept in a
+ * min-heap ordered by next run time, so a pass only looks at the due ones,
+ * the tasks of period 0 are out of it. delay() sleeps until the next
+ * periodic task is due (see CoreTaskNextDue()).
+ * Tasks must return quickly: there is no preemption.
  */
 #if defined(CORE_CALLBACK)
 #ifdef __cplusplus
@@ -51,25 +59,203 @@
 /* Includes ------------------------------------------------------------------*/
 #include "core_callback.h"
 
-// List of callback to call
-static void (*callbackList[CALLBACK_LIST_SIZE])(void);
+typedef struct {
+  void (*func)(void);
+  uint32_t period;
+  uint32_t next;          // next run time, in ms
+  uint8_t priority;
+  uint8_t heapIndex;      // position in taskHeap, CALLBACK_LIST_SIZE if not in
+  volatile uint8_t pending;
+} coreTask_t;
+
+static coreTask_t taskList[CALLBACK_LIST_SIZE];
+// Indexes in taskList, taskHeap[0] is the next task to run
+static uint8_t taskHeap[CALLBACK_LIST_SIZE];
+static uint8_t taskHeapSize = 0;
+static uint8_t taskRunning = 0;
 
 /**
-  * @brief  Adds a callback pointer
-  * @param  func: callback pointer
+  * @brief  Order of two tasks in the heap, times compared modulo 2^32
+  * @param  a: index of the first task
+  * @param  b: index of the second task
+  * @retval 1 if a runs before b
+  */
+static uint8_t CoreTaskBefore(uint8_t a, uint8_t b)
+{
+  int32_t diff = (int32_t)(taskList[a].next - taskList[b].next);
+
+  return (diff < 0) || ((diff == 0) && (taskList[a].priority > taskList[b].priority));
+}
+
+static void CoreTaskHeapSet(uint8_t pos, uint8_t task)
+{
+  taskHeap[pos] = task;
+  taskList[task].heapIndex = pos;
+}
+
+/**
+  * @brief  Move an element of the heap to its place
+  * @param  pos: position of the element
   * @retval None
   */
-void registerCoreCallback(void (*func)(void))
+static void CoreTaskHeapFix(uint8_t pos)
 {
-  if(func == NULL)
+  uint8_t task = taskHeap[pos];
+  uint8_t child;
+
+  // Up
+  while((pos > 0) && CoreTaskBefore(task, taskHeap[(pos - 1) / 2])) {
+    CoreTaskHeapSet(pos, taskHeap[(pos - 1) / 2]);
+    pos = (pos - 1) / 2;
+  }
+  // Down
+  while((child = 2 * pos + 1) < taskHeapSize) {
+    if((child + 1 < taskHeapSize) && CoreTaskBefore(taskHeap[child + 1], taskHeap[child])) {
+      child++;
+    }
+    if(!CoreTaskBefore(taskHeap[child], task)) {
+      break;
+    }
+    CoreTaskHeapSet(pos, taskHeap[child]);
+    pos = child;
+  }
+  CoreTaskHeapSet(pos, task);
+}
+
+static void CoreTaskHeapPush(uint8_t task)
+{
+  CoreTaskHeapSet(taskHeapSize, task);
+  taskHeapSize++;
+  CoreTaskHeapFix(taskHeapSize - 1);
+}
+
+static void CoreTaskHeapRemove(uint8_t task)
+{
+  uint8_t pos = taskList[task].heapIndex;
+
+  if(pos >= taskHeapSize) {
     return;
+  }
+  taskList[task].heapIndex = CALLBACK_LIST_SIZE;
+  taskHeapSize--;
+  if(pos < taskHeapSize) {
+    CoreTaskHeapSet(pos, taskHeap[taskHeapSize]);
+    CoreTaskHeapFix(pos);
+  }
+}
+
+/**
+  * @brief  Inserts a task in a list sorted by decreasing priority
+  * @param  list: tasks list
+  * @param  size: number of tasks in the list
+  * @param  task: index of the task to insert
+  * @retval None
+  */
+static void CoreTaskSortIn(uint8_t *list, uint8_t size, uint8_t task)
+{
+  uint8_t i;
 
+  for(i = size; (i > 0) && (taskList[list[i - 1]].priority < taskList[task].priority); i--) {
+    list[i] = list[i - 1];
+  }
+  list[i] = task;
+}
+
+static int CoreTaskFind(void (*func)(void))
+{
   for(uint8_t i = 0; i < CALLBACK_LIST_SIZE; i++) {
-    if(callbackList[i] == NULL) {
-      callbackList[i] = func;
-      break;
+    if(taskList[i].func == func) {
+      return i;
     }
   }
+  return -1;
+}
+
+/**
+  * @brief  Adds a task, or changes its period and priority if it is
+  *         already registered. The first call is done at the next pass.
+  * @param  func: task function
+  * @param  period: in milliseconds, 0 to be called at each pass
+  * @param  priority: due tasks are called by decreasing priority
+  * @retval 1 if done, 0 if the list is full
+  */
+uint8_t registerCoreTask(void (*func)(void), uint32_t period, uint8_t priority)
+{
+  int task;
+
+  if(func == NULL)
+    return 0;
+
+  task = CoreTaskFind(func);
+  if(task < 0) {
+    task = CoreTaskFind(NULL);
+    if(task < 0) {
+      return 0;
+    }
+    taskList[task].func = func;
+    taskList[task].pending = 0;
+    taskList[task].heapIndex = CALLBACK_LIST_SIZE;
+  }
+  taskList[task].period = period;
+  taskList[task].priority = priority;
+  taskList[task].next = HAL_GetTick();
+  if(period == 0) {
+    CoreTaskHeapRemove(task);
+  } else if(taskList[task].heapIndex < taskHeapSize) {
+    CoreTaskHeapFix(taskList[task].heapIndex);
+  } else if(!taskRunning) {
+    CoreTaskHeapPush(task);
+  }
+  // else: added to the heap at the end of the current pass
+  return 1;
+}
+
+/**
+  * @brief  Removes a task, could be called from the task itself
+  * @param  func: task function
+  * @retval None
+  */
+void unregisterCoreTask(void (*func)(void))
+{
+  int task;
+
+  if(func == NULL)
+    return;
+
+  task = CoreTaskFind(func);
+  if(task >= 0) {
+    CoreTaskHeapRemove(task);
+    taskList[task].func = NULL;
+  }
+}
+
+/**
+  * @brief  Requests a task to run at the next pass, whatever its period.
+  *         Could be called from an interrupt handler.
+  * @param  func: task function
+  * @retval None
+  */
+void wakeCoreTask(void (*func)(void))
+{
+  int task;
+
+  if(func == NULL)
+    return;
+
+  task = CoreTaskFind(func);
+  if(task >= 0) {
+    taskList[task].pending = 1;
+  }
+}
+
+/**
+  * @brief  Adds a callback called at each pass, with the default priority
+  * @param  func: callback pointer
+  * @retval None
+  */
+void registerCoreCallback(void (*func)(void))
+{
+  registerCoreTask(func, 0, CORE_TASK_PRIORITY_DEFAULT);
 }
 
 /**
@@ -79,29 +265,98 @@ void registerCoreCallback(void (*func)(void))
   */
 void unregisterCoreCallback(void (*func)(void))
 {
-  if(func == NULL)
-    return;
+  unregisterCoreTask(func);
+}
+
+/**
+  * @brief  Time until the next task is due, the tasks of period 0 apart
+  * @param  None
+  * @retval milliseconds, 0 if a task is due, 0xFFFFFFFF if there is no task
+  */
+uint32_t CoreTaskNextDue(void)
+{
+  int32_t wait;
 
   for(uint8_t i = 0; i < CALLBACK_LIST_SIZE; i++) {
-    if(callbackList[i] == func) {
-      callbackList[i] = NULL;
-      break;
+    if((taskList[i].func != NULL) && taskList[i].pending) {
+      return 0;
     }
   }
+  if(taskHeapSize == 0) {
+    return 0xFFFFFFFF;
+  }
+  wait = (int32_t)(taskList[taskHeap[0]].next - HAL_GetTick());
+  return (wait > 0) ? (uint32_t)wait : 0;
 }
 
 /**
-  * @brief  Calls callback of the list. There is no priority. First added first
-  *         called. This function must be called only in main() function loop.
+  * @brief  Calls the due tasks by decreasing priority. Called from the
+  *         main() function loop and from yield(), the calls from a task
+  *         (through delay() for example) are ignored.
   * @param  None
   * @retval None
   */
 void CoreCallback(void)
 {
-  for(uint8_t i = 0; i < CALLBACK_LIST_SIZE; i++) {
-    if(callbackList[i] != NULL)
-      callbackList[i]();
+  uint8_t due[CALLBACK_LIST_SIZE];
+  uint8_t nbDue = 0;
+  uint32_t now;
+  uint8_t i, task;
+
+  if(taskRunning) {
+    return;
+  }
+  taskRunning = 1;
+  now = HAL_GetTick();
+
+  // Woken up tasks
+  for(i = 0; i < CALLBACK_LIST_SIZE; i++) {
+    if((taskList[i].func != NULL) && taskList[i].pending) {
+      taskList[i].pending = 0;
+      if(taskList[i].heapIndex < taskHeapSize) {
+        taskList[i].next = now;
+        CoreTaskHeapFix(taskList[i].heapIndex);
+      }
+    }
+  }
+  // Due tasks and tasks of period 0, sorted by decreasing priority
+  while((taskHeapSize > 0) && ((int32_t)(now - taskList[taskHeap[0]].next) >= 0)) {
+    task = taskHeap[0];
+    CoreTaskHeapRemove(task);
+    CoreTaskSortIn(due, nbDue++, task);
+  }
+  for(i = 0; i < CALLBACK_LIST_SIZE; i++) {
+    if((taskList[i].func != NULL) && (taskList[i].period == 0)) {
+      CoreTaskSortIn(due, nbDue++, i);
+    }
+  }
+
+  for(i = 0; i < nbDue; i++) {
+    if(taskList[due[i]].func != NULL) {
+      taskList[due[i]].func();
+    }
+  }
+
+  now = HAL_GetTick();
+  for(i = 0; i < nbDue; i++) {
+    task = due[i];
+    if((taskList[task].func == NULL) || (taskList[task].period == 0) ||
+       (taskList[task].heapIndex < taskHeapSize)) {
+      continue;
+    }
+    taskList[task].next += taskList[task].period;
+    if((int32_t)(now - taskList[task].next) >= 0) {
+      taskList[task].next = now + taskList[task].period;
+    }
+  }
+  // Run or registered during the pass
+  for(i = 0; i < CALLBACK_LIST_SIZE; i++) {
+    if((taskList[i].func != NULL) && (taskList[i].period != 0) &&
+       (taskList[i].heapIndex >= taskHeapSize)) {
+      CoreTaskHeapPush(i);
+    }
   }
+  taskRunning = 0;
 }
 
 #ifdef __cplusplus
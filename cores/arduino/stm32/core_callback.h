@@ -40,6 +40,7 @@
 #define __CALLBACK_H
 #if defined(CORE_CALLBACK)
 #include "variant.h"
+#include "stm32_def.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -50,10 +51,19 @@
 /* Exported constants --------------------------------------------------------*/
 /* Exported macro ------------------------------------------------------------*/
 #ifndef CALLBACK_LIST_SIZE
-#define CALLBACK_LIST_SIZE  4
+#define CALLBACK_LIST_SIZE  8
 #endif
 
+#define CORE_TASK_PRIORITY_LOW      0
+#define CORE_TASK_PRIORITY_DEFAULT  1
+#define CORE_TASK_PRIORITY_HIGH     2
+
 /* Exported functions ------------------------------------------------------- */
+uint8_t registerCoreTask(void (*func)(void), uint32_t period, uint8_t priority);
+void unregisterCoreTask(void (*func)(void));
+void wakeCoreTask(void (*func)(void));
+uint32_t CoreTaskNextDue(void);
+
 void registerCoreCallback(void (*func)(void));
 void unregisterCoreCallback(void (*func)(void));
 void CoreCallback(void);
@@ -94,6 +94,40 @@ uint32_t digital_io_read(GPIO_TypeDef  *port, uint32_t pin)
   return (uint32_t)HAL_GPIO_ReadPin(port, pin);
 }
 
+/**
+  * @brief  This function returns the pull-up/down of an IO, as set by
+  *         digital_io_init()
+  * @param  pin : pin name
+  * @retval GPIO_NOPULL, GPIO_PULLUP or GPIO_PULLDOWN
+  */
+uint32_t digital_io_get_pull(PinName pin)
+{
+  GPIO_TypeDef *port = get_GPIO_Port(STM_PORT(pin));
+  uint32_t position = STM_PIN(pin);
+
+  if(port == NULL) {
+    return GPIO_NOPULL;
+  }
+#ifdef STM32F1xx
+  /* Pull-up/down only in input mode with CNF 10, its direction is in ODR */
+  uint32_t config = (position < 8) ? port->CRL : port->CRH;
+
+  if(((config >> ((position & 7) * 4)) & 0xF) != 0x8) {
+    return GPIO_NOPULL;
+  }
+  return (port->ODR & (1U << position)) ? GPIO_PULLUP : GPIO_PULLDOWN;
+#else
+  switch((port->PUPDR >> (position * 2)) & 0x3) {
+    case 0x1:
+      return GPIO_PULLUP;
+    case 0x2:
+      return GPIO_PULLDOWN;
+    default:
+      return GPIO_NOPULL;
+  }
+#endif /* STM32F1xx */
+}
+
 #ifdef __cplusplus
 }
 #endif
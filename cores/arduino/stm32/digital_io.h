@@ -54,6 +54,7 @@
 void digital_io_init(PinName pin, uint32_t mode, uint32_t pull);
 void digital_io_write(GPIO_TypeDef  *port, uint32_t pin, uint32_t val);
 uint32_t digital_io_read(GPIO_TypeDef  *port, uint32_t pin);
+uint32_t digital_io_get_pull(PinName pin);
 
 #ifdef __cplusplus
 }
@@ -48,6 +48,7 @@
   */
 #include "stm32_def.h"
 #include "hw_config.h"
+#include "clock.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -112,6 +113,9 @@ void hw_config_init(void)
 
   // Configure the system clock
   SystemClock_Config();
+
+  // Initialize the time base used by micros()
+  TimeBaseInit();
 }
 
 /******************************************************************************/
@@ -0,0 +1,358 @@
+/**
+  ******************************************************************************
+  * @file    low_power.c
+  * @author  WI6LABS
+  * @version V1.0.0
+  * @date    12-December-2017
+  * @brief   provide the low power interface (sleep, stop, standby)
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+  *
+  * Redistribution and use in source and binary forms, with or without modification,
+  * are permitted provided that the following conditions are met:
+  *   1. Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *   2. Redistributions in binary form must reproduce the above copyright notice,
+  *      this list of conditions and the following disclaimer in the documentation
+  *      and/or other materials provided with the distribution.
+  *   3. Neither the name of STMicroelectronics nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  ******************************************************************************
+  */
+/** @addtogroup CMSIS
+  * @{
+  */
+
+/** @addtogroup stm32f4xx_system
+  * @{
+  */
+
+/** @addtogroup STM32F4xx_System_Private_Includes
+  * @{
+  */
+#include "low_power.h"
+#include "clock.h"
+#include "rtc.h"
+#include "uart.h"
+
+#if defined(HAL_PWR_MODULE_ENABLED)
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+  * @}
+  */
+
+/** @addtogroup STM32F4xx_System_Private_Defines
+  * @{
+  */
+#define MS_PER_DAY  (24UL * 60 * 60 * 1000)
+
+/**
+  * @}
+  */
+
+/** @addtogroup STM32F4xx_System_Private_Variables
+  * @{
+  */
+/* Wakeup pins enabled for standby/shutdown */
+static uint32_t wakeUpPins = 0;
+
+/**
+  * @}
+  */
+
+/**
+  * @brief  Clear the wakeup flags
+  * @param  None
+  * @retval None
+  */
+static inline void LowPower_ClearWakeUpFlags(void)
+{
+#if defined(STM32F7xx)
+  __HAL_PWR_CLEAR_WAKEUP_FLAG(PWR_WAKEUP_PIN_FLAG1 | PWR_WAKEUP_PIN_FLAG2 |
+                              PWR_WAKEUP_PIN_FLAG3 | PWR_WAKEUP_PIN_FLAG4 |
+                              PWR_WAKEUP_PIN_FLAG5 | PWR_WAKEUP_PIN_FLAG6);
+#else
+  __HAL_PWR_CLEAR_FLAG(PWR_FLAG_WU);
+#endif
+}
+
+/**
+  * @brief  Low power initialization: clear the wakeup flags left by a
+  *         previous standby and start the RTC used to wake up from stop
+  *         and standby modes (LSE, or LSI if there is no crystal).
+  * @param  None
+  * @retval None
+  */
+void LowPower_init(void)
+{
+  __HAL_RCC_PWR_CLK_ENABLE();
+  HAL_PWR_EnableBkUpAccess();
+
+#if defined(STM32L0xx) || defined(STM32L1xx)
+  /* Vrefint off in stop/standby, do not wait for it on wakeup */
+  HAL_PWREx_EnableUltraLowPower();
+  HAL_PWREx_EnableFastWakeUp();
+#endif
+
+#ifdef RTC_WAKEUP_TIMER_SUPPORT
+  RTC_init(LSE_CLOCK);
+#endif
+
+  __HAL_PWR_CLEAR_FLAG(PWR_FLAG_SB);
+  LowPower_ClearWakeUpFlags();
+}
+
+/**
+  * @brief  Return the PWR wakeup pin connected to a GPIO
+  * @param  pin: pin name
+  * @param  mode: GPIO_MODE_IT_RISING or GPIO_MODE_IT_FALLING, only used by
+  *         the series with a programmable wakeup pin polarity
+  * @retval PWR_WAKEUP_PINx, 0 if the GPIO is not a wakeup pin
+  */
+static uint32_t LowPower_GetWakeUpPin(PinName pin, uint32_t mode)
+{
+  uint32_t wkup = 0;
+
+#if defined(STM32L4xx) || defined(STM32F7xx)
+  uint8_t low = (mode == GPIO_MODE_IT_FALLING);
+#else
+  UNUSED(mode);
+#endif
+
+  switch(pin) {
+#if defined(STM32L4xx)
+    case PA_0:  wkup = low ? PWR_WAKEUP_PIN1_LOW : PWR_WAKEUP_PIN1_HIGH; break;
+    case PC_13: wkup = low ? PWR_WAKEUP_PIN2_LOW : PWR_WAKEUP_PIN2_HIGH; break;
+    case PE_6:  wkup = low ? PWR_WAKEUP_PIN3_LOW : PWR_WAKEUP_PIN3_HIGH; break;
+    case PA_2:  wkup = low ? PWR_WAKEUP_PIN4_LOW : PWR_WAKEUP_PIN4_HIGH; break;
+    case PC_5:  wkup = low ? PWR_WAKEUP_PIN5_LOW : PWR_WAKEUP_PIN5_HIGH; break;
+#elif defined(STM32F7xx)
+    case PA_0:  wkup = low ? PWR_WAKEUP_PIN1_LOW : PWR_WAKEUP_PIN1_HIGH; break;
+    case PA_2:  wkup = low ? PWR_WAKEUP_PIN2_LOW : PWR_WAKEUP_PIN2_HIGH; break;
+    case PC_1:  wkup = low ? PWR_WAKEUP_PIN3_LOW : PWR_WAKEUP_PIN3_HIGH; break;
+    case PC_13: wkup = low ? PWR_WAKEUP_PIN4_LOW : PWR_WAKEUP_PIN4_HIGH; break;
+    case PI_8:  wkup = low ? PWR_WAKEUP_PIN5_LOW : PWR_WAKEUP_PIN5_HIGH; break;
+    case PI_11: wkup = low ? PWR_WAKEUP_PIN6_LOW : PWR_WAKEUP_PIN6_HIGH; break;
+#else
+    /* Rising edge only */
+    case PA_0:  wkup = PWR_WAKEUP_PIN1; break;
+#if defined(STM32F0xx) || defined(STM32F3xx) || defined(STM32L0xx) || defined(STM32L1xx)
+    case PC_13: wkup = PWR_WAKEUP_PIN2; break;
+#endif
+#if (defined(STM32F3xx) || defined(STM32L1xx)) && defined(PWR_WAKEUP_PIN3)
+    case PE_6:  wkup = PWR_WAKEUP_PIN3; break;
+#endif
+#endif
+    default:
+      break;
+  }
+  return wkup;
+}
+
+/**
+  * @brief  Enable a GPIO as wakeup source from standby/shutdown. From sleep
+  *         and stop modes any EXTI interrupt wakes up the device.
+  * @param  pin: pin name
+  * @param  mode: GPIO_MODE_IT_RISING or GPIO_MODE_IT_FALLING
+  * @retval 1 if the pin can wake up the device from standby, 0 otherwise
+  */
+uint8_t LowPower_EnableWakeUpPin(PinName pin, uint32_t mode)
+{
+  uint32_t wkup = LowPower_GetWakeUpPin(pin, mode);
+
+  if(wkup == 0) {
+    return 0;
+  }
+  wakeUpPins |= wkup;
+  return 1;
+}
+
+/**
+  * @brief  Disable all wakeup pins
+  * @param  None
+  * @retval None
+  */
+void LowPower_DisableWakeUpPins(void)
+{
+  wakeUpPins = 0;
+}
+
+/**
+  * @brief  Check if the reset was a wakeup from standby/shutdown. The flag
+  *         is cleared by LowPower_init().
+  * @param  None
+  * @retval 1 if woken up from standby, 0 otherwise
+  */
+uint8_t LowPower_WakeUpFromStandby(void)
+{
+  return (__HAL_PWR_GET_FLAG(PWR_FLAG_SB) != RESET);
+}
+
+#ifdef RTC_WAKEUP_TIMER_SUPPORT
+/**
+  * @brief  RTC time of day in milliseconds
+  * @param  None
+  * @retval milliseconds since midnight
+  */
+static uint32_t LowPower_GetRTCMilli(void)
+{
+  uint8_t hours, minutes, seconds;
+  uint32_t subSeconds;
+
+  RTC_GetTime(&hours, &minutes, &seconds, &subSeconds);
+  return ((((hours * 60UL) + minutes) * 60UL) + seconds) * 1000UL + subSeconds;
+}
+#endif
+
+/**
+  * @brief  Sleep mode: core clock stopped, peripherals and interrupts keep
+  *         running. SysTick only fires at the deadline.
+  * @param  ms: sleep duration, 0 to sleep until the next interrupt
+  * @retval None
+  */
+void LowPower_sleep(uint32_t ms)
+{
+  uint32_t start = HAL_GetTick();
+  uint32_t elapsed;
+
+  if(ms == 0) {
+    TimeBaseIdle();
+    return;
+  }
+  while((elapsed = (HAL_GetTick() - start)) < ms) {
+    TimeBaseTicklessIdle(ms - elapsed);
+  }
+}
+
+/**
+  * @brief  Stop mode (STOP2 on STM32L4): all clocks stopped, SRAM and
+  *         registers retained. The device wakes up on the RTC wakeup timer
+  *         or any EXTI interrupt. Pending UART transmissions are completed
+  *         first, then the system clock configuration and the time base are
+  *         restored on exit: UART, I2C and SPI keep their configuration.
+  *         Interrupts are served once the clocks are restored.
+  * @param  ms: maximum stop duration, 0 to wait for an EXTI interrupt.
+  *         Without RTC wakeup timer, sleep mode is used instead.
+  * @retval None
+  */
+void LowPower_stop(uint32_t ms)
+{
+  uint32_t primask;
+  uint32_t elapsed = 0;
+#ifdef RTC_WAKEUP_TIMER_SUPPORT
+  uint32_t start;
+#else
+  if(ms != 0) {
+    /* No RTC wakeup timer: sleep mode keeps the deadline */
+    LowPower_sleep(ms);
+    return;
+  }
+#endif
+
+  uart_flush_all();
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+#ifdef RTC_WAKEUP_TIMER_SUPPORT
+  if(ms != 0) {
+    RTC_StartWakeUpTimer(ms, NULL);
+  }
+  start = LowPower_GetRTCMilli();
+#endif
+
+  HAL_SuspendTick();
+  LowPower_ClearWakeUpFlags();
+#if defined(STM32L4xx)
+  HAL_PWREx_EnterSTOP2Mode(PWR_STOPENTRY_WFI);
+#else
+  HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+#endif
+
+  /* Woken up on HSI/MSI: back to the run clock configuration */
+  SystemClock_Config();
+
+#ifdef RTC_WAKEUP_TIMER_SUPPORT
+  elapsed = (LowPower_GetRTCMilli() + MS_PER_DAY - start) % MS_PER_DAY;
+  if(ms != 0) {
+    RTC_StopWakeUpTimer();
+  }
+#endif
+  TimeBaseResume(elapsed);
+  HAL_ResumeTick();
+
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Standby mode (shutdown on STM32L4 when the RTC is not needed or
+  *         runs from LSE): SRAM and registers are lost, the device resets
+  *         on wakeup by the RTC or an enabled wakeup pin.
+  * @param  ms: standby duration, 0 to wait for a wakeup pin. Ignored
+  *         without RTC wakeup timer.
+  * @retval None, does not return
+  */
+void LowPower_shutdown(uint32_t ms)
+{
+  uart_flush_all();
+
+  __disable_irq();
+#ifdef RTC_WAKEUP_TIMER_SUPPORT
+  if(ms != 0) {
+    RTC_StartWakeUpTimer(ms, NULL);
+  }
+#else
+  UNUSED(ms);
+#endif
+
+  /* Wakeup flags must be cleared after the wakeup pins are enabled */
+  if(wakeUpPins != 0) {
+    HAL_PWR_EnableWakeUpPin(wakeUpPins);
+  }
+  LowPower_ClearWakeUpFlags();
+
+#if defined(STM32L4xx) && defined(RTC_WAKEUP_TIMER_SUPPORT)
+  /* LSI is off in shutdown mode */
+  if((ms == 0) || (RTC_GetClockSource() == LSE_CLOCK)) {
+    HAL_PWREx_EnterSHUTDOWNMode();
+  }
+#endif
+  HAL_PWR_EnterSTANDBYMode();
+
+  while(1);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HAL_PWR_MODULE_ENABLED */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,296 @@
+/**
+  ******************************************************************************
+  * @file    mem_pool.c
+  * @brief   Fixed-block pool allocator
+  *
+  *          Small allocations are served from pools of fixed size blocks
+  *          configured in variant.h (see mem_pool.h), in constant time and
+  *          without fragmenting the heap. A pool is never scanned: the free
+  *          blocks are chained and the blocks never used yet are taken in
+  *          order, so no initialization is needed before the first
+  *          allocation (static constructors may run first).
+  *          Requests too big for the pools, or made when the pools are
+  *          empty, go to malloc.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+  *
+  * Redistribution and use in source and binary forms, with or without modification,
+  * are permitted provided that the following conditions are met:
+  *   1. Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *   2. Redistributions in binary form must reproduce the above copyright notice,
+  *      this list of conditions and the following disclaimer in the documentation
+  *      and/or other materials provided with the distribution.
+  *   3. Neither the name of STMicroelectronics nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "mem_pool.h"
+#include <string.h>
+
+#ifdef MEM_POOL_ENABLED
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Private defines -----------------------------------------------------------*/
+#if ((MEM_POOL_1_SIZE % 8) != 0) || (MEM_POOL_1_COUNT == 0)
+#error "MEM_POOL_1_SIZE must be a multiple of 8 and MEM_POOL_1_COUNT not null"
+#endif
+#if defined(MEM_POOL_2_SIZE)
+#if ((MEM_POOL_2_SIZE % 8) != 0) || (MEM_POOL_2_SIZE <= MEM_POOL_1_SIZE) || (MEM_POOL_2_COUNT == 0)
+#error "MEM_POOL_2_SIZE must be a multiple of 8 bigger than MEM_POOL_1_SIZE"
+#endif
+#endif
+#if defined(MEM_POOL_3_SIZE)
+#if ((MEM_POOL_3_SIZE % 8) != 0) || (MEM_POOL_3_SIZE <= MEM_POOL_2_SIZE) || (MEM_POOL_3_COUNT == 0)
+#error "MEM_POOL_3_SIZE must be a multiple of 8 bigger than MEM_POOL_2_SIZE"
+#endif
+#endif
+#if defined(MEM_POOL_4_SIZE)
+#if ((MEM_POOL_4_SIZE % 8) != 0) || (MEM_POOL_4_SIZE <= MEM_POOL_3_SIZE) || (MEM_POOL_4_COUNT == 0)
+#error "MEM_POOL_4_SIZE must be a multiple of 8 bigger than MEM_POOL_3_SIZE"
+#endif
+#endif
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct mem_block {
+  struct mem_block *next;
+} mem_block_t;
+
+typedef struct {
+  uint8_t *start;
+  uint8_t *end;
+  uint16_t blockSize;
+  uint16_t count;
+  uint8_t *unused;          /* first block never allocated */
+  mem_block_t *freeList;    /* blocks freed */
+  uint16_t used;
+  uint16_t usedMax;
+  uint32_t fallbacks;
+} mem_pool_t;
+
+/* Private variables ---------------------------------------------------------*/
+/* uint64_t for the alignment of the blocks */
+#define MEM_POOL_STORAGE(n) \
+  static uint64_t mem_pool_storage_##n[(MEM_POOL_##n##_SIZE * MEM_POOL_##n##_COUNT) / 8]
+#define MEM_POOL_INIT(n) \
+  { (uint8_t *)mem_pool_storage_##n, \
+    (uint8_t *)mem_pool_storage_##n + sizeof(mem_pool_storage_##n), \
+    MEM_POOL_##n##_SIZE, MEM_POOL_##n##_COUNT, \
+    (uint8_t *)mem_pool_storage_##n, NULL, 0, 0, 0 }
+
+MEM_POOL_STORAGE(1);
+#if MEM_POOL_NUM > 1
+MEM_POOL_STORAGE(2);
+#endif
+#if MEM_POOL_NUM > 2
+MEM_POOL_STORAGE(3);
+#endif
+#if MEM_POOL_NUM > 3
+MEM_POOL_STORAGE(4);
+#endif
+
+static mem_pool_t mem_pools[MEM_POOL_NUM] = {
+  MEM_POOL_INIT(1),
+#if MEM_POOL_NUM > 1
+  MEM_POOL_INIT(2),
+#endif
+#if MEM_POOL_NUM > 2
+  MEM_POOL_INIT(3),
+#endif
+#if MEM_POOL_NUM > 3
+  MEM_POOL_INIT(4),
+#endif
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Take a block of the smallest pool that fits and is not empty
+  * @param  size: bytes requested
+  * @retval block, NULL if none
+  */
+static void *mem_pool_take(size_t size)
+{
+  mem_pool_t *pool;
+  uint8_t *block = NULL;
+  uint32_t primask;
+  uint8_t fits = 0;
+  uint8_t i;
+
+  for(i = 0; i < MEM_POOL_NUM; i++) {
+    pool = &mem_pools[i];
+    if(size > pool->blockSize) {
+      continue;
+    }
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if(pool->freeList != NULL) {
+      block = (uint8_t *)pool->freeList;
+      pool->freeList = pool->freeList->next;
+    } else if(pool->unused < pool->end) {
+      block = pool->unused;
+      pool->unused += pool->blockSize;
+    } else if(!fits) {
+      pool->fallbacks++;
+    }
+    if(block != NULL) {
+      pool->used++;
+      if(pool->used > pool->usedMax) {
+        pool->usedMax = pool->used;
+      }
+    }
+    __set_PRIMASK(primask);
+    if(block != NULL) {
+      break;
+    }
+    fits = 1;
+  }
+  return block;
+}
+
+/**
+  * @brief  Pool owning a block
+  * @param  ptr: block
+  * @retval pool, NULL if ptr is not in a pool
+  */
+static mem_pool_t *mem_pool_find(void *ptr)
+{
+  uint8_t i;
+
+  for(i = 0; i < MEM_POOL_NUM; i++) {
+    if(((uint8_t *)ptr >= mem_pools[i].start) && ((uint8_t *)ptr < mem_pools[i].end)) {
+      return &mem_pools[i];
+    }
+  }
+  return NULL;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Allocate memory, from the pools or from the heap
+  * @param  size: bytes requested
+  * @retval pointer, NULL if there is no memory left
+  */
+void *mem_pool_alloc(size_t size)
+{
+  void *ptr = mem_pool_take(size);
+
+  if(ptr == NULL) {
+    ptr = malloc(size);
+  }
+  return ptr;
+}
+
+/**
+  * @brief  Allocate memory from the pools only, can be called in an interrupt
+  * @param  size: bytes requested
+  * @retval pointer, NULL if no pool block is available
+  */
+void *mem_pool_alloc_isr(size_t size)
+{
+  return mem_pool_take(size);
+}
+
+/**
+  * @brief  Resize an allocation. A pool block is kept while the size fits.
+  * @param  ptr: memory from mem_pool_alloc() or NULL
+  * @param  size: new size in bytes
+  * @retval new pointer, NULL if there is no memory left (ptr is kept)
+  */
+void *mem_pool_realloc(void *ptr, size_t size)
+{
+  mem_pool_t *pool;
+  void *newptr;
+
+  if(ptr == NULL) {
+    return mem_pool_alloc(size);
+  }
+  pool = mem_pool_find(ptr);
+  if(pool == NULL) {
+    return realloc(ptr, size);
+  }
+  if(size <= pool->blockSize) {
+    return ptr;
+  }
+  newptr = mem_pool_alloc(size);
+  if(newptr != NULL) {
+    memcpy(newptr, ptr, pool->blockSize);
+    mem_pool_free(ptr);
+  }
+  return newptr;
+}
+
+/**
+  * @brief  Release memory. Can be called in an interrupt for the memory from
+  *         mem_pool_alloc_isr().
+  * @param  ptr: memory from mem_pool_alloc(), mem_pool_alloc_isr() or NULL
+  * @retval none
+  */
+void mem_pool_free(void *ptr)
+{
+  mem_pool_t *pool;
+  uint32_t primask;
+
+  if(ptr == NULL) {
+    return;
+  }
+  pool = mem_pool_find(ptr);
+  if(pool == NULL) {
+    free(ptr);
+    return;
+  }
+  primask = __get_PRIMASK();
+  __disable_irq();
+  ((mem_block_t *)ptr)->next = pool->freeList;
+  pool->freeList = (mem_block_t *)ptr;
+  pool->used--;
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Usage of a pool
+  * @param  index: pool, 0 to MEM_POOL_NUM - 1
+  * @param  stats: filled with the current values
+  * @retval 1 if ok, 0 if index is not a pool
+  */
+uint8_t mem_pool_get_stats(uint8_t index, mem_pool_stats_t *stats)
+{
+  if(index >= MEM_POOL_NUM) {
+    return 0;
+  }
+  stats->blockSize = mem_pools[index].blockSize;
+  stats->count = mem_pools[index].count;
+  stats->used = mem_pools[index].used;
+  stats->usedMax = mem_pools[index].usedMax;
+  stats->fallbacks = mem_pools[index].fallbacks;
+  return 1;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEM_POOL_ENABLED */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
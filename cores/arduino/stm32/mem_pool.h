@@ -0,0 +1,108 @@
+/**
+  ******************************************************************************
+  * @file    mem_pool.h
+  * @brief   Header for the fixed-block pool allocator
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+  *
+  * Redistribution and use in source and binary forms, with or without modification,
+  * are permitted provided that the following conditions are met:
+  *   1. Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *   2. Redistributions in binary form must reproduce the above copyright notice,
+  *      this list of conditions and the following disclaimer in the documentation
+  *      and/or other materials provided with the distribution.
+  *   3. Neither the name of STMicroelectronics nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __MEM_POOL_H
+#define __MEM_POOL_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "variant.h"
+#include "stm32_def.h"
+#include <stdlib.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct {
+  uint16_t blockSize;
+  uint16_t count;       /* number of blocks */
+  uint16_t used;        /* blocks allocated */
+  uint16_t usedMax;     /* high water mark of used */
+  uint32_t fallbacks;   /* requests for this size served elsewhere: pool empty */
+} mem_pool_stats_t;
+
+/* Exported constants --------------------------------------------------------*/
+/*
+ * The pools are disabled by default. They are enabled by defining in
+ * variant.h up to 4 size classes, from the smallest, for example:
+ *   #define MEM_POOL_1_SIZE    16    // bytes, multiple of 8
+ *   #define MEM_POOL_1_COUNT   32
+ *   #define MEM_POOL_2_SIZE    48
+ *   #define MEM_POOL_2_COUNT   16
+ * operator new and String then use the smallest class that fits, then the
+ * bigger ones when it is empty, then malloc.
+ */
+#if defined(MEM_POOL_1_SIZE)
+#define MEM_POOL_ENABLED
+#endif
+
+#ifdef MEM_POOL_ENABLED
+#if defined(MEM_POOL_4_SIZE)
+#define MEM_POOL_NUM  4
+#elif defined(MEM_POOL_3_SIZE)
+#define MEM_POOL_NUM  3
+#elif defined(MEM_POOL_2_SIZE)
+#define MEM_POOL_NUM  2
+#else
+#define MEM_POOL_NUM  1
+#endif
+#else
+#define MEM_POOL_NUM  0
+#endif
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+#ifdef MEM_POOL_ENABLED
+void *mem_pool_alloc(size_t size);
+void *mem_pool_alloc_isr(size_t size);
+void *mem_pool_realloc(void *ptr, size_t size);
+void mem_pool_free(void *ptr);
+uint8_t mem_pool_get_stats(uint8_t index, mem_pool_stats_t *stats);
+#else
+#define mem_pool_alloc(size)          malloc(size)
+#define mem_pool_alloc_isr(size)      NULL
+#define mem_pool_realloc(ptr, size)   realloc(ptr, size)
+#define mem_pool_free(ptr)            free(ptr)
+#define mem_pool_get_stats(index, stats)  0
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MEM_POOL_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,668 @@
+/**
+  ******************************************************************************
+  * @file    rtc.c
+  * @author  WI6LABS
+  * @version V1.0.0
+  * @date    12-December-2017
+  * @brief   provide the RTC interface
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+  *
+  * Redistribution and use in source and binary forms, with or without modification,
+  * are permitted provided that the following conditions are met:
+  *   1. Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *   2. Redistributions in binary form must reproduce the above copyright notice,
+  *      this list of conditions and the following disclaimer in the documentation
+  *      and/or other materials provided with the distribution.
+  *   3. Neither the name of STMicroelectronics nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  ******************************************************************************
+  */
+/** @addtogroup CMSIS
+  * @{
+  */
+
+/** @addtogroup stm32f4xx_system
+  * @{
+  */
+
+/** @addtogroup STM32F4xx_System_Private_Includes
+  * @{
+  */
+#include "rtc.h"
+
+#ifdef RTC_CALENDAR_SUPPORT
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+  * @}
+  */
+
+/** @addtogroup STM32F4xx_System_Private_Defines
+  * @{
+  */
+/* ck_apre = RTCCLK / 32 (~1 kHz), ck_spre = ck_apre / (PREDIV_S + 1) = 1 Hz */
+#define RTC_ASYNCH_PREDIV 31
+
+#if defined(STM32F0xx) || defined(STM32L0xx)
+/* Alarms and wakeup timer share the RTC interrupt */
+#define RTC_Alarm_IRQn        RTC_IRQn
+#define RTC_WKUP_IRQn         RTC_IRQn
+#endif
+
+/* Days from 0000-03-01 to 1970-01-01 */
+#define DAYS_TO_EPOCH         719468UL
+#define SECONDS_PER_DAY       86400UL
+
+/**
+  * @}
+  */
+
+/** @addtogroup STM32F4xx_System_Private_Variables
+  * @{
+  */
+static RTC_HandleTypeDef RtcHandle = {.Instance = RTC};
+static sourceClock_t clkSrc = LSI_CLOCK;
+static uint32_t predivSync = 0x3FF;
+#ifdef RTC_WAKEUP_TIMER_SUPPORT
+static void (*wakeupCallback)(void) = NULL;
+#endif
+static void (*alarmCallback[2])(void) = {NULL, NULL};
+
+/**
+  * @}
+  */
+
+/**
+  * @brief  Start the RTC clock source. LSE falls back to LSI if the crystal
+  *         does not start.
+  * @param  source: LSI_CLOCK or LSE_CLOCK
+  * @retval Clock source actually used
+  */
+static sourceClock_t RTC_initClock(sourceClock_t source)
+{
+  RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+  RCC_PeriphCLKInitTypeDef PeriphClkInit = {0};
+
+  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_NONE;
+  if(source == LSE_CLOCK) {
+    RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_LSE;
+    RCC_OscInitStruct.LSEState = RCC_LSE_ON;
+    if(HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK) {
+      source = LSI_CLOCK;
+    }
+  }
+  if(source == LSI_CLOCK) {
+    RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_LSI;
+    RCC_OscInitStruct.LSIState = RCC_LSI_ON;
+    HAL_RCC_OscConfig(&RCC_OscInitStruct);
+  }
+
+  /* Backup domain is reset by the HAL if the source changes */
+  PeriphClkInit.PeriphClockSelection = RCC_PERIPHCLK_RTC;
+  PeriphClkInit.RTCClockSelection = (source == LSE_CLOCK) ? RCC_RTCCLKSOURCE_LSE : RCC_RTCCLKSOURCE_LSI;
+  HAL_RCCEx_PeriphCLKConfig(&PeriphClkInit);
+
+  return source;
+}
+
+/**
+  * @brief  RTC initialization: 24h format, 1 Hz calendar clock. The
+  *         calendar is kept if the backup domain was already running
+  *         from the same clock (e.g. wakeup from standby).
+  * @param  source: LSI_CLOCK or LSE_CLOCK
+  * @retval None
+  */
+void RTC_init(sourceClock_t source)
+{
+  uint32_t freq;
+
+  /* Backup domain write access */
+  __HAL_RCC_PWR_CLK_ENABLE();
+  HAL_PWR_EnableBkUpAccess();
+
+  clkSrc = RTC_initClock(source);
+  freq = (clkSrc == LSE_CLOCK) ? LSE_VALUE : LSI_VALUE;
+  predivSync = (freq / (RTC_ASYNCH_PREDIV + 1)) - 1;
+
+  __HAL_RCC_RTC_ENABLE();
+
+  RtcHandle.Instance = RTC;
+  RtcHandle.Init.HourFormat = RTC_HOURFORMAT_24;
+  RtcHandle.Init.AsynchPrediv = RTC_ASYNCH_PREDIV;
+  RtcHandle.Init.SynchPrediv = predivSync;
+  RtcHandle.Init.OutPut = RTC_OUTPUT_DISABLE;
+#if defined(RTC_OUTPUT_REMAP_NONE)
+  RtcHandle.Init.OutPutRemap = RTC_OUTPUT_REMAP_NONE;
+#endif
+  RtcHandle.Init.OutPutPolarity = RTC_OUTPUT_POLARITY_HIGH;
+  RtcHandle.Init.OutPutType = RTC_OUTPUT_TYPE_OPENDRAIN;
+
+  if((RTC->ISR & RTC_ISR_INITS) && (RTC->PRER == ((RTC_ASYNCH_PREDIV << 16) | predivSync))) {
+    /* Already configured: only wait for the shadow registers */
+    RtcHandle.State = HAL_RTC_STATE_READY;
+    HAL_RTC_WaitForSynchro(&RtcHandle);
+  } else {
+    HAL_RTC_Init(&RtcHandle);
+  }
+}
+
+/**
+  * @brief  RTC deinitialization. Stop the RTC clock.
+  * @param  None
+  * @retval None
+  */
+void RTC_DeInit(void)
+{
+#ifdef RTC_WAKEUP_TIMER_SUPPORT
+  RTC_StopWakeUpTimer();
+#endif
+  HAL_RTC_DeInit(&RtcHandle);
+  __HAL_RCC_RTC_DISABLE();
+}
+
+/**
+  * @brief  Check if the calendar was set, possibly before a reset: the
+  *         backup domain is kept as long as VDD or VBAT is present.
+  * @param  None
+  * @retval 1 if the calendar is initialized, 0 otherwise
+  */
+uint8_t RTC_IsConfigured(void)
+{
+  return ((RTC->ISR & RTC_ISR_INITS) != 0);
+}
+
+/**
+  * @brief  Return the clock source used by the RTC
+  * @param  None
+  * @retval LSI_CLOCK or LSE_CLOCK
+  */
+sourceClock_t RTC_GetClockSource(void)
+{
+  return clkSrc;
+}
+
+/**
+  * @brief  Set the RTC time
+  * @param  hours: 0 to 23
+  * @param  minutes: 0 to 59
+  * @param  seconds: 0 to 59
+  * @retval None
+  */
+void RTC_SetTime(uint8_t hours, uint8_t minutes, uint8_t seconds)
+{
+  RTC_TimeTypeDef RTC_TimeStruct = {0};
+
+  RTC_TimeStruct.Hours = hours;
+  RTC_TimeStruct.Minutes = minutes;
+  RTC_TimeStruct.Seconds = seconds;
+  RTC_TimeStruct.TimeFormat = RTC_HOURFORMAT12_AM;
+  RTC_TimeStruct.DayLightSaving = RTC_DAYLIGHTSAVING_NONE;
+  RTC_TimeStruct.StoreOperation = RTC_STOREOPERATION_RESET;
+  HAL_RTC_SetTime(&RtcHandle, &RTC_TimeStruct, RTC_FORMAT_BIN);
+}
+
+/**
+  * @brief  Read the RTC time
+  * @param  hours: 0 to 23
+  * @param  minutes: 0 to 59
+  * @param  seconds: 0 to 59
+  * @param  subSeconds: 0 to 999 milliseconds, 0 if not supported
+  * @retval None
+  */
+void RTC_GetTime(uint8_t *hours, uint8_t *minutes, uint8_t *seconds, uint32_t *subSeconds)
+{
+  RTC_TimeTypeDef RTC_TimeStruct = {0};
+  RTC_DateTypeDef RTC_DateStruct;
+
+  if(RtcHandle.State != HAL_RTC_STATE_RESET) {
+    HAL_RTC_GetTime(&RtcHandle, &RTC_TimeStruct, RTC_FORMAT_BIN);
+    /* Date must be read to unlock the shadow registers */
+    HAL_RTC_GetDate(&RtcHandle, &RTC_DateStruct, RTC_FORMAT_BIN);
+  }
+  *hours = RTC_TimeStruct.Hours;
+  *minutes = RTC_TimeStruct.Minutes;
+  *seconds = RTC_TimeStruct.Seconds;
+  if(subSeconds != NULL) {
+#if defined(RTC_SSR_SS)
+    /* Sub-second register is a down counter from PREDIV_S */
+    *subSeconds = ((predivSync - RTC_TimeStruct.SubSeconds) * 1000) / (predivSync + 1);
+#else
+    *subSeconds = 0;
+#endif
+  }
+}
+
+/**
+  * @brief  Set the RTC date
+  * @param  year: 0 to 99 (2000 to 2099)
+  * @param  month: 1 to 12
+  * @param  day: 1 to 31
+  * @param  wday: day of week, 1 (Monday) to 7 (Sunday)
+  * @retval None
+  */
+void RTC_SetDate(uint8_t year, uint8_t month, uint8_t day, uint8_t wday)
+{
+  RTC_DateTypeDef RTC_DateStruct;
+
+  RTC_DateStruct.Year = year;
+  RTC_DateStruct.Month = month;
+  RTC_DateStruct.Date = day;
+  RTC_DateStruct.WeekDay = wday;
+  HAL_RTC_SetDate(&RtcHandle, &RTC_DateStruct, RTC_FORMAT_BIN);
+}
+
+/**
+  * @brief  Read the RTC date
+  * @param  year: 0 to 99 (2000 to 2099)
+  * @param  month: 1 to 12
+  * @param  day: 1 to 31
+  * @param  wday: day of week, 1 (Monday) to 7 (Sunday)
+  * @retval None
+  */
+void RTC_GetDate(uint8_t *year, uint8_t *month, uint8_t *day, uint8_t *wday)
+{
+  RTC_DateTypeDef RTC_DateStruct = {0};
+
+  if(RtcHandle.State != HAL_RTC_STATE_RESET) {
+    HAL_RTC_GetDate(&RtcHandle, &RTC_DateStruct, RTC_FORMAT_BIN);
+  }
+  *year = RTC_DateStruct.Year;
+  *month = RTC_DateStruct.Month;
+  *day = RTC_DateStruct.Date;
+  *wday = RTC_DateStruct.WeekDay;
+}
+
+/**
+  * @brief  Read the raw sub-second register: down counter from PREDIV_S,
+  *         decremented at 1 / (PREDIV_S + 1) s.
+  * @param  None
+  * @retval RTC_SSR value, 0 if not supported
+  */
+uint32_t RTC_GetSubSecondRegister(void)
+{
+#if defined(RTC_SSR_SS)
+  uint32_t ss = RTC->SSR & RTC_SSR_SS;
+
+  /* Reading SSR locks the calendar shadow registers until DR is read */
+  (void)RTC->TR;
+  (void)RTC->DR;
+  return ss;
+#else
+  return 0;
+#endif
+}
+
+/**
+  * @brief  Set the calendar from a Unix timestamp
+  * @param  epoch: seconds since 1970-01-01 00:00:00, years 2000 to 2099
+  * @retval None
+  */
+void RTC_SetEpoch(uint32_t epoch)
+{
+  uint32_t days = epoch / SECONDS_PER_DAY;
+  uint32_t secs = epoch % SECONDS_PER_DAY;
+  uint32_t z = days + DAYS_TO_EPOCH;
+  uint32_t era = z / 146097;
+  uint32_t doe = z - (era * 146097);
+  uint32_t yoe = (doe - (doe / 1460) + (doe / 36524) - (doe / 146096)) / 365;
+  uint32_t doy = doe - ((365 * yoe) + (yoe / 4) - (yoe / 100));
+  uint32_t mp = ((5 * doy) + 2) / 153;
+  uint32_t day = doy - (((153 * mp) + 2) / 5) + 1;
+  uint32_t month = (mp < 10) ? (mp + 3) : (mp - 9);
+  uint32_t year = yoe + (era * 400) + (month <= 2);
+
+  /* 1970-01-01 was a Thursday */
+  RTC_SetDate(year % 100, month, day, ((days + 3) % 7) + 1);
+  RTC_SetTime(secs / 3600, (secs / 60) % 60, secs % 60);
+}
+
+/**
+  * @brief  Read the calendar as a Unix timestamp
+  * @param  subSeconds: 0 to 999 milliseconds, can be NULL
+  * @retval seconds since 1970-01-01 00:00:00
+  */
+uint32_t RTC_GetEpoch(uint32_t *subSeconds)
+{
+  RTC_TimeTypeDef RTC_TimeStruct = {0};
+  RTC_DateTypeDef RTC_DateStruct = {0};
+  uint32_t month, day;
+  uint32_t y, era, yoe, doy, doe;
+
+  if(RtcHandle.State == HAL_RTC_STATE_RESET) {
+    return 0;
+  }
+  /* Time first: it locks the date until read */
+  HAL_RTC_GetTime(&RtcHandle, &RTC_TimeStruct, RTC_FORMAT_BIN);
+  HAL_RTC_GetDate(&RtcHandle, &RTC_DateStruct, RTC_FORMAT_BIN);
+  if(subSeconds != NULL) {
+#if defined(RTC_SSR_SS)
+    *subSeconds = ((predivSync - RTC_TimeStruct.SubSeconds) * 1000) / (predivSync + 1);
+#else
+    *subSeconds = 0;
+#endif
+  }
+  month = RTC_DateStruct.Month;
+  day = RTC_DateStruct.Date;
+
+  y = 2000 + RTC_DateStruct.Year - (month <= 2);
+  era = y / 400;
+  yoe = y - (era * 400);
+  doy = ((153 * ((month > 2) ? (month - 3) : (month + 9))) + 2) / 5 + day - 1;
+  doe = (yoe * 365) + (yoe / 4) - (yoe / 100) + doy;
+
+  return ((era * 146097) + doe - DAYS_TO_EPOCH) * SECONDS_PER_DAY +
+         (RTC_TimeStruct.Hours * 3600UL) + (RTC_TimeStruct.Minutes * 60UL) + RTC_TimeStruct.Seconds;
+}
+
+/**
+  * @brief  Start an alarm, the callback attached is called on match.
+  *         An alarm also wakes up the device from stop and standby modes.
+  * @param  alarm: ALARM_A or ALARM_B
+  * @param  day: day of month, 1 to 31, used by D_HHMMSS_MSK
+  * @param  hours: 0 to 23
+  * @param  minutes: 0 to 59
+  * @param  seconds: 0 to 59
+  * @param  subSeconds: 0 to 999 milliseconds, not matched if 1000 or above
+  * @param  mask: fields to match
+  * @retval None
+  */
+void RTC_StartAlarm(alarm_t alarm, uint8_t day, uint8_t hours, uint8_t minutes,
+                    uint8_t seconds, uint32_t subSeconds, alarmMask_t mask)
+{
+  RTC_AlarmTypeDef RTC_AlarmStruct = {0};
+
+  if(RtcHandle.State == HAL_RTC_STATE_RESET) {
+    return;
+  }
+#ifdef RTC_ALARM_B_SUPPORT
+  RTC_AlarmStruct.Alarm = (alarm == ALARM_B) ? RTC_ALARM_B : RTC_ALARM_A;
+#else
+  if(alarm == ALARM_B) {
+    return;
+  }
+  RTC_AlarmStruct.Alarm = RTC_ALARM_A;
+#endif
+
+  RTC_AlarmStruct.AlarmTime.Hours = hours;
+  RTC_AlarmStruct.AlarmTime.Minutes = minutes;
+  RTC_AlarmStruct.AlarmTime.Seconds = seconds;
+  RTC_AlarmStruct.AlarmTime.TimeFormat = RTC_HOURFORMAT12_AM;
+  RTC_AlarmStruct.AlarmTime.DayLightSaving = RTC_DAYLIGHTSAVING_NONE;
+  RTC_AlarmStruct.AlarmTime.StoreOperation = RTC_STOREOPERATION_RESET;
+  RTC_AlarmStruct.AlarmDateWeekDaySel = RTC_ALARMDATEWEEKDAYSEL_DATE;
+  RTC_AlarmStruct.AlarmDateWeekDay = (day == 0) ? 1 : day;
+
+  switch(mask) {
+    case OFF_MSK:
+      RTC_AlarmStruct.AlarmMask = RTC_ALARMMASK_ALL;
+      break;
+    case SS_MSK:
+      RTC_AlarmStruct.AlarmMask = RTC_ALARMMASK_DATEWEEKDAY | RTC_ALARMMASK_HOURS | RTC_ALARMMASK_MINUTES;
+      break;
+    case MMSS_MSK:
+      RTC_AlarmStruct.AlarmMask = RTC_ALARMMASK_DATEWEEKDAY | RTC_ALARMMASK_HOURS;
+      break;
+    case HHMMSS_MSK:
+      RTC_AlarmStruct.AlarmMask = RTC_ALARMMASK_DATEWEEKDAY;
+      break;
+    case D_HHMMSS_MSK:
+    default:
+      RTC_AlarmStruct.AlarmMask = RTC_ALARMMASK_NONE;
+      break;
+  }
+
+#if defined(RTC_SSR_SS)
+  if(subSeconds < 1000) {
+    RTC_AlarmStruct.AlarmSubSecondMask = RTC_ALARMSUBSECONDMASK_NONE;
+    RTC_AlarmStruct.AlarmTime.SubSeconds = predivSync - ((subSeconds * (predivSync + 1)) / 1000);
+  } else {
+    RTC_AlarmStruct.AlarmSubSecondMask = RTC_ALARMSUBSECONDMASK_ALL;
+  }
+#else
+  UNUSED(subSeconds);
+#endif
+
+  HAL_NVIC_SetPriority(RTC_Alarm_IRQn, 2, 0);
+  HAL_NVIC_EnableIRQ(RTC_Alarm_IRQn);
+  HAL_RTC_SetAlarm_IT(&RtcHandle, &RTC_AlarmStruct, RTC_FORMAT_BIN);
+}
+
+/**
+  * @brief  Stop an alarm
+  * @param  alarm: ALARM_A or ALARM_B
+  * @retval None
+  */
+void RTC_StopAlarm(alarm_t alarm)
+{
+  if(RtcHandle.State == HAL_RTC_STATE_RESET) {
+    return;
+  }
+#ifdef RTC_ALARM_B_SUPPORT
+  HAL_RTC_DeactivateAlarm(&RtcHandle, (alarm == ALARM_B) ? RTC_ALARM_B : RTC_ALARM_A);
+#else
+  if(alarm == ALARM_A) {
+    HAL_RTC_DeactivateAlarm(&RtcHandle, RTC_ALARM_A);
+  }
+#endif
+}
+
+/**
+  * @brief  Attach a function called from the alarm interrupt
+  * @param  alarm: ALARM_A or ALARM_B
+  * @param  callback: function to call
+  * @retval None
+  */
+void attachAlarmCallback(alarm_t alarm, void (*callback)(void))
+{
+  alarmCallback[alarm] = callback;
+}
+
+/**
+  * @brief  Detach the alarm callback
+  * @param  alarm: ALARM_A or ALARM_B
+  * @retval None
+  */
+void detachAlarmCallback(alarm_t alarm)
+{
+  alarmCallback[alarm] = NULL;
+}
+
+/**
+  * @brief  Write a backup register, kept across resets and standby as long
+  *         as VDD or VBAT is present
+  * @param  index: 0 to RTC_BACKUP_NB - 1
+  * @param  value: value to store
+  * @retval None
+  */
+void RTC_SetBackupRegister(uint32_t index, uint32_t value)
+{
+  if(index < RTC_BACKUP_NB) {
+    HAL_RTCEx_BKUPWrite(&RtcHandle, index, value);
+  }
+}
+
+/**
+  * @brief  Read a backup register
+  * @param  index: 0 to RTC_BACKUP_NB - 1
+  * @retval register value, 0 if index is out of range
+  */
+uint32_t RTC_GetBackupRegister(uint32_t index)
+{
+  if(index < RTC_BACKUP_NB) {
+    return HAL_RTCEx_BKUPRead(&RtcHandle, index);
+  }
+  return 0;
+}
+
+/**
+  * @brief  Alarm A callback
+  * @param  hrtc: RTC handle
+  * @retval None
+  */
+void HAL_RTC_AlarmAEventCallback(RTC_HandleTypeDef *hrtc)
+{
+  UNUSED(hrtc);
+
+  if(alarmCallback[ALARM_A] != NULL) {
+    alarmCallback[ALARM_A]();
+  }
+}
+
+#ifdef RTC_ALARM_B_SUPPORT
+/**
+  * @brief  Alarm B callback
+  * @param  hrtc: RTC handle
+  * @retval None
+  */
+void HAL_RTCEx_AlarmBEventCallback(RTC_HandleTypeDef *hrtc)
+{
+  UNUSED(hrtc);
+
+  if(alarmCallback[ALARM_B] != NULL) {
+    alarmCallback[ALARM_B]();
+  }
+}
+#endif
+
+#ifdef RTC_WAKEUP_TIMER_SUPPORT
+/**
+  * @brief  Start the periodic wakeup timer. It also wakes up the device from
+  *         stop and standby modes.
+  * @param  ms: period in milliseconds, up to 65535 s
+  * @param  callback: function called from the interrupt, can be NULL
+  * @retval None
+  */
+void RTC_StartWakeUpTimer(uint32_t ms, void (*callback)(void))
+{
+  uint32_t freq = (clkSrc == LSE_CLOCK) ? LSE_VALUE : LSI_VALUE;
+  uint32_t counter;
+  uint32_t wakeupClock;
+
+  if(RtcHandle.State == HAL_RTC_STATE_RESET) {
+    return;
+  }
+
+  /* RTCCLK/16 gives ~0.5 ms resolution up to ~32 s, then 1 s resolution */
+  counter = (uint32_t)(((uint64_t)ms * (freq / 16)) / 1000);
+  if(counter <= 0x10000) {
+    wakeupClock = RTC_WAKEUPCLOCK_RTCCLK_DIV16;
+  } else {
+    wakeupClock = RTC_WAKEUPCLOCK_CK_SPRE_16BITS;
+    counter = (ms + 500) / 1000;
+    if(counter > 0x10000) {
+      counter = 0x10000;
+    }
+  }
+  if(counter == 0) {
+    counter = 1;
+  }
+
+  wakeupCallback = callback;
+  HAL_RTCEx_DeactivateWakeUpTimer(&RtcHandle);
+  HAL_NVIC_SetPriority(RTC_WKUP_IRQn, 2, 0);
+  HAL_NVIC_EnableIRQ(RTC_WKUP_IRQn);
+  HAL_RTCEx_SetWakeUpTimer_IT(&RtcHandle, counter - 1, wakeupClock);
+}
+
+/**
+  * @brief  Stop the wakeup timer
+  * @param  None
+  * @retval None
+  */
+void RTC_StopWakeUpTimer(void)
+{
+  if(RtcHandle.State != HAL_RTC_STATE_RESET) {
+    HAL_RTCEx_DeactivateWakeUpTimer(&RtcHandle);
+  }
+  wakeupCallback = NULL;
+}
+
+/**
+  * @brief  Wakeup timer callback
+  * @param  hrtc: RTC handle
+  * @retval None
+  */
+void HAL_RTCEx_WakeUpTimerEventCallback(RTC_HandleTypeDef *hrtc)
+{
+  UNUSED(hrtc);
+
+  if(wakeupCallback != NULL) {
+    wakeupCallback();
+  }
+}
+
+#endif /* RTC_WAKEUP_TIMER_SUPPORT */
+
+#if defined(STM32F0xx) || defined(STM32L0xx)
+/**
+  * @brief  RTC IRQ handler: alarms and wakeup timer
+  * @param  None
+  * @retval None
+  */
+void RTC_IRQHandler(void)
+{
+  HAL_RTC_AlarmIRQHandler(&RtcHandle);
+#ifdef RTC_WAKEUP_TIMER_SUPPORT
+  HAL_RTCEx_WakeUpTimerIRQHandler(&RtcHandle);
+#endif
+}
+#else
+/**
+  * @brief  RTC alarms IRQ handler
+  * @param  None
+  * @retval None
+  */
+void RTC_Alarm_IRQHandler(void)
+{
+  HAL_RTC_AlarmIRQHandler(&RtcHandle);
+}
+
+#ifdef RTC_WAKEUP_TIMER_SUPPORT
+/**
+  * @brief  RTC wakeup timer IRQ handler
+  * @param  None
+  * @retval None
+  */
+void RTC_WKUP_IRQHandler(void)
+{
+  HAL_RTCEx_WakeUpTimerIRQHandler(&RtcHandle);
+}
+#endif
+#endif /* STM32F0xx || STM32L0xx */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RTC_CALENDAR_SUPPORT */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
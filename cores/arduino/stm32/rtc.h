@@ -0,0 +1,127 @@
+/**
+  ******************************************************************************
+  * @file    rtc.h
+  * @author  WI6LABS
+  * @version V1.0.0
+  * @date    12-December-2017
+  * @brief   Header for RTC driver
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+  *
+  * Redistribution and use in source and binary forms, with or without modification,
+  * are permitted provided that the following conditions are met:
+  *   1. Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *   2. Redistributions in binary form must reproduce the above copyright notice,
+  *      this list of conditions and the following disclaimer in the documentation
+  *      and/or other materials provided with the distribution.
+  *   3. Neither the name of STMicroelectronics nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __RTC_H
+#define __RTC_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_def.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Calendar RTC with sub-second register: all families except STM32F1 */
+#if defined(HAL_RTC_MODULE_ENABLED) && defined(HAL_PWR_MODULE_ENABLED) &&\
+    !defined(STM32F1xx)
+#define RTC_CALENDAR_SUPPORT
+#if defined(RTC_CR_WUTE)
+#define RTC_WAKEUP_TIMER_SUPPORT
+#endif
+
+#if defined(RTC_CR_ALRBE)
+#define RTC_ALARM_B_SUPPORT
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum {
+  LSI_CLOCK,
+  LSE_CLOCK
+} sourceClock_t;
+
+typedef enum {
+  ALARM_A,
+  ALARM_B
+} alarm_t;
+
+/* Alarm fields to match */
+typedef enum {
+  OFF_MSK,      /* Every second */
+  SS_MSK,       /* Seconds */
+  MMSS_MSK,     /* Minutes and seconds */
+  HHMMSS_MSK,   /* Hours, minutes and seconds */
+  D_HHMMSS_MSK  /* Day of month, hours, minutes and seconds */
+} alarmMask_t;
+
+/* Exported constants --------------------------------------------------------*/
+#if defined(RTC_BKP31R)
+#define RTC_BACKUP_NB 32
+#elif defined(RTC_BKP19R)
+#define RTC_BACKUP_NB 20
+#elif defined(RTC_BKP15R)
+#define RTC_BACKUP_NB 16
+#else
+#define RTC_BACKUP_NB 5
+#endif
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void RTC_init(sourceClock_t source);
+void RTC_DeInit(void);
+uint8_t RTC_IsConfigured(void);
+sourceClock_t RTC_GetClockSource(void);
+
+void RTC_SetTime(uint8_t hours, uint8_t minutes, uint8_t seconds);
+void RTC_GetTime(uint8_t *hours, uint8_t *minutes, uint8_t *seconds, uint32_t *subSeconds);
+void RTC_SetDate(uint8_t year, uint8_t month, uint8_t day, uint8_t wday);
+void RTC_GetDate(uint8_t *year, uint8_t *month, uint8_t *day, uint8_t *wday);
+uint32_t RTC_GetSubSecondRegister(void);
+void RTC_SetEpoch(uint32_t epoch);
+uint32_t RTC_GetEpoch(uint32_t *subSeconds);
+
+void RTC_StartAlarm(alarm_t alarm, uint8_t day, uint8_t hours, uint8_t minutes,
+                    uint8_t seconds, uint32_t subSeconds, alarmMask_t mask);
+void RTC_StopAlarm(alarm_t alarm);
+void attachAlarmCallback(alarm_t alarm, void (*callback)(void));
+void detachAlarmCallback(alarm_t alarm);
+
+void RTC_SetBackupRegister(uint32_t index, uint32_t value);
+uint32_t RTC_GetBackupRegister(uint32_t index);
+#ifdef RTC_WAKEUP_TIMER_SUPPORT
+void RTC_StartWakeUpTimer(uint32_t ms, void (*callback)(void));
+void RTC_StopWakeUpTimer(void);
+#endif
+#endif /* HAL_RTC_MODULE_ENABLED && HAL_PWR_MODULE_ENABLED && !STM32F1xx */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RTC_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
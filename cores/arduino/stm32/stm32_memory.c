@@ -0,0 +1,197 @@
+/**
+  ******************************************************************************
+  * @file    stm32_memory.c
+  * @brief   Bounded heap (_sbrk) and heap and stack usage monitoring
+  *
+  *          The heap grows up from the end of the bss (_end) and the stack
+  *          grows down from _estack. _sbrk refuses to give memory above the
+  *          stack reservation of the linker script (_Min_Stack_Size) or
+  *          closer than HEAP_STACK_GUARD to the current stack pointer, so
+  *          malloc returns NULL instead of corrupting the stack.
+  *
+  *          The free RAM between the heap and the stack is painted at
+  *          start-up: the deepest stack use is found by looking for the
+  *          first overwritten word above the heap.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+  *
+  * Redistribution and use in source and binary forms, with or without modification,
+  * are permitted provided that the following conditions are met:
+  *   1. Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *   2. Redistributions in binary form must reproduce the above copyright notice,
+  *      this list of conditions and the following disclaimer in the documentation
+  *      and/or other materials provided with the distribution.
+  *   3. Neither the name of STMicroelectronics nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_memory.h"
+#include <errno.h>
+#include <malloc.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+/* Linker script symbols */
+extern char _end;
+extern char _estack;
+extern char _Min_Stack_Size;
+
+static char *heap_top = NULL;
+static char *heap_max = NULL;
+static uint32_t heap_failures = 0;
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Highest address the heap can reach now
+  * @param  none
+  * @retval address
+  */
+static char *heap_limit(void)
+{
+  char *limit = &_estack - (uint32_t)&_Min_Stack_Size;
+  char *sp = (char *)__get_MSP() - HEAP_STACK_GUARD;
+
+  return (sp < limit) ? sp : limit;
+}
+
+/**
+  * @brief  First word of the painted area, just above the heap
+  * @param  none
+  * @retval address
+  */
+static uint32_t *stack_paint_start(void)
+{
+  char *start = (heap_top != NULL) ? heap_top : &_end;
+
+  return (uint32_t *)(((uint32_t)start + 3) & ~3UL);
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Extend the heap, called by malloc
+  * @param  incr: number of bytes
+  * @retval previous end of the heap, (caddr_t)-1 if there is no room
+  */
+caddr_t _sbrk(int incr)
+{
+  char *prev_heap;
+
+  if(heap_top == NULL) {
+    heap_top = &_end;
+    heap_max = &_end;
+  }
+  if((incr > 0) && ((uint32_t)incr > (uint32_t)(heap_limit() - heap_top))) {
+    heap_failures++;
+    errno = ENOMEM;
+    return (caddr_t)-1;
+  }
+  prev_heap = heap_top;
+  heap_top += incr;
+  if(heap_top > heap_max) {
+    heap_max = heap_top;
+  }
+  return (caddr_t)prev_heap;
+}
+
+/**
+  * @brief  Heap usage, from the _sbrk bookkeeping and mallinfo()
+  * @param  stats: filled with the current values
+  * @retval none
+  */
+void heap_get_stats(heap_stats_t *stats)
+{
+  struct mallinfo mi = mallinfo();
+  char *top = (heap_top != NULL) ? heap_top : &_end;
+  char *limit = heap_limit();
+
+  stats->arena = top - &_end;
+  stats->arenaMax = ((heap_max != NULL) ? heap_max : &_end) - &_end;
+  stats->available = (limit > top) ? (uint32_t)(limit - top) : 0;
+  stats->used = mi.uordblks;
+  stats->free = mi.fordblks;
+  stats->failures = heap_failures;
+}
+
+/**
+  * @brief  Fill the free RAM between the heap and the stack with
+  *         STACK_PAINT_PATTERN. Called at start-up, could be called again to
+  *         restart the measure.
+  * @param  none
+  * @retval none
+  */
+void stack_paint(void)
+{
+  uint32_t *p = stack_paint_start();
+  /* Keep the frames of the callers */
+  uint32_t *end = (uint32_t *)(__get_MSP() - 64);
+
+  while(p < end) {
+    *p++ = STACK_PAINT_PATTERN;
+  }
+}
+
+/**
+  * @brief  Current stack use
+  * @param  none
+  * @retval number of bytes
+  */
+uint32_t stack_get_used(void)
+{
+  return (uint32_t)&_estack - __get_MSP();
+}
+
+/**
+  * @brief  Deepest stack use since stack_paint(), interrupts included
+  * @param  none
+  * @retval number of bytes
+  */
+uint32_t stack_get_max_used(void)
+{
+  uint32_t *p = stack_paint_start();
+  uint32_t *sp = (uint32_t *)__get_MSP();
+
+  while((p < sp) && (*p == STACK_PAINT_PATTERN)) {
+    p++;
+  }
+  return (uint32_t)&_estack - (uint32_t)p;
+}
+
+/**
+  * @brief  RAM never used by the heap nor the stack: the margin left
+  * @param  none
+  * @retval number of bytes, 0 if they have met
+  */
+uint32_t stack_get_unused(void)
+{
+  return (uint32_t)&_estack - (uint32_t)stack_paint_start() - stack_get_max_used();
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,79 @@
+/**
+  ******************************************************************************
+  * @file    stm32_memory.h
+  * @brief   Header for heap and stack usage monitoring
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+  *
+  * Redistribution and use in source and binary forms, with or without modification,
+  * are permitted provided that the following conditions are met:
+  *   1. Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *   2. Redistributions in binary form must reproduce the above copyright notice,
+  *      this list of conditions and the following disclaimer in the documentation
+  *      and/or other materials provided with the distribution.
+  *   3. Neither the name of STMicroelectronics nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __STM32_MEMORY_H
+#define __STM32_MEMORY_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_def.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct {
+  uint32_t arena;       /* bytes obtained by malloc from _sbrk */
+  uint32_t arenaMax;    /* high water mark of the arena */
+  uint32_t available;   /* bytes _sbrk can still give, up to the stack guard */
+  uint32_t used;        /* bytes allocated, malloc overhead included */
+  uint32_t free;        /* bytes freed inside the arena: fragmentation */
+  uint32_t failures;    /* _sbrk requests refused, failed allocations */
+} heap_stats_t;
+
+/* Exported constants --------------------------------------------------------*/
+/* Space kept between the heap and the stack pointer when _sbrk is called */
+#ifndef HEAP_STACK_GUARD
+#define HEAP_STACK_GUARD      256
+#endif
+
+#define STACK_PAINT_PATTERN   0xA5A5A5A5UL
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void heap_get_stats(heap_stats_t *stats);
+
+void stack_paint(void);
+uint32_t stack_get_used(void);
+uint32_t stack_get_max_used(void);
+uint32_t stack_get_unused(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __STM32_MEMORY_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
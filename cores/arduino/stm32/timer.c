@@ -48,6 +48,7 @@
   */
 #include "timer.h"
 #include "board.h"
+#include "PinAF_STM32F1.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -78,6 +79,7 @@
 */
 
 static void HAL_TIMx_PeriodElapsedCallback(stimer_t *obj);
+stimer_t *get_timer_obj(TIM_HandleTypeDef *htim);
 
 /**
   * @}
@@ -95,7 +97,6 @@ static void HAL_TIMx_PeriodElapsedCallback(stimer_t *obj);
   * @{
   */
 
-#define TIMER_NUM (22)
 static TIM_HandleTypeDef* timer_handles[TIMER_NUM] = {NULL};
 
 
@@ -551,6 +552,71 @@ uint32_t getTimerIrq(TIM_TypeDef* tim)
   return IRQn;
 }
 
+/**
+  * @brief  This function return the capture compare IRQ of the timer.
+  *         Advanced-control timers have a dedicated capture compare IRQ,
+  *         for all others it is the same as the one returned by getTimerIrq().
+  * @param  tim: timer instance
+  * @retval IRQn
+  */
+uint32_t getTimerCCIrq(TIM_TypeDef* tim)
+{
+  uint32_t IRQn = 0;
+
+  if(tim != (TIM_TypeDef *)NC) {
+    switch ((uint32_t)tim) {
+#if defined(TIM1_BASE)
+       case (uint32_t)TIM1:
+         IRQn = TIM1_CC_IRQn;
+         break;
+#endif
+#if defined(TIM8_BASE)
+       case (uint32_t)TIM8:
+         IRQn = TIM8_CC_IRQn;
+         break;
+#endif
+#if defined(TIM20_BASE)
+       case (uint32_t)TIM20:
+         IRQn = TIM20_CC_IRQn;
+         break;
+#endif
+     default:
+        IRQn = getTimerIrq(tim);
+        break;
+    }
+  }
+  return IRQn;
+}
+
+/**
+  * @brief  This function return the timer channel linked to a pin.
+  * @param  pin: pin name (see PinMap_PWM)
+  * @retval TIM_CHANNEL_x or 0 if the pin has no timer channel
+  */
+uint32_t getTimerChannel(PinName pin)
+{
+  uint32_t function = pinmap_function(pin, PinMap_PWM);
+  uint32_t channel = 0;
+  switch(STM_PIN_CHANNEL(function)) {
+    case 1:
+      channel = TIM_CHANNEL_1;
+      break;
+    case 2:
+      channel = TIM_CHANNEL_2;
+      break;
+    case 3:
+      channel = TIM_CHANNEL_3;
+      break;
+    case 4:
+      channel = TIM_CHANNEL_4;
+      break;
+    default:
+      channel = 0;
+    break;
+   }
+  return channel;
+}
+
 /**
   * @brief  This function will reset the timer
   * @param  timer_id : timer_id_e
@@ -812,6 +878,234 @@ void HAL_TIM_OC_MspDeInit(TIM_HandleTypeDef *htim)
   timer_disable_clock(htim);
 }
 
+/**
+  * @brief  This function will set the timer to capture the counter value
+  *         on the edges of obj->pin. The pin must have a timer channel in
+  *         PinMap_PWM. The update interrupt is also enabled so that the
+  *         16 bits counter could be extended by software (obj->irqHandle).
+  * @param  obj : timer object, obj->pin must be set
+  * @param  prescaler : clock divider
+  * @param  polarity : TIM_INPUTCHANNELPOLARITY_RISING or _FALLING
+  * @param  pull : GPIO_NOPULL, GPIO_PULLUP or GPIO_PULLDOWN
+  * @param  irqHandle : interrupt routine to call on capture
+  * @retval 1 if the capture is started, 0 otherwise
+  */
+uint8_t TimerInputCaptureInit(stimer_t *obj, uint16_t prescaler, uint32_t polarity, uint32_t pull, void (*irqHandle)(stimer_t *, uint32_t))
+{
+  TIM_IC_InitTypeDef sConfig = {};
+  TIM_HandleTypeDef *handle;
+  uint32_t channel;
+
+  if(obj == NULL)
+    return 0;
+
+  handle = &(obj->handle);
+  obj->timer = (TIM_TypeDef *)pinmap_peripheral(obj->pin, PinMap_PWM);
+  if(obj->timer == NP)
+    return 0;
+  channel = getTimerChannel(obj->pin);
+  if(!IS_TIM_CHANNELS(channel))
+    return 0;
+
+  handle->Instance               = obj->timer;
+  handle->Init.Period            = 0xFFFF;
+  handle->Init.Prescaler         = prescaler;
+  handle->Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
+  handle->Init.CounterMode       = TIM_COUNTERMODE_UP;
+#if !defined(STM32L0xx) && !defined(STM32L1xx)
+  handle->Init.RepetitionCounter = 0;
+#endif
+  obj->irqHandleIC = irqHandle;
+
+  sConfig.ICPolarity  = polarity;
+  sConfig.ICSelection = TIM_ICSELECTION_DIRECTTI;
+  sConfig.ICPrescaler = TIM_ICPSC_DIV1;
+  sConfig.ICFilter    = 0;
+
+  HAL_NVIC_SetPriority(getTimerIrq(obj->timer), 14, 0);
+  HAL_NVIC_EnableIRQ(getTimerIrq(obj->timer));
+  HAL_NVIC_SetPriority(getTimerCCIrq(obj->timer), 14, 0);
+  HAL_NVIC_EnableIRQ(getTimerCCIrq(obj->timer));
+
+  if(HAL_TIM_IC_Init(handle) != HAL_OK) return 0;
+  if(HAL_TIM_IC_ConfigChannel(handle, &sConfig, channel) != HAL_OK) return 0;
+
+  TimerChannelPinInit(obj->pin, 1, pull);
+
+  __HAL_TIM_CLEAR_IT(handle, TIM_IT_UPDATE);
+  __HAL_TIM_ENABLE_IT(handle, TIM_IT_UPDATE);
+  if(HAL_TIM_IC_Start_IT(handle, channel) != HAL_OK) return 0;
+  return 1;
+}
+
+/**
+  * @brief  This function will stop the input capture
+  * @param  obj : timer object
+  * @retval None
+  */
+void TimerInputCaptureDeinit(stimer_t *obj)
+{
+  TIM_HandleTypeDef *handle = &(obj->handle);
+
+  obj->irqHandleIC = NULL;
+  obj->irqHandle = NULL;
+
+  __HAL_TIM_DISABLE_IT(handle, TIM_IT_UPDATE);
+  HAL_TIM_IC_Stop_IT(handle, getTimerChannel(obj->pin));
+  HAL_TIM_IC_DeInit(handle);
+}
+
+/**
+  * @brief  Change the edge captured by a channel
+  * @param  obj : timer object
+  * @param  channel : TIM_CHANNEL_x
+  * @param  polarity : TIM_INPUTCHANNELPOLARITY_RISING or _FALLING
+  * @retval None
+  */
+void setCapturePolarity(stimer_t *obj, uint32_t channel, uint32_t polarity)
+{
+  __HAL_TIM_SET_CAPTUREPOLARITY(&(obj->handle), channel, polarity);
+}
+
+/**
+  * @brief  Get the last captured counter value of a channel
+  * @param  obj : timer object
+  * @param  channel : TIM_CHANNEL_x
+  * @retval Captured value
+  */
+uint32_t getCaptureRegister(stimer_t *obj, uint32_t channel)
+{
+  return HAL_TIM_ReadCapturedValue(&(obj->handle), channel);
+}
+
+/**
+  * @brief  Initializes the TIM Input Capture MSP.
+  * @param  htim: TIM handle
+  * @retval None
+  */
+void HAL_TIM_IC_MspInit(TIM_HandleTypeDef *htim)
+{
+  timer_enable_clock(htim);
+}
+
+/**
+  * @brief  DeInitialize TIM Input Capture MSP.
+  * @param  htim: TIM handle
+  * @retval None
+  */
+void HAL_TIM_IC_MspDeInit(TIM_HandleTypeDef *htim)
+{
+  timer_disable_clock(htim);
+}
+
+/**
+  * @brief  This function will set the timer in quadrature encoder mode: the
+  *         counter is incremented or decremented by hardware on each edge of
+  *         obj->pin (A) and pinB. Both pins must be the channels 1 and 2 of
+  *         the same timer (see PinMap_PWM), in any order. The update interrupt
+  *         is enabled so that the counter could be extended by software.
+  * @param  obj : timer object, obj->pin must be set
+  * @param  pinB : second pin of the encoder
+  * @param  pull : GPIO_NOPULL, GPIO_PULLUP or GPIO_PULLDOWN
+  * @param  filter : input filter, 0 (none) to 15
+  * @param  irqHandle : interrupt routine to call on counter overflow/underflow
+  * @retval None
+  */
+void TimerEncoderInit(stimer_t *obj, PinName pinB, uint32_t pull, uint8_t filter, void (*irqHandle)(stimer_t *))
+{
+  TIM_Encoder_InitTypeDef sConfig = {};
+  TIM_HandleTypeDef *handle;
+
+  if(obj == NULL)
+    return;
+
+  handle = &(obj->handle);
+  obj->timer = (TIM_TypeDef *)pinmap_peripheral(obj->pin, PinMap_PWM);
+  if((obj->timer == NP) || !IS_TIM_ENCODER_INTERFACE_INSTANCE(obj->timer))
+    return;
+
+  handle->Instance               = obj->timer;
+  handle->Init.Period            = 0xFFFF;
+#if defined(IS_TIM_32B_COUNTER_INSTANCE)
+  if(IS_TIM_32B_COUNTER_INSTANCE(obj->timer)) {
+    handle->Init.Period          = 0xFFFFFFFF;
+  }
+#endif
+  handle->Init.Prescaler         = 0;
+  handle->Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
+  handle->Init.CounterMode       = TIM_COUNTERMODE_UP;
+#if !defined(STM32L0xx) && !defined(STM32L1xx)
+  handle->Init.RepetitionCounter = 0;
+#endif
+  obj->irqHandle = irqHandle;
+
+  // Count on both edges of both inputs (x4 resolution). Pin A is expected
+  // on TI1: if it is on TI2, TI1 is inverted to keep the counting direction.
+  sConfig.EncoderMode  = TIM_ENCODERMODE_TI12;
+  sConfig.IC1Polarity  = (getTimerChannel(obj->pin) == TIM_CHANNEL_1) ?
+                         TIM_ICPOLARITY_RISING : TIM_ICPOLARITY_FALLING;
+  sConfig.IC1Selection = TIM_ICSELECTION_DIRECTTI;
+  sConfig.IC1Prescaler = TIM_ICPSC_DIV1;
+  sConfig.IC1Filter    = filter & 0xF;
+  sConfig.IC2Polarity  = TIM_ICPOLARITY_RISING;
+  sConfig.IC2Selection = TIM_ICSELECTION_DIRECTTI;
+  sConfig.IC2Prescaler = TIM_ICPSC_DIV1;
+  sConfig.IC2Filter    = filter & 0xF;
+
+  HAL_NVIC_SetPriority(getTimerIrq(obj->timer), 14, 0);
+  HAL_NVIC_EnableIRQ(getTimerIrq(obj->timer));
+
+  if(HAL_TIM_Encoder_Init(handle, &sConfig) != HAL_OK) return;
+
+  TimerChannelPinInit(obj->pin, 1, pull);
+  TimerChannelPinInit(pinB, 1, pull);
+
+  __HAL_TIM_CLEAR_IT(handle, TIM_IT_UPDATE);
+  __HAL_TIM_ENABLE_IT(handle, TIM_IT_UPDATE);
+  if(HAL_TIM_Encoder_Start(handle, TIM_CHANNEL_ALL) != HAL_OK) return;
+}
+
+/**
+  * @brief  This function will stop the encoder mode and release the pins
+  * @param  obj : timer object
+  * @param  pinB : second pin of the encoder
+  * @retval None
+  */
+void TimerEncoderDeinit(stimer_t *obj, PinName pinB)
+{
+  TIM_HandleTypeDef *handle = &(obj->handle);
+
+  obj->irqHandle = NULL;
+
+  __HAL_TIM_DISABLE_IT(handle, TIM_IT_UPDATE);
+  HAL_NVIC_DisableIRQ(getTimerIrq(obj->timer));
+  HAL_TIM_Encoder_Stop(handle, TIM_CHANNEL_ALL);
+  HAL_TIM_Encoder_DeInit(handle);
+
+  digital_io_init(obj->pin, GPIO_MODE_INPUT, GPIO_NOPULL);
+  digital_io_init(pinB, GPIO_MODE_INPUT, GPIO_NOPULL);
+}
+
+/**
+  * @brief  Initializes the TIM Encoder Interface MSP.
+  * @param  htim: TIM handle
+  * @retval None
+  */
+void HAL_TIM_Encoder_MspInit(TIM_HandleTypeDef *htim)
+{
+  timer_enable_clock(htim);
+}
+
+/**
+  * @brief  DeInitialize TIM Encoder Interface MSP.
+  * @param  htim: TIM handle
+  * @retval None
+  */
+void HAL_TIM_Encoder_MspDeInit(TIM_HandleTypeDef *htim)
+{
+  timer_disable_clock(htim);
+}
+
 /* Aim of the function is to get timer_s pointer using htim pointer */
 /* Highly inspired from magical linux kernel's "container_of" */
 /* (which was not directly used since not compatible with IAR toolchain) */
@@ -840,6 +1134,15 @@ void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim)
       case HAL_TIM_ACTIVE_CHANNEL_1:
         channel = TIM_CHANNEL_1 / 4;
       break;
+      case HAL_TIM_ACTIVE_CHANNEL_2:
+        channel = TIM_CHANNEL_2 / 4;
+      break;
+      case HAL_TIM_ACTIVE_CHANNEL_3:
+        channel = TIM_CHANNEL_3 / 4;
+      break;
+      case HAL_TIM_ACTIVE_CHANNEL_4:
+        channel = TIM_CHANNEL_4 / 4;
+      break;
       default:
         return;
       break;
@@ -848,6 +1151,38 @@ void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim)
   }
 }
 
+/**
+  * @brief  Input Capture callback in non-blocking mode
+  * @param  htim : TIM IC handle
+  * @retval None
+  */
+void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef *htim)
+{
+  uint32_t channel = 0;
+  stimer_t *obj = get_timer_obj(htim);
+
+  if(obj->irqHandleIC != NULL) {
+    switch(htim->Channel) {
+      case HAL_TIM_ACTIVE_CHANNEL_1:
+        channel = TIM_CHANNEL_1;
+      break;
+      case HAL_TIM_ACTIVE_CHANNEL_2:
+        channel = TIM_CHANNEL_2;
+      break;
+      case HAL_TIM_ACTIVE_CHANNEL_3:
+        channel = TIM_CHANNEL_3;
+      break;
+      case HAL_TIM_ACTIVE_CHANNEL_4:
+        channel = TIM_CHANNEL_4;
+      break;
+      default:
+        return;
+      break;
+    }
+    obj->irqHandleIC(obj, channel);
+  }
+}
+
 /**
   * @brief  Period elapsed callback in non-blocking mode
   * @param  timer_id : id of the timer
@@ -910,14 +1245,13 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
   */
 void TimerPinInit(stimer_t *obj, uint32_t frequency, uint32_t duration)
 {
-  uint8_t end = 0;
   uint32_t timClkFreq = 0;
   // TIMER_TONE freq is twice frequency
   uint32_t timFreq = 2*frequency;
   uint32_t prescaler = 1;
   uint32_t period = 0;
 
-  if(frequency > MAX_FREQ)
+  if((frequency == 0) || (frequency > MAX_FREQ))
     return;
 
   obj->timer = TIMER_TONE;
@@ -925,7 +1259,7 @@ void TimerPinInit(stimer_t *obj, uint32_t frequency, uint32_t duration)
 
   //Calculate the toggle count
   if (duration > 0) {
-    obj->pinInfo.count = ((timFreq * duration) / 1000);
+    obj->pinInfo.count = (int32_t)(((uint64_t)timFreq * duration) / 1000);
   }
   else {
     obj->pinInfo.count = -1;
@@ -934,17 +1268,7 @@ void TimerPinInit(stimer_t *obj, uint32_t frequency, uint32_t duration)
   digital_io_init(obj->pin, GPIO_MODE_OUTPUT_PP, GPIO_NOPULL);
   timClkFreq = getTimerClkFreq(obj->timer);
 
-  while(end == 0) {
-    period = ((uint32_t)( timClkFreq / timFreq / prescaler)) - 1;
-
-    if((period >= 0xFFFF) && (prescaler < 0xFFFF))
-      prescaler++; //prescaler *= 2;
-
-    else
-      end = 1;
-  }
-
-  if((period < 0xFFFF) && (prescaler < 0xFFFF)) {
+  if(timer_compute_period(timClkFreq / timFreq, &prescaler, &period)) {
     obj->irqHandle = HAL_TIMx_PeriodElapsedCallback;
     TimerHandleInit(obj, period, prescaler-1);
   }
@@ -1020,6 +1344,203 @@ void attachIntHandle(stimer_t *obj, void (*irqHandle)(stimer_t *))
 }
 
 
+/**
+  * @brief  This function return the index of a timer in the internal tables
+  * @param  tim: timer instance
+  * @retval TIMx index (x - 1) or -1 if the instance is unknown
+  */
+int8_t getTimerIndex(TIM_TypeDef *tim)
+{
+  int8_t index = -1;
+
+  switch ((uint32_t)tim) {
+#if defined(TIM1_BASE)
+    case (uint32_t)TIM1:
+      index = 0;
+      break;
+#endif
+#if defined(TIM2_BASE)
+    case (uint32_t)TIM2:
+      index = 1;
+      break;
+#endif
+#if defined(TIM3_BASE)
+    case (uint32_t)TIM3:
+      index = 2;
+      break;
+#endif
+#if defined(TIM4_BASE)
+    case (uint32_t)TIM4:
+      index = 3;
+      break;
+#endif
+#if defined(TIM5_BASE)
+    case (uint32_t)TIM5:
+      index = 4;
+      break;
+#endif
+#if defined(TIM6_BASE)
+    case (uint32_t)TIM6:
+      index = 5;
+      break;
+#endif
+#if defined(TIM7_BASE)
+    case (uint32_t)TIM7:
+      index = 6;
+      break;
+#endif
+#if defined(TIM8_BASE)
+    case (uint32_t)TIM8:
+      index = 7;
+      break;
+#endif
+#if defined(TIM9_BASE)
+    case (uint32_t)TIM9:
+      index = 8;
+      break;
+#endif
+#if defined(TIM10_BASE)
+    case (uint32_t)TIM10:
+      index = 9;
+      break;
+#endif
+#if defined(TIM11_BASE)
+    case (uint32_t)TIM11:
+      index = 10;
+      break;
+#endif
+#if defined(TIM12_BASE)
+    case (uint32_t)TIM12:
+      index = 11;
+      break;
+#endif
+#if defined(TIM13_BASE)
+    case (uint32_t)TIM13:
+      index = 12;
+      break;
+#endif
+#if defined(TIM14_BASE)
+    case (uint32_t)TIM14:
+      index = 13;
+      break;
+#endif
+#if defined(TIM15_BASE)
+    case (uint32_t)TIM15:
+      index = 14;
+      break;
+#endif
+#if defined(TIM16_BASE)
+    case (uint32_t)TIM16:
+      index = 15;
+      break;
+#endif
+#if defined(TIM17_BASE)
+    case (uint32_t)TIM17:
+      index = 16;
+      break;
+#endif
+#if defined(TIM18_BASE)
+    case (uint32_t)TIM18:
+      index = 17;
+      break;
+#endif
+#if defined(TIM19_BASE)
+    case (uint32_t)TIM19:
+      index = 18;
+      break;
+#endif
+#if defined(TIM20_BASE)
+    case (uint32_t)TIM20:
+      index = 19;
+      break;
+#endif
+#if defined(TIM21_BASE)
+    case (uint32_t)TIM21:
+      index = 20;
+      break;
+#endif
+#if defined(TIM22_BASE)
+    case (uint32_t)TIM22:
+      index = 21;
+      break;
+#endif
+    default:
+      break;
+  }
+  return index;
+}
+
+/**
+  * @brief  Reserve a timer for a driver. A timer could be shared by several
+  *         references of the same user (ex: PWM on several channels) but
+  *         not by different users.
+  * @param  tim: timer instance
+  * @param  user: driver requesting the timer
+  * @retval 1 if the timer is reserved for the user, 0 if it is already used
+  */
+uint8_t TimerAcquire(TIM_TypeDef *tim, timerUser_t user)
+{
+  return timer_alloc_acquire(getTimerIndex(tim), user);
+}
+
+/**
+  * @brief  Release one reference of a timer reserved by TimerAcquire().
+  *         The timer is free when its last reference is released.
+  * @param  tim: timer instance
+  * @param  user: driver releasing the timer
+  * @retval None
+  */
+void TimerRelease(TIM_TypeDef *tim, timerUser_t user)
+{
+  timer_alloc_release(getTimerIndex(tim), user);
+}
+
+/**
+  * @brief  This function return the driver using a timer
+  * @param  tim: timer instance
+  * @retval TIMER_FREE if the timer is not used
+  */
+timerUser_t getTimerUser(TIM_TypeDef *tim)
+{
+  return timer_alloc_user(getTimerIndex(tim));
+}
+
+/**
+  * @brief  Configure a pin in alternate function mode for its timer channel
+  *         (see PinMap_PWM).
+  * @param  pin: pin name
+  * @param  input: 1 for an input channel (input capture), 0 for an output
+  * @param  pull: GPIO_NOPULL, GPIO_PULLUP or GPIO_PULLDOWN
+  * @retval None
+  */
+void TimerChannelPinInit(PinName pin, uint8_t input, uint32_t pull)
+{
+  GPIO_InitTypeDef GPIO_InitStruct;
+  GPIO_TypeDef *port;
+  uint32_t function = pinmap_function(pin, PinMap_PWM);
+
+  port = set_GPIO_Port_Clock(STM_PORT(pin));
+
+  GPIO_InitStruct.Pin = STM_GPIO_PIN(pin);
+  GPIO_InitStruct.Pull = pull;
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+#ifdef STM32F1xx
+  /* An input is read by the timer in any input mode: the AF one has no pull */
+  if(input) {
+    GPIO_InitStruct.Mode = (pull != GPIO_NOPULL) ? GPIO_MODE_INPUT : GPIO_MODE_AF_INPUT;
+  } else {
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+  }
+  pin_SetF1AFPin(STM_PIN_AFNUM(function));
+#else
+  UNUSED(input);
+  GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+  GPIO_InitStruct.Alternate = STM_PIN_AFNUM(function);
+#endif /* STM32F1xx */
+
+  HAL_GPIO_Init(port, &GPIO_InitStruct);
+}
+
 /******************************************************************************/
 /*                            TIMx IRQ HANDLER                                */
 /******************************************************************************/
@@ -1054,6 +1575,20 @@ void TIM1_IRQHandler(void)
 }
 #endif //TIM1_BASE
 
+#if defined(TIM1_BASE)
+/**
+  * @brief  TIM1 capture compare IRQHandler
+  * @param  None
+  * @retval None
+  */
+void TIM1_CC_IRQHandler(void)
+{
+  if(timer_handles[0] != NULL) {
+    HAL_TIM_IRQHandler(timer_handles[0]);
+  }
+}
+#endif //TIM1_BASE
+
 #if defined(TIM2_BASE)
 /**
   * @brief  TIM2 IRQHandler
@@ -1158,6 +1693,20 @@ void TIM8_IRQHandler(void)
 }
 #endif //TIM8_BASE
 
+#if defined(TIM8_BASE)
+/**
+  * @brief  TIM8 capture compare IRQHandler
+  * @param  None
+  * @retval None
+  */
+void TIM8_CC_IRQHandler(void)
+{
+  if(timer_handles[7] != NULL) {
+    HAL_TIM_IRQHandler(timer_handles[7]);
+  }
+}
+#endif //TIM8_BASE
+
 #if defined(TIM9_BASE)
 /**
   * @brief  TIM9 IRQHandler
@@ -1332,6 +1881,20 @@ void TIM20_IRQHandler(void)
 }
 #endif //TIM20_BASE
 
+#if defined(TIM20_BASE)
+/**
+  * @brief  TIM20 capture compare IRQHandler
+  * @param  None
+  * @retval None
+  */
+void TIM20_CC_IRQHandler(void)
+{
+  if(timer_handles[19] != NULL) {
+    HAL_TIM_IRQHandler(timer_handles[19]);
+  }
+}
+#endif //TIM20_BASE
+
 #if defined(TIM21_BASE)
 /**
   * @brief  TIM21 IRQHandler
@@ -42,6 +42,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "stm32_def.h"
 #include "PeripheralPins.h"
+#include "timer_alloc.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -68,6 +69,7 @@ struct timer_s{
   uint8_t idx;
   void (*irqHandle)(stimer_t *);
   void (*irqHandleOC)(stimer_t *, uint32_t);
+  void (*irqHandleIC)(stimer_t *, uint32_t);
   PinName pin;
   volatile timerPinInfo_t pinInfo;
 };
@@ -190,17 +192,33 @@ void TimerPinDeinit(stimer_t *obj);
 void TimerPulseInit(stimer_t *obj, uint16_t period, uint16_t pulseWidth, void (*irqHandle)(stimer_t *, uint32_t));
 void TimerPulseDeinit(stimer_t *obj);
 
+uint8_t TimerInputCaptureInit(stimer_t *obj, uint16_t prescaler, uint32_t polarity, uint32_t pull, void (*irqHandle)(stimer_t *, uint32_t));
+void TimerInputCaptureDeinit(stimer_t *obj);
+void setCapturePolarity(stimer_t *obj, uint32_t channel, uint32_t polarity);
+uint32_t getCaptureRegister(stimer_t *obj, uint32_t channel);
+
+void TimerEncoderInit(stimer_t *obj, PinName pinB, uint32_t pull, uint8_t filter, void (*irqHandle)(stimer_t *));
+void TimerEncoderDeinit(stimer_t *obj, PinName pinB);
+
 uint32_t getTimerCounter(stimer_t *obj);
 void setTimerCounter(stimer_t *obj, uint32_t value);
 void setCCRRegister(stimer_t *obj, uint32_t channel, uint32_t value);
 uint32_t getCCRRegister(stimer_t *obj, uint32_t channel);
 
 uint32_t getTimerIrq(TIM_TypeDef* tim);
+uint32_t getTimerCCIrq(TIM_TypeDef* tim);
+uint32_t getTimerChannel(PinName pin);
 uint8_t getTimerClkSrc(TIM_TypeDef* tim);
 uint32_t getTimerClkFreq(TIM_TypeDef* tim);
 
 void attachIntHandle(stimer_t *obj, void (*irqHandle)(stimer_t *));
 
+int8_t getTimerIndex(TIM_TypeDef *tim);
+uint8_t TimerAcquire(TIM_TypeDef *tim, timerUser_t user);
+void TimerRelease(TIM_TypeDef *tim, timerUser_t user);
+timerUser_t getTimerUser(TIM_TypeDef *tim);
+void TimerChannelPinInit(PinName pin, uint8_t input, uint32_t pull);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,145 @@
+/**
+  ******************************************************************************
+  * @file    timer_alloc.c
+  * @brief   Owners of the timers and period of the tone timer, independent
+  *          of the hardware so that they can be checked on a host
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+  *
+  * Redistribution and use in source and binary forms, with or without modification,
+  * are permitted provided that the following conditions are met:
+  *   1. Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *   2. Redistributions in binary form must reproduce the above copyright notice,
+  *      this list of conditions and the following disclaimer in the documentation
+  *      and/or other materials provided with the distribution.
+  *   3. Neither the name of STMicroelectronics nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32_def.h"
+#include "timer_alloc.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Private variables ---------------------------------------------------------*/
+/* Owner and number of references of each timer, indexed as in timer.c */
+static timerUser_t timer_users[TIMER_NUM] = {TIMER_FREE};
+static uint8_t timer_refcount[TIMER_NUM] = {0};
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  Reserve a timer for a driver, see TimerAcquire()
+  * @param  index: timer index, see getTimerIndex()
+  * @param  user: driver requesting the timer
+  * @retval 1 if the timer is reserved for the user, 0 if it is already used
+  */
+uint8_t timer_alloc_acquire(int8_t index, timerUser_t user)
+{
+  uint8_t status = 0;
+  uint32_t primask;
+
+  if((index < 0) || (index >= TIMER_NUM) || (user == TIMER_FREE)) {
+    return 0;
+  }
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  if((timer_users[index] == TIMER_FREE) ||
+     ((timer_users[index] == user) && (timer_refcount[index] < 0xFF))) {
+    timer_users[index] = user;
+    timer_refcount[index]++;
+    status = 1;
+  }
+  __set_PRIMASK(primask);
+
+  return status;
+}
+
+/**
+  * @brief  Release one reference of a timer, see TimerRelease()
+  * @param  index: timer index, see getTimerIndex()
+  * @param  user: driver releasing the timer
+  * @retval None
+  */
+void timer_alloc_release(int8_t index, timerUser_t user)
+{
+  uint32_t primask;
+
+  if((index < 0) || (index >= TIMER_NUM)) {
+    return;
+  }
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  if((timer_users[index] == user) && (timer_refcount[index] > 0)) {
+    timer_refcount[index]--;
+    if(timer_refcount[index] == 0) {
+      timer_users[index] = TIMER_FREE;
+    }
+  }
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Driver using a timer
+  * @param  index: timer index, see getTimerIndex()
+  * @retval TIMER_FREE if the timer is not used
+  */
+timerUser_t timer_alloc_user(int8_t index)
+{
+  if((index < 0) || (index >= TIMER_NUM)) {
+    return TIMER_FREE;
+  }
+  return timer_users[index];
+}
+
+/**
+  * @brief  Split a number of timer clock cycles in a 16-bit prescaler and
+  *         period: the smallest prescaler giving a period lower than
+  *         0xFFFF ticks, computed at once.
+  * @param  cycles: timer clock cycles of a period
+  * @param  prescaler: clock divider, 1 to 0xFFFE (register value + 1)
+  * @param  period: auto-reload value, 0 to 0xFFFE (ticks - 1)
+  * @retval 1 if cycles can be counted, 0 otherwise
+  */
+uint8_t timer_compute_period(uint32_t cycles, uint32_t *prescaler, uint32_t *period)
+{
+  uint32_t div = (uint32_t)(((uint64_t)cycles + 0xFFFE) / 0xFFFF);
+
+  if(div == 0) {
+    div = 1;
+  }
+  if((cycles == 0) || (div >= 0xFFFF)) {
+    return 0;
+  }
+  *prescaler = div;
+  *period = (cycles / div) - 1;
+  return 1;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,75 @@
+/**
+  ******************************************************************************
+  * @file    timer_alloc.h
+  * @brief   Header for timer_alloc.c module
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+  *
+  * Redistribution and use in source and binary forms, with or without modification,
+  * are permitted provided that the following conditions are met:
+  *   1. Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *   2. Redistributions in binary form must reproduce the above copyright notice,
+  *      this list of conditions and the following disclaimer in the documentation
+  *      and/or other materials provided with the distribution.
+  *   3. Neither the name of STMicroelectronics nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __TIMER_ALLOC_H
+#define __TIMER_ALLOC_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+/* Owner of a timer instance, see TimerAcquire() */
+typedef enum {
+  TIMER_FREE = 0,
+  TIMER_USED_PWM,
+  TIMER_USED_TONE,
+  TIMER_USED_SERVO,
+  TIMER_USED_PULSEIN,
+  TIMER_USED_UART_EMUL,
+  TIMER_USED_HARDWARETIMER,
+  TIMER_USED_ENCODER,
+  TIMER_USED_DAC,
+} timerUser_t;
+
+/* Exported constants --------------------------------------------------------*/
+#define TIMER_NUM (22)
+
+/* Exported functions ------------------------------------------------------- */
+uint8_t timer_alloc_acquire(int8_t index, timerUser_t user);
+void timer_alloc_release(int8_t index, timerUser_t user);
+timerUser_t timer_alloc_user(int8_t index);
+uint8_t timer_compute_period(uint32_t cycles, uint32_t *prescaler, uint32_t *period);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIMER_ALLOC_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
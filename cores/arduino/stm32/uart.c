@@ -82,6 +82,37 @@ static void (*rx_callback[UART_NUM])(serial_t*);
 static serial_t *rx_callback_obj[UART_NUM];
 static int (*tx_callback[UART_NUM])(serial_t*);
 static serial_t *tx_callback_obj[UART_NUM];
+static void (*idle_callback[UART_NUM])(serial_t*);
+
+static serial_t *debug_obj = NULL;
+static size_t (*debug_write)(serial_t *obj, const uint8_t *data, uint32_t size) = NULL;
+static uint32_t debug_dropped = 0;
+
+/**
+  * @brief  Drive the RS-485 driver enable pin when it is not done by the USART
+  * @param  obj : pointer to serial_t structure
+  * @param  enable : 1 while transmitting
+  * @retval None
+  */
+static void uart_de_write(serial_t *obj, uint8_t enable)
+{
+  if((obj->pin_de != NC) && !obj->de_hardware) {
+    HAL_GPIO_WritePin(get_GPIO_Port(STM_PORT(obj->pin_de)), STM_GPIO_PIN(obj->pin_de),
+                      (enable ^ obj->de_inverted) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+  }
+}
+
+/**
+  * @brief  Send the byte at the tail of the transmit buffer. It is copied
+  *         to 16 bits: the HAL reads 2 bytes with 9 data bits.
+  * @param  obj : pointer to serial_t structure
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef uart_transmit_next(serial_t *obj)
+{
+  obj->tx_data = obj->tx_buff[obj->tx_tail];
+  return HAL_UART_Transmit_IT(uart_handlers[obj->index], (uint8_t *)&(obj->tx_data), 1);
+}
 
 /**
   * @brief  Function called to initialize the uart interface
@@ -108,6 +139,12 @@ void uart_init(serial_t *obj)
     return;
   }
 
+  //Multiprocessor address longer than the bits compared
+  if(obj->address > uart_address_max(obj)) {
+    printf("ERROR: UART address too big for the frame\n");
+    return;
+  }
+
   // Get the peripheral name (UART_1, UART_2, ...) from the pin and assign it to the object
   obj->uart = pinmap_merge_peripheral(uart_tx, uart_rx);
 
@@ -262,6 +299,32 @@ void uart_init(serial_t *obj)
 #endif /* STM32F1xx */
   HAL_GPIO_Init(port, &GPIO_InitStruct);
 
+  //RS-485 driver enable: by the USART if the pin is its RTS, else by software
+  obj->de_hardware = 0;
+  if(obj->pin_de != NC) {
+#if defined(USART_CR3_DEM)
+    if(pinmap_peripheral(obj->pin_de, PinMap_UART_RTS) == obj->uart) {
+      port = set_GPIO_Port_Clock(STM_PORT(obj->pin_de));
+      GPIO_InitStruct.Pin         = STM_GPIO_PIN(obj->pin_de);
+      GPIO_InitStruct.Mode        = STM_PIN_MODE(pinmap_function(obj->pin_de,PinMap_UART_RTS));
+      GPIO_InitStruct.Speed       = GPIO_SPEED_FREQ_HIGH;
+      GPIO_InitStruct.Pull        = STM_PIN_PUPD(pinmap_function(obj->pin_de,PinMap_UART_RTS));
+      GPIO_InitStruct.Alternate   = STM_PIN_AFNUM(pinmap_function(obj->pin_de,PinMap_UART_RTS));
+      HAL_GPIO_Init(port, &GPIO_InitStruct);
+      obj->de_hardware = 1;
+    } else
+#endif
+    {
+      port = set_GPIO_Port_Clock(STM_PORT(obj->pin_de));
+      uart_de_write(obj, 0);
+      GPIO_InitStruct.Pin         = STM_GPIO_PIN(obj->pin_de);
+      GPIO_InitStruct.Mode        = GPIO_MODE_OUTPUT_PP;
+      GPIO_InitStruct.Speed       = GPIO_SPEED_FREQ_HIGH;
+      GPIO_InitStruct.Pull        = GPIO_NOPULL;
+      HAL_GPIO_Init(port, &GPIO_InitStruct);
+    }
+  }
+
   //Configure uart
   uart_handlers[obj->index] = huart;
   huart->Instance          = (USART_TypeDef *)(obj->uart);
@@ -274,9 +337,32 @@ void uart_init(serial_t *obj)
   huart->Init.OverSampling = UART_OVERSAMPLING_16;
   // huart->Init.OneBitSampling = UART_ONE_BIT_SAMPLE_DISABLE;
 
-  if(HAL_UART_Init(huart) != HAL_OK) {
-    return;
+  if(obj->address < 0) {
+    if(HAL_UART_Init(huart) != HAL_OK) {
+      return;
+    }
+  } else {
+    // Mute until a byte with the address bit (MSB) set matches
+    if(HAL_MultiProcessor_Init(huart, (uint8_t)obj->address, UART_WAKEUPMETHOD_ADDRESSMARK) != HAL_OK) {
+      return;
+    }
+#if defined(USART_CR2_ADDM7)
+    // Whole address compared, not only its 4 low bits
+    HAL_MultiProcessorEx_AddressLength_Set(huart, UART_ADDRESS_DETECT_7B);
+    HAL_MultiProcessor_EnableMuteMode(huart);
+#endif
+    HAL_MultiProcessor_EnterMuteMode(huart);
   }
+
+#if defined(USART_CR3_DEM)
+  if(obj->de_hardware) {
+    // Asserted before the start bit, released after the last stop bit
+    __HAL_UART_DISABLE(huart);
+    SET_BIT(huart->Instance->CR3, USART_CR3_DEM);
+    MODIFY_REG(huart->Instance->CR3, USART_CR3_DEP, obj->de_inverted ? USART_CR3_DEP : 0);
+    __HAL_UART_ENABLE(huart);
+  }
+#endif
 }
 
 /**
@@ -380,6 +466,7 @@ void uart_deinit(serial_t *obj)
 #endif
 }
 
+  idle_callback[obj->index] = NULL;
   HAL_UART_DeInit(uart_handlers[obj->index]);
 }
 
@@ -411,6 +498,18 @@ size_t uart_debug_write(uint8_t *data, uint32_t size)
   uint8_t index = 0;
   USART_TypeDef* dbg_uart = DEBUG_UART;
   uint32_t tickstart = HAL_GetTick();
+  size_t written;
+
+  if(debug_write != NULL) {
+    written = debug_write(debug_obj, data, size);
+    // Wait for room like HardwareSerial::write(), unless the transmit
+    // interrupt cannot empty the buffer: in a handler or interrupts masked
+    while((written < size) && (__get_IPSR() == 0) && (__get_PRIMASK() == 0)) {
+      written += debug_write(debug_obj, data + written, size - written);
+    }
+    debug_dropped += size - written;
+    return written;
+  }
   for(index = 0; index < UART_NUM; index++) {
     if(uart_handlers[index] != NULL) {
       if(dbg_uart == uart_handlers[index]->Instance) {
@@ -432,6 +531,75 @@ size_t uart_debug_write(uint8_t *data, uint32_t size)
   return size;
 }
 
+/**
+  * @brief  Send the debug output (printf) through the transmit buffer of a
+  *         serial object, emptied by interrupt, instead of waiting for the
+  *         end of the transmission. When the buffer is full, printf waits
+  *         for room, except in an interrupt handler or with the interrupts
+  *         masked where what does not fit is lost.
+  * @param  obj : pointer to serial_t structure, ignored if it is not the
+  *         DEBUG_UART
+  * @param  write : copies what fits in the buffer of obj, starts the
+  *         transmission and returns the number of bytes copied. NULL to go
+  *         back to the blocking output.
+  * @retval None
+  */
+void uart_debug_attach(serial_t *obj, size_t (*write)(serial_t *obj, const uint8_t *data, uint32_t size))
+{
+  if(obj == NULL) {
+    return;
+  }
+  if(write == NULL) {
+    if(debug_obj == obj) {
+      debug_write = NULL;
+      debug_obj = NULL;
+    }
+  } else if(obj->uart == (USART_TypeDef *)DEBUG_UART) {
+    debug_write = NULL;
+    debug_obj = obj;
+    debug_write = write;
+  }
+}
+
+/**
+  * @brief  Number of bytes of the debug output lost: transmit buffer full
+  *         in an interrupt handler or with the interrupts masked
+  * @param  None
+  * @retval Number of bytes
+  */
+uint32_t uart_debug_dropped(void)
+{
+  return debug_dropped;
+}
+
+/**
+  * @brief  Wait for the end of all on-going transmissions: software buffer
+  *         empty and last frame shifted out. Called before entering a low
+  *         power mode which stops the UART clocks.
+  * @param  None
+  * @retval None
+  */
+void uart_flush_all(void)
+{
+  uint8_t index;
+  uint32_t tickstart;
+  serial_t *obj;
+
+  for(index = 0; index < UART_NUM; index++) {
+    if((uart_handlers[index] == NULL) ||
+       (HAL_UART_GetState(uart_handlers[index]) == HAL_UART_STATE_RESET)) {
+      continue;
+    }
+    tickstart = HAL_GetTick();
+    obj = tx_callback_obj[index];
+    if(obj != NULL) {
+      while((obj->tx_head != obj->tx_tail) && ((HAL_GetTick() - tickstart) < TX_TIMEOUT));
+    }
+    while((__HAL_UART_GET_FLAG(uart_handlers[index], UART_FLAG_TC) == RESET) &&
+          ((HAL_GetTick() - tickstart) < TX_TIMEOUT));
+  }
+}
+
 /**
  * Attempts to determine if the serial peripheral is already in use for RX
  *
@@ -472,7 +640,7 @@ int uart_getc(serial_t *obj, unsigned char* c)
   *c = (unsigned char)(obj->recv);
   // Restart RX irq
   UART_HandleTypeDef *huart = uart_handlers[obj->index];
-  HAL_UART_Receive_IT(huart, &(obj->recv), 1);
+  HAL_UART_Receive_IT(huart, (uint8_t *)&(obj->recv), 1);
 
   return 0;
 }
@@ -501,7 +669,7 @@ void uart_attach_rx_callback(serial_t *obj, void (*callback)(serial_t*))
   HAL_NVIC_SetPriority(obj->irq, 0, 1);
   HAL_NVIC_EnableIRQ(obj->irq);
 
-  if(HAL_UART_Receive_IT(uart_handlers[obj->index], &(obj->recv), 1) != HAL_OK) {
+  if(HAL_UART_Receive_IT(uart_handlers[obj->index], (uint8_t *)&(obj->recv), 1) != HAL_OK) {
     return;
   }
 }
@@ -526,10 +694,178 @@ void uart_attach_tx_callback(serial_t *obj, int (*callback)(serial_t*))
   HAL_NVIC_SetPriority(obj->irq, 0, 2);
   HAL_NVIC_EnableIRQ(obj->irq);
 
+  uart_de_write(obj, 1);
   // the following function will enable UART_IT_TXE and error interrupts
-  if (HAL_UART_Transmit_IT(uart_handlers[obj->index], &obj->tx_buff[obj->tx_tail], 1) != HAL_OK) {
+  if (uart_transmit_next(obj) != HAL_OK) {
+    return;
+  }
+}
+
+/**
+ * Call a function when the receive line becomes idle: after one frame time
+ * without start bit, or after a receiver timeout, since the last byte.
+ *
+ * @param obj : pointer to serial_t structure
+ * @param callback : function called from the interrupt, NULL to disable
+ * @param timeout : 0 for the idle line detection, else receiver timeout in
+ *        bit times, if the USART supports it
+ * @retval 0 if the timeout is not supported, 1 otherwise. Nothing is done
+ *         until the UART is initialized.
+ */
+uint8_t uart_attach_idle_callback(serial_t *obj, void (*callback)(serial_t*), uint32_t timeout)
+{
+  UART_HandleTypeDef *huart;
+
+#if !defined(USART_CR2_RTOEN)
+  if(timeout != 0) {
+    return 0;
+  }
+#endif
+  if(obj == NULL) {
+    return 0;
+  }
+  huart = uart_handlers[obj->index];
+  if(huart != &(obj->handle)) {
+    return 1;
+  }
+
+  __HAL_UART_DISABLE_IT(huart, UART_IT_IDLE);
+#if defined(USART_CR2_RTOEN)
+  CLEAR_BIT(huart->Instance->CR1, USART_CR1_RTOIE);
+  CLEAR_BIT(huart->Instance->CR2, USART_CR2_RTOEN);
+#endif
+  idle_callback[obj->index] = callback;
+  rx_callback_obj[obj->index] = obj;
+  if(callback == NULL) {
+    return 1;
+  }
+
+  if(timeout == 0) {
+    // Idle state of the previous reception, if any, is not reported
+    __HAL_UART_CLEAR_IDLEFLAG(huart);
+    __HAL_UART_ENABLE_IT(huart, UART_IT_IDLE);
+  }
+#if defined(USART_CR2_RTOEN)
+  else {
+    MODIFY_REG(huart->Instance->RTOR, USART_RTOR_RTO, timeout);
+    SET_BIT(huart->Instance->CR2, USART_CR2_RTOEN);
+    // Reserved bit, read as 0, on the instances without receiver timeout
+    if(READ_BIT(huart->Instance->CR2, USART_CR2_RTOEN) == 0) {
+      idle_callback[obj->index] = NULL;
+      return 0;
+    }
+    WRITE_REG(huart->Instance->ICR, USART_ICR_RTOCF);
+    SET_BIT(huart->Instance->CR1, USART_CR1_RTOIE);
+  }
+#endif
+  return 1;
+}
+
+/**
+ * Multiprocessor mode: ignore the bytes received until the next address
+ * which matches the node one.
+ *
+ * @param obj : pointer to serial_t structure, initialized with an address
+ * @retval none
+ */
+void uart_mute(serial_t *obj)
+{
+  if((obj == NULL) || (obj->address < 0) || (uart_handlers[obj->index] != &(obj->handle))) {
     return;
   }
+  HAL_MultiProcessor_EnterMuteMode(uart_handlers[obj->index]);
+}
+
+/**
+ * Multiprocessor mode: highest address with the frame configured in obj
+ * (databits and parity). With 7-bit address detection all the data bits
+ * but the address mark are compared: 127 with 8 data bits, 255 with 9.
+ * Only 4 bits are compared on the USART without it.
+ *
+ * @param obj : pointer to serial_t structure
+ * @retval highest address
+ */
+int16_t uart_address_max(serial_t *obj)
+{
+#if defined(USART_CR2_ADDM7)
+  uint8_t bits = 8;
+
+  if(obj->databits == UART_WORDLENGTH_9B) {
+    bits = 9;
+  }
+#ifdef UART_WORDLENGTH_7B
+  else if(obj->databits == UART_WORDLENGTH_7B) {
+    bits = 7;
+  }
+#endif
+  if(obj->parity != UART_PARITY_NONE) {
+    bits--;
+  }
+  return (1 << (bits - 1)) - 1;
+#else
+  UNUSED(obj);
+  return 15;
+#endif
+}
+
+/**
+ * Multiprocessor mode: send an address, a byte with its MSB set (9th bit
+ * with 9 data bits). Waits for the end of the transmission.
+ *
+ * @param obj : pointer to serial_t structure, transmit buffer empty
+ * @param address : address of the node, up to uart_address_max()
+ * @retval 1 if sent, 0 otherwise
+ */
+size_t uart_write_address(serial_t *obj, uint8_t address)
+{
+  UART_HandleTypeDef *huart;
+  HAL_StatusTypeDef status;
+
+  if(obj == NULL) {
+    return 0;
+  }
+  huart = uart_handlers[obj->index];
+  if((huart != &(obj->handle)) || (address > uart_address_max(obj))) {
+    return 0;
+  }
+  if((huart->Init.WordLength == UART_WORDLENGTH_9B) && (huart->Init.Parity == UART_PARITY_NONE)) {
+    obj->tx_data = 0x100 | address;
+  } else {
+    obj->tx_data = 0x80 | address;
+  }
+  uart_de_write(obj, 1);
+  status = HAL_UART_Transmit(huart, (uint8_t *)&(obj->tx_data), 1, TX_TIMEOUT);
+  uart_de_write(obj, 0);
+  if(status != HAL_OK) {
+    return 0;
+  }
+  obj->stats.txBytes++;
+  return 1;
+}
+
+/**
+ * Copy the counters of a port, consistent: taken with the interrupts
+ * disabled.
+ *
+ * @param obj : pointer to serial_t structure
+ * @param stats : filled with the counters
+ * @param clear : 1 to set the counters to 0 after the copy
+ * @retval none
+ */
+void uart_get_stats(serial_t *obj, uart_stats_t *stats, uint8_t clear)
+{
+  uint32_t primask;
+
+  if((obj == NULL) || (stats == NULL)) {
+    return;
+  }
+  primask = __get_PRIMASK();
+  __disable_irq();
+  *stats = obj->stats;
+  if(clear) {
+    memset(&(obj->stats), 0, sizeof(uart_stats_t));
+  }
+  __set_PRIMASK(primask);
 }
 
 /**
@@ -563,6 +899,7 @@ void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
   uint8_t index = uart_index(huart);
 
   if(index < UART_NUM) {
+    rx_callback_obj[index]->stats.rxBytes++;
     rx_callback[index](rx_callback_obj[index]);
   }
 }
@@ -577,10 +914,14 @@ void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
   serial_t *obj = tx_callback_obj[index];
 
   if(index < UART_NUM) {
+    obj->stats.txBytes++;
     if(tx_callback[index](obj) != -1) {
-      if (HAL_UART_Transmit_IT(uart_handlers[obj->index], &obj->tx_buff[obj->tx_tail], 1) != HAL_OK) {
+      if (uart_transmit_next(obj) != HAL_OK) {
         return;
       }
+    } else {
+      // Last stop bit sent
+      uart_de_write(obj, 0);
     }
   }
 }
@@ -593,6 +934,9 @@ void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
 void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
 {
   volatile uint32_t tmpval;
+  uint8_t index = uart_index(huart);
+  serial_t *obj;
+
 #if defined(STM32F1xx) || defined(STM32F2xx) || defined(STM32F4xx) || defined(STM32L1xx)
   if (__HAL_UART_GET_FLAG(huart, UART_FLAG_PE) != RESET) {
     tmpval = huart->Instance->DR; // Clear PE flag
@@ -616,6 +960,68 @@ void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
 #endif
 
   UNUSED(tmpval);
+
+  if(index >= UART_NUM) {
+    return;
+  }
+  obj = rx_callback_obj[index];
+  if(obj == NULL) {
+    return;
+  }
+
+  // Errors noted by the HAL, whose flags may be cleared already
+  if(huart->ErrorCode & HAL_UART_ERROR_ORE) {
+    obj->stats.overrun++;
+  }
+  if(huart->ErrorCode & HAL_UART_ERROR_FE) {
+    obj->stats.framing++;
+  }
+  if(huart->ErrorCode & HAL_UART_ERROR_PE) {
+    obj->stats.parity++;
+  }
+  if(huart->ErrorCode & HAL_UART_ERROR_NE) {
+    obj->stats.noise++;
+  }
+
+  // An overrun aborts the reception: start it again
+  if((rx_callback[index] != NULL) && !serial_rx_active(obj)) {
+    HAL_UART_Receive_IT(huart, (uint8_t *)&(obj->recv), 1);
+  }
+}
+
+/**
+  * @brief  Common part of the UART IRQ handlers: HAL processing, then idle
+  *         line and receiver timeout detection, not handled by the HAL
+  * @param  index : index of the serial handler
+  * @retval None
+  */
+static void uart_irq_handler(uint8_t index)
+{
+  UART_HandleTypeDef *huart = uart_handlers[index];
+
+  if(huart == NULL) {
+    return;
+  }
+  HAL_UART_IRQHandler(huart);
+
+  if(idle_callback[index] == NULL) {
+    return;
+  }
+  // On some series the IDLE flag is cleared by reading the data register:
+  // wait for the byte which may have arrived in between to be read first.
+  if((__HAL_UART_GET_IT_SOURCE(huart, UART_IT_IDLE) != RESET) &&
+     (__HAL_UART_GET_FLAG(huart, UART_FLAG_IDLE) != RESET) &&
+     (__HAL_UART_GET_FLAG(huart, UART_FLAG_RXNE) == RESET)) {
+    __HAL_UART_CLEAR_IDLEFLAG(huart);
+    idle_callback[index](rx_callback_obj[index]);
+  }
+#if defined(USART_CR2_RTOEN)
+  if((READ_BIT(huart->Instance->CR1, USART_CR1_RTOIE) != 0) &&
+     (READ_BIT(huart->Instance->ISR, USART_ISR_RTOF) != 0)) {
+    WRITE_REG(huart->Instance->ICR, USART_ICR_RTOCF);
+    idle_callback[index](rx_callback_obj[index]);
+  }
+#endif
 }
 
 /**
@@ -626,7 +1032,7 @@ void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
 void USART1_IRQHandler(void)
 {
   HAL_NVIC_ClearPendingIRQ(USART1_IRQn);
-  HAL_UART_IRQHandler(uart_handlers[0]);
+  uart_irq_handler(0);
 }
 
 /**
@@ -637,7 +1043,7 @@ void USART1_IRQHandler(void)
 void USART2_IRQHandler(void)
 {
   HAL_NVIC_ClearPendingIRQ(USART2_IRQn);
-  HAL_UART_IRQHandler(uart_handlers[1]);
+  uart_irq_handler(1);
 }
 
 /**
@@ -652,43 +1058,43 @@ void USART3_IRQHandler(void)
 #if defined(STM32F091xC) || defined (STM32F098xx)
   if (__HAL_GET_PENDING_IT(HAL_ITLINE_USART3)!= RESET)
   {
-    HAL_UART_IRQHandler(uart_handlers[2]);
+    uart_irq_handler(2);
   }
   if (__HAL_GET_PENDING_IT(HAL_ITLINE_USART4)!= RESET)
   {
-     HAL_UART_IRQHandler(uart_handlers[3]);
+     uart_irq_handler(3);
   }
   if (__HAL_GET_PENDING_IT(HAL_ITLINE_USART5)!= RESET)
   {
-     HAL_UART_IRQHandler(uart_handlers[4]);
+     uart_irq_handler(4);
   }
   if (__HAL_GET_PENDING_IT(HAL_ITLINE_USART6)!= RESET)
   {
-     HAL_UART_IRQHandler(uart_handlers[5]);
+     uart_irq_handler(5);
   }
   if (__HAL_GET_PENDING_IT(HAL_ITLINE_USART7)!= RESET)
   {
-     HAL_UART_IRQHandler(uart_handlers[6]);
+     uart_irq_handler(6);
   }
   if (__HAL_GET_PENDING_IT(HAL_ITLINE_USART8)!= RESET)
   {
-     HAL_UART_IRQHandler(uart_handlers[7]);
+     uart_irq_handler(7);
   }
 #else
   if(uart_handlers[2] != NULL) {
-    HAL_UART_IRQHandler(uart_handlers[2]);
+    uart_irq_handler(2);
   }
 #if defined(STM32F0xx)
 // USART3_4_IRQn
   if(uart_handlers[3] != NULL) {
-    HAL_UART_IRQHandler(uart_handlers[3]);
+    uart_irq_handler(3);
   }
 #if defined(STM32F030xC)
   if(uart_handlers[4] != NULL) {
-    HAL_UART_IRQHandler(uart_handlers[4]);
+    uart_irq_handler(4);
   }
   if(uart_handlers[5] != NULL) {
-    HAL_UART_IRQHandler(uart_handlers[5]);
+    uart_irq_handler(5);
   }
 #endif // STM32F030xC
 #endif // STM32F0xx
@@ -705,7 +1111,7 @@ void USART3_IRQHandler(void)
 void UART4_IRQHandler(void)
 {
   HAL_NVIC_ClearPendingIRQ(UART4_IRQn);
-  HAL_UART_IRQHandler(uart_handlers[3]);
+  uart_irq_handler(3);
 }
 #endif
 
@@ -720,10 +1126,10 @@ void USART4_5_IRQHandler(void)
 {
   HAL_NVIC_ClearPendingIRQ(USART4_IRQn);
   if(uart_handlers[3] != NULL) {
-    HAL_UART_IRQHandler(uart_handlers[3]);
+    uart_irq_handler(3);
   }
   if(uart_handlers[4] != NULL) {
-    HAL_UART_IRQHandler(uart_handlers[4]);
+    uart_irq_handler(4);
   }
 }
 #endif
@@ -738,7 +1144,7 @@ void USART4_5_IRQHandler(void)
 void UART5_IRQHandler(void)
 {
   HAL_NVIC_ClearPendingIRQ(UART5_IRQn);
-  HAL_UART_IRQHandler(uart_handlers[4]);
+  uart_irq_handler(4);
 }
 #endif
 
@@ -751,7 +1157,7 @@ void UART5_IRQHandler(void)
 void USART6_IRQHandler(void)
 {
   HAL_NVIC_ClearPendingIRQ(USART6_IRQn);
-  HAL_UART_IRQHandler(uart_handlers[5]);
+  uart_irq_handler(5);
 }
 #endif
 
@@ -764,7 +1170,7 @@ void USART6_IRQHandler(void)
 void UART7_IRQHandler(void)
 {
   HAL_NVIC_ClearPendingIRQ(UART7_IRQn);
-  HAL_UART_IRQHandler(uart_handlers[6]);
+  uart_irq_handler(6);
 }
 #endif
 
@@ -777,7 +1183,7 @@ void UART7_IRQHandler(void)
 void UART8_IRQHandler(void)
 {
   HAL_NVIC_ClearPendingIRQ(UART8_IRQn);
-  HAL_UART_IRQHandler(uart_handlers[7]);
+  uart_irq_handler(7);
 }
 #endif
 
@@ -790,7 +1196,7 @@ void UART8_IRQHandler(void)
 void UART9_IRQHandler(void)
 {
   HAL_NVIC_ClearPendingIRQ(UART9_IRQn);
-  HAL_UART_IRQHandler(uart_handlers[8]);
+  uart_irq_handler(8);
 }
 #endif
 
@@ -803,7 +1209,7 @@ void UART9_IRQHandler(void)
 void UART10_IRQHandler(void)
 {
   HAL_NVIC_ClearPendingIRQ(UART10_IRQn);
-  HAL_UART_IRQHandler(uart_handlers[9]);
+  uart_irq_handler(9);
 }
 #endif
 
@@ -185,17 +185,47 @@
 /* Exported types ------------------------------------------------------------*/
 typedef struct serial_s serial_t;
 
+/* Counters of a port, since its object was created or cleared */
+typedef struct {
+  uint32_t rxBytes;     /* bytes received by the UART, dropped included */
+  uint32_t txBytes;     /* bytes sent */
+  uint32_t overrun;     /* bytes lost by the UART: previous one not read in time */
+  uint32_t framing;     /* stop bit not found */
+  uint32_t parity;
+  uint32_t noise;       /* noise detected on a byte, received anyway */
+  uint32_t rxDropped;   /* bytes lost: receive buffer full */
+  uint32_t rxPeak;      /* highest number of bytes in the receive buffer */
+} uart_stats_t;
+
+/* Highest multiprocessor address, 9 data bits: with 7-bit address detection
+   the data bits except the address mark (MSB) are compared, 4 bits on the
+   USART without it. See uart_address_max() for the configured frame. */
+#if defined(USART_CR2_ADDM7)
+#define UART_ADDRESS_MAX  255
+#else
+#define UART_ADDRESS_MAX  15
+#endif
+
+/* Number of received frames waiting to be read, must be a power of 2 */
+#ifndef UART_FRAME_QUEUE
+#define UART_FRAME_QUEUE  4
+#endif
+
 struct serial_s {
   USART_TypeDef *uart;
   UART_HandleTypeDef handle;
   uint8_t index;
-  uint8_t recv;
+  uint16_t recv;              /* 16 bits: 9 data bits without parity */
   uint32_t baudrate;
   uint32_t databits;
   uint32_t stopbits;
   uint32_t parity;
   PinName pin_tx;
   PinName pin_rx;
+  PinName pin_de;             /* RS-485 driver enable, NC if unused */
+  uint8_t de_inverted;        /* driver enabled when pin_de is low */
+  uint8_t de_hardware;        /* pin_de driven by the USART (DEM) */
+  int16_t address;            /* multiprocessor node address, -1 if unused */
   IRQn_Type irq;
   uint8_t *rx_buff;
   volatile uint16_t rx_head;
@@ -203,6 +233,14 @@ struct serial_s {
   uint8_t *tx_buff;
   uint16_t tx_head;
   volatile uint16_t tx_tail;
+  uint8_t tx_written;         /* a byte was queued, by write() or printf */
+  uint16_t tx_data;           /* byte being sent, 16 bits for 9 data bits */
+  uart_stats_t stats;
+  /* Receive frames: rx_head values at the end of each frame */
+  int16_t rx_delimiter;       /* byte ending a frame, -1 for none */
+  uint16_t rx_frame_end[UART_FRAME_QUEUE];
+  volatile uint8_t rx_frame_head;
+  volatile uint8_t rx_frame_tail;
 };
 
 /* Exported constants --------------------------------------------------------*/
@@ -283,11 +321,19 @@ size_t uart_write(serial_t *obj, uint8_t data, uint16_t size);
 int uart_getc(serial_t *obj, unsigned char* c);
 void uart_attach_rx_callback(serial_t *obj, void (*callback)(serial_t*));
 void uart_attach_tx_callback(serial_t *obj, int (*callback)(serial_t*));
+uint8_t uart_attach_idle_callback(serial_t *obj, void (*callback)(serial_t*), uint32_t timeout);
+void uart_mute(serial_t *obj);
+int16_t uart_address_max(serial_t *obj);
+size_t uart_write_address(serial_t *obj, uint8_t address);
+void uart_get_stats(serial_t *obj, uart_stats_t *stats, uint8_t clear);
 
 uint8_t serial_tx_active(serial_t *obj);
 uint8_t serial_rx_active(serial_t *obj);
 
 size_t uart_debug_write(uint8_t *data, uint32_t size);
+void uart_debug_attach(serial_t *obj, size_t (*write)(serial_t *obj, const uint8_t *data, uint32_t size));
+uint32_t uart_debug_dropped(void);
+void uart_flush_all(void);
 
 #ifdef __cplusplus
 }
@@ -49,9 +49,7 @@
 #include "uart_emul.h"
 #include "digital_io.h"
 #include "interrupt.h"
-#include "Arduino.h"
 
-#if defined(TIM1_BASE) && defined(UART_EMUL_RX) && defined(UART_EMUL_TX)
 #ifdef __cplusplus
  extern "C" {
 #endif
@@ -64,8 +62,20 @@
   * @{
   */
 
-/// @brief number of received characters
-#define EMUL_TIMER_PERIOD 100
+/// @brief two instances per timer: channels 1/2 and 3/4 (TX/RX)
+#define UART_EMUL_TIMER_NB      ((NB_UART_EMUL_MANAGED + 1) / 2)
+
+/// @brief bit timing: above the other core interrupts (EXTI use 6)
+#define UART_EMUL_IRQ_PRIORITY  1
+
+/// @brief shortest bit period in timer ticks, sampling error < 2%
+#define UART_EMUL_MIN_BIT_TICKS 32
+
+#if defined(EXTI_IMR1_IM0)
+#define UART_EMUL_EXTI_IMR      (EXTI->IMR1)
+#else
+#define UART_EMUL_EXTI_IMR      (EXTI->IMR)
+#endif
 
 /**
   * @}
@@ -75,27 +85,49 @@
   * @{
   */
 
-/// @brief defines the global attributes of the UART
+struct uart_emul_conf_s;
+
+/// @brief free running counter shared by two instances, the compare
+/// interrupts of the channels give the bit timings
 typedef struct {
-  UART_Emul_TypeDef uartEmul_typedef;
+  stimer_t timer;           // must be first, see uart_emul_timer_irq()
+  uint32_t tickFreq;
+  struct uart_emul_conf_s *uart[2];
+} uart_emul_timer_t;
+
+/// @brief defines the global attributes of the UART
+typedef struct uart_emul_conf_s {
   PinName pin_tx;
   PinName pin_rx;
-  void (*uart_rx_irqHandle)(void);
+  GPIO_TypeDef *port_tx;
+  GPIO_TypeDef *port_rx;
+  uint16_t mask_tx;
+  uint16_t mask_rx;
+  uart_emul_timer_t *tim;   // NULL when not initialized
+  uint32_t channel_tx;
+  uint32_t channel_rx;
+  uint16_t bitTicks;
+  uint8_t wordLength;
+  uint8_t parity;
+  uint8_t stopBits;
+  uint8_t frameLength;      // start, data, parity and stop bits
+  // reception
   uint8_t rxpData[UART_RCV_SIZE];
   volatile uint32_t data_available;
   volatile uint8_t begin;
   volatile uint8_t end;
-  uart_option_e uart_option;
-  stimer_t *_timer;
-}uart_emul_conf_t;
-
-/**
-  * @}
-  */
-
-/** @addtogroup STM32F4xx_System_Private_Macros
-  * @{
-  */
+  volatile uint8_t overflow;
+  volatile uint16_t rxFrame;
+  volatile uint8_t rxBit;
+  // transmission
+  uint8_t txpData[UART_EMUL_TX_SIZE];
+  volatile uint8_t txBegin;
+  volatile uint8_t txEnd;
+  volatile uint8_t txActive;
+  uint16_t txFrame;
+  uint8_t txBit;
+  void (*rx_irqHandle)(void);
+} uart_emul_conf_t;
 
 /**
   * @}
@@ -105,23 +137,34 @@ typedef struct {
   * @{
   */
 /// @brief uart caracteristics
-static UART_Emul_HandleTypeDef g_UartEmulHandle[NB_UART_EMUL_MANAGED];
-
-static uart_emul_conf_t g_uartEmul_config[NB_UART_EMUL_MANAGED] = {
-  {
-    .uartEmul_typedef = {UART1_EMUL_E},
-	.pin_tx = UART_EMUL_TX, .pin_rx = UART_EMUL_RX,
-    .uart_rx_irqHandle = NULL,
-    .data_available = 0,
-    .begin = 0,
-    .end = 0,
-    .uart_option = EMULATED_UART_E,
-    ._timer = NULL
-  }
-};
+static uart_emul_conf_t g_uartEmul_config[NB_UART_EMUL_MANAGED];
 
-//@brief just a simple buffer for the uart reception
-uint8_t g_rx_data[1];
+static uart_emul_timer_t g_uartEmul_timer[UART_EMUL_TIMER_NB];
+
+/// @brief timers able to run the emulation, by order of preference
+static TIM_TypeDef * const g_uartEmul_timer_list[] = {
+#if defined(TIMER_UART_EMULATED)
+  TIMER_UART_EMULATED,
+#endif
+#if defined(TIM3_BASE)
+  TIM3,
+#endif
+#if defined(TIM4_BASE)
+  TIM4,
+#endif
+#if defined(TIM5_BASE)
+  TIM5,
+#endif
+#if defined(TIM1_BASE)
+  TIM1,
+#endif
+#if defined(TIM8_BASE)
+  TIM8,
+#endif
+#if defined(TIM2_BASE)
+  TIM2,
+#endif
+};
 
 /**
   * @}
@@ -130,7 +173,16 @@ uint8_t g_rx_data[1];
 /** @addtogroup STM32F4xx_System_Private_FunctionPrototypes
   * @{
   */
-static void uart_emul_timer_irq(stimer_t *obj) {UNUSED(obj); g_uartEmul_config[UART1_EMUL_E].uart_rx_irqHandle();}
+static void uart_emul_rx_edge(uart_emul_id_e uart_id);
+static void uart_emul_rx_edge1(void) {uart_emul_rx_edge(UART1_EMUL_E);}
+static void uart_emul_rx_edge2(void) {uart_emul_rx_edge(UART2_EMUL_E);}
+static void uart_emul_rx_edge3(void) {uart_emul_rx_edge(UART3_EMUL_E);}
+static void uart_emul_rx_edge4(void) {uart_emul_rx_edge(UART4_EMUL_E);}
+
+/// @brief EXTI callbacks have no parameter: one per instance
+static void (* const g_uartEmul_rx_edge[NB_UART_EMUL_MANAGED])(void) = {
+  uart_emul_rx_edge1, uart_emul_rx_edge2, uart_emul_rx_edge3, uart_emul_rx_edge4
+};
 
 /**
   * @}
@@ -142,97 +194,213 @@ static void uart_emul_timer_irq(stimer_t *obj) {UNUSED(obj); g_uartEmul_config[U
 
 /******************************* EMULATED UART ********************************/
 /**
-  * @brief  Initializes the UART Emulation MSP.
-  * @param  huart: UART Emulation Handle
+  * @brief  Compare interrupt of a channel: next bit of an instance
+  * @param  obj : timer object, first member of a uart_emul_timer_t
+  * @param  channel : 0 to 3 for the channels 1 to 4
   * @retval None
   */
-void HAL_UART_Emul_MspInit(UART_Emul_HandleTypeDef *huart)
-{
-  GPIO_InitTypeDef          GPIO_InitStruct;
-  GPIO_TypeDef *port_rx;
-  GPIO_TypeDef *port_tx;
-  UNUSED(huart);
-
-  // Enable GPIO clock
-  port_rx = set_GPIO_Port_Clock(STM_PORT(g_uartEmul_config[UART1_EMUL_E].pin_rx));
-  port_tx = set_GPIO_Port_Clock(STM_PORT(g_uartEmul_config[UART1_EMUL_E].pin_tx));
-
-  // Enable GPIO TX/RX clock
-  __UART_EMUL_CLK_ENABLE();
-
-  // Enable GPIO TX/RX clock
-  GPIO_InitStruct.Pin = STM_GPIO_PIN(g_uartEmul_config[UART1_EMUL_E].pin_tx);
-  GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
-  GPIO_InitStruct.Pull = GPIO_PULLUP;
-  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
-
-  // UART TX GPIO pin configuration
-  HAL_GPIO_Init(port_tx, &GPIO_InitStruct);
-
-  GPIO_InitStruct.Pin = STM_GPIO_PIN(g_uartEmul_config[UART1_EMUL_E].pin_rx);
-  GPIO_InitStruct.Mode = GPIO_MODE_IT_FALLING;
-
-  // UART RX GPIO pin configuration
-  HAL_GPIO_Init(port_rx, &GPIO_InitStruct);
-  stm32_interrupt_enable(port_rx, STM_GPIO_PIN(g_uartEmul_config[UART1_EMUL_E].pin_rx),
-                          UART_EMUL_EXTI_RX, GPIO_MODE_IT_FALLING);
-  /*HAL_NVIC_SetPriority(EXTI15_10_IRQn, 0, 0);
-  HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);*/
-}
+static void uart_emul_timer_irq(stimer_t *obj, uint32_t channel);
 
 /**
- * @brief  UART Emulation MSP DeInit.
- * @param  huart: UART Emulation handle
- * @retval None
- */
-void HAL_UART_Emul_MspDeInit(UART_Emul_HandleTypeDef *huart)
+  * @brief  Reserve the timer channels of an instance, a timer already used
+  *         by another instance is shared
+  * @param  uart : instance
+  * @retval 1 if done, 0 if no timer is available
+  */
+static uint8_t uart_emul_timer_get(uart_emul_conf_t *uart)
 {
-  GPIO_TypeDef *port_rx = get_GPIO_Port(STM_PORT(g_uartEmul_config[UART1_EMUL_E].pin_rx));
-  GPIO_TypeDef *port_tx = get_GPIO_Port(STM_PORT(g_uartEmul_config[UART1_EMUL_E].pin_tx));
-  UNUSED(huart);
+  TIM_OC_InitTypeDef sConfig = {};
+  TIM_HandleTypeDef *handle;
+  uart_emul_timer_t *tim = NULL;
+  TIM_TypeDef *instance = NULL;
+  uint32_t prescaler;
+  uint8_t pair = 0;
+  uint8_t i;
+
+  // Timer used by another instance with free channels
+  for(i = 0; (i < UART_EMUL_TIMER_NB) && (tim == NULL); i++) {
+    if(g_uartEmul_timer[i].timer.timer != NULL) {
+      for(pair = 0; pair < 2; pair++) {
+        if(g_uartEmul_timer[i].uart[pair] == NULL) {
+          tim = &g_uartEmul_timer[i];
+          break;
+        }
+      }
+    }
+  }
 
-  __UART_EMUL_CLK_DISABLE();
+  if(tim == NULL) {
+    for(i = 0; (i < UART_EMUL_TIMER_NB) && (tim == NULL); i++) {
+      if(g_uartEmul_timer[i].timer.timer == NULL) {
+        tim = &g_uartEmul_timer[i];
+      }
+    }
+    if(tim == NULL) {
+      return 0;
+    }
+    for(i = 0; i < sizeof(g_uartEmul_timer_list) / sizeof(g_uartEmul_timer_list[0]); i++) {
+      if(IS_TIM_CC4_INSTANCE(g_uartEmul_timer_list[i]) &&
+         (getTimerUser(g_uartEmul_timer_list[i]) == TIMER_FREE) &&
+         TimerAcquire(g_uartEmul_timer_list[i], TIMER_USED_UART_EMUL)) {
+        instance = g_uartEmul_timer_list[i];
+        break;
+      }
+    }
+    if(instance == NULL) {
+      return 0;
+    }
 
-  HAL_GPIO_DeInit(port_tx, STM_GPIO_PIN(g_uartEmul_config[UART1_EMUL_E].pin_tx));
-  HAL_GPIO_DeInit(port_rx, STM_GPIO_PIN(g_uartEmul_config[UART1_EMUL_E].pin_rx));
+    // Free running counter, bit periods up to UART_EMUL_MIN_BAUDRATE
+    memset(tim, 0, sizeof(uart_emul_timer_t));
+    prescaler = getTimerClkFreq(instance) / (UART_EMUL_MIN_BAUDRATE * 0x10000UL) + 1;
+    tim->tickFreq = getTimerClkFreq(instance) / prescaler;
+    tim->timer.timer = instance;
+    tim->timer.irqHandleOC = uart_emul_timer_irq;
+    handle = &(tim->timer.handle);
+    handle->Instance               = instance;
+    handle->Init.Prescaler         = prescaler - 1;
+    handle->Init.Period            = 0xFFFF;
+    handle->Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
+    handle->Init.CounterMode       = TIM_COUNTERMODE_UP;
+#if !defined(STM32L0xx) && !defined(STM32L1xx)
+    handle->Init.RepetitionCounter = 0;
+#endif
+    sConfig.OCMode        = TIM_OCMODE_TIMING;
+    sConfig.OCPolarity    = TIM_OCPOLARITY_HIGH;
+    sConfig.OCFastMode    = TIM_OCFAST_DISABLE;
+#if !defined(STM32L0xx) && !defined(STM32L1xx)
+    sConfig.OCNPolarity   = TIM_OCNPOLARITY_HIGH;
+    sConfig.OCIdleState   = TIM_OCIDLESTATE_RESET;
+    sConfig.OCNIdleState  = TIM_OCNIDLESTATE_RESET;
+#endif
+    if((HAL_TIM_OC_Init(handle) != HAL_OK) ||
+       (HAL_TIM_OC_ConfigChannel(handle, &sConfig, TIM_CHANNEL_1) != HAL_OK) ||
+       (HAL_TIM_OC_ConfigChannel(handle, &sConfig, TIM_CHANNEL_2) != HAL_OK) ||
+       (HAL_TIM_OC_ConfigChannel(handle, &sConfig, TIM_CHANNEL_3) != HAL_OK) ||
+       (HAL_TIM_OC_ConfigChannel(handle, &sConfig, TIM_CHANNEL_4) != HAL_OK)) {
+      HAL_TIM_OC_DeInit(handle);
+      TimerRelease(instance, TIMER_USED_UART_EMUL);
+      tim->timer.timer = NULL;
+      return 0;
+    }
+    HAL_NVIC_SetPriority(getTimerCCIrq(instance), UART_EMUL_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(getTimerCCIrq(instance));
+    HAL_TIM_Base_Start(handle);
+    pair = 0;
+  }
 
-  stm32_interrupt_disable(port_rx, STM_GPIO_PIN(g_uartEmul_config[UART1_EMUL_E].pin_rx));
+  tim->uart[pair] = uart;
+  uart->tim = tim;
+  uart->channel_tx = (pair == 0) ? TIM_CHANNEL_1 : TIM_CHANNEL_3;
+  uart->channel_rx = (pair == 0) ? TIM_CHANNEL_2 : TIM_CHANNEL_4;
+  return 1;
 }
 
 /**
-  * @brief  Function called to initialize the emulated uart interface
-  * @param  serial_id : one of the defined serial interface
-  * @param  baudRate : baudrate to apply to the uart : 4800 or 9600 //TODO bug if baud rate > 9600
+  * @brief  Release the timer channels of an instance, the timer is stopped
+  *         when no more used
+  * @param  uart : instance
   * @retval None
   */
-void uart_emul_init(uart_emul_id_e uart_id, uint32_t baudRate)
+static void uart_emul_timer_release(uart_emul_conf_t *uart)
 {
-  GPIO_TypeDef *port_tx = get_GPIO_Port(STM_PORT(g_uartEmul_config[UART1_EMUL_E].pin_tx));
-  if(uart_id>=NB_UART_EMUL_MANAGED) {
-    return;
+  uart_emul_timer_t *tim = uart->tim;
+  TIM_HandleTypeDef *handle = &(tim->timer.handle);
+
+  __HAL_TIM_DISABLE_IT(handle, TIM_IT_CC1 << (uart->channel_tx / 4));
+  __HAL_TIM_DISABLE_IT(handle, TIM_IT_CC1 << (uart->channel_rx / 4));
+  tim->uart[(uart->channel_tx == TIM_CHANNEL_1) ? 0 : 1] = NULL;
+  uart->tim = NULL;
+
+  if((tim->uart[0] == NULL) && (tim->uart[1] == NULL)) {
+    HAL_NVIC_DisableIRQ(getTimerCCIrq(tim->timer.timer));
+    HAL_TIM_OC_DeInit(handle);
+    TimerRelease(tim->timer.timer, TIMER_USED_UART_EMUL);
+    tim->timer.timer = NULL;
   }
+}
 
-  g_UartEmulHandle[uart_id].Init.Mode         = UART_EMUL_MODE_TX_RX;
-  g_UartEmulHandle[uart_id].Init.BaudRate     = baudRate;
-  g_UartEmulHandle[uart_id].Init.WordLength   = UART_EMUL_WORDLENGTH_8B;
-  g_UartEmulHandle[uart_id].Init.StopBits     = UART_EMUL_STOPBITS_1;
-  g_UartEmulHandle[uart_id].Init.Parity       = UART_EMUL_PARITY_NONE;
-  g_UartEmulHandle[uart_id].Init.RxPinNumber  = STM_GPIO_PIN(g_uartEmul_config[UART1_EMUL_E].pin_rx);
-  g_UartEmulHandle[uart_id].Init.TxPinNumber  = STM_GPIO_PIN(g_uartEmul_config[UART1_EMUL_E].pin_tx);
-  g_UartEmulHandle[uart_id].RxPortName        = get_GPIO_Port(STM_PORT(g_uartEmul_config[UART1_EMUL_E].pin_rx));
-  g_UartEmulHandle[uart_id].TxPortName        = port_tx;
-
-  if(HAL_UART_Emul_Init(&g_UartEmulHandle[uart_id])!= HAL_OK) {
-    return;
+/**
+  * @brief  Function called to initialize an emulated uart. It uses two
+  *         channels of a timer (shared by two instances) and the EXTI line
+  *         of the RX pin.
+  * @param  uart_id : one of the emulated uart
+  * @param  rx : RX pin, NC for transmission only. Its EXTI line must not
+  *         be used by another instance or attachInterrupt().
+  * @param  tx : TX pin, NC for reception only
+  * @param  baudRate : from UART_EMUL_MIN_BAUDRATE, the highest rate depends
+  *         on the CPU frequency and on the number of instances
+  * @param  wordLength : UART_EMUL_WORDLENGTH_xB, parity bit included
+  * @param  parity : UART_EMUL_PARITY_NONE, _EVEN or _ODD
+  * @param  stopBits : UART_EMUL_STOPBITS_1 or _2
+  * @retval 1 if done, 0 if the instance is used or no timer is available
+  */
+uint8_t uart_emul_init(uart_emul_id_e uart_id, PinName rx, PinName tx, uint32_t baudRate,
+                       uint8_t wordLength, uint8_t parity, uint8_t stopBits)
+{
+  GPIO_InitTypeDef GPIO_InitStruct;
+  uart_emul_conf_t *uart;
+  uint32_t bitTicks;
+  uint8_t i;
+
+  if((uart_id >= NB_UART_EMUL_MANAGED) || (g_uartEmul_config[uart_id].tim != NULL) ||
+     ((rx == NC) && (tx == NC)) || (baudRate < UART_EMUL_MIN_BAUDRATE) ||
+     (parity > UART_EMUL_PARITY_ODD) ||
+     ((stopBits != UART_EMUL_STOPBITS_1) && (stopBits != UART_EMUL_STOPBITS_2)) ||
+     (wordLength < ((parity != UART_EMUL_PARITY_NONE) ? UART_EMUL_WORDLENGTH_6B : UART_EMUL_WORDLENGTH_5B)) ||
+     (wordLength > ((parity != UART_EMUL_PARITY_NONE) ? UART_EMUL_WORDLENGTH_9B : UART_EMUL_WORDLENGTH_8B))) {
+    return 0;
   }
-
-  if (HAL_UART_Emul_Receive_DMA(&g_UartEmulHandle[uart_id], g_rx_data, 1) != HAL_OK) {
-    return;
+  // One instance per EXTI line
+  if(rx != NC) {
+    for(i = 0; i < NB_UART_EMUL_MANAGED; i++) {
+      if((g_uartEmul_config[i].tim != NULL) && (g_uartEmul_config[i].pin_rx != NC) &&
+         (STM_GPIO_PIN(g_uartEmul_config[i].pin_rx) == STM_GPIO_PIN(rx))) {
+        return 0;
+      }
+    }
   }
 
-  uart_emul_flush(uart_id);
+  uart = &g_uartEmul_config[uart_id];
+  memset(uart, 0, sizeof(uart_emul_conf_t));
+  if(!uart_emul_timer_get(uart)) {
+    return 0;
+  }
+  bitTicks = (uart->tim->tickFreq + baudRate / 2) / baudRate;
+  if(bitTicks < UART_EMUL_MIN_BIT_TICKS) {
+    uart_emul_timer_release(uart);
+    return 0;
+  }
+  uart->bitTicks = bitTicks;
+  uart->wordLength = wordLength;
+  uart->parity = parity;
+  uart->stopBits = stopBits;
+  uart->frameLength = 1 + wordLength + stopBits;
+  uart->pin_tx = tx;
+  uart->pin_rx = rx;
 
-  HAL_GPIO_WritePin(port_tx, STM_GPIO_PIN(g_uartEmul_config[UART1_EMUL_E].pin_tx), GPIO_PIN_SET);
+  GPIO_InitStruct.Pull = GPIO_PULLUP;
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+  if(tx != NC) {
+    uart->port_tx = set_GPIO_Port_Clock(STM_PORT(tx));
+    uart->mask_tx = STM_GPIO_PIN(tx);
+    // Idle high
+    uart->port_tx->BSRR = uart->mask_tx;
+    GPIO_InitStruct.Pin = uart->mask_tx;
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+    HAL_GPIO_Init(uart->port_tx, &GPIO_InitStruct);
+  }
+  if(rx != NC) {
+    uart->port_rx = set_GPIO_Port_Clock(STM_PORT(rx));
+    uart->mask_rx = STM_GPIO_PIN(rx);
+    // Pull-up kept by stm32_interrupt_enable()
+    GPIO_InitStruct.Pin = uart->mask_rx;
+    GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
+    HAL_GPIO_Init(uart->port_rx, &GPIO_InitStruct);
+    stm32_interrupt_enable(uart->port_rx, uart->mask_rx, g_uartEmul_rx_edge[uart_id],
+                           GPIO_MODE_IT_FALLING);
+  }
+  return 1;
 }
 
 /**
@@ -242,11 +410,31 @@ void uart_emul_init(uart_emul_id_e uart_id, uint32_t baudRate)
   */
 void uart_emul_deinit(uart_emul_id_e uart_id)
 {
-  if(uart_id>=NB_UART_EMUL_MANAGED) {
+  uart_emul_conf_t *uart;
+
+  if((uart_id >= NB_UART_EMUL_MANAGED) || (g_uartEmul_config[uart_id].tim == NULL)) {
     return;
   }
+  uart = &g_uartEmul_config[uart_id];
+
+  uart_emul_timer_release(uart);
+  if(uart->pin_rx != NC) {
+    stm32_interrupt_disable(uart->port_rx, uart->mask_rx);
+    HAL_GPIO_DeInit(uart->port_rx, uart->mask_rx);
+  }
+  if(uart->pin_tx != NC) {
+    HAL_GPIO_DeInit(uart->port_tx, uart->mask_tx);
+  }
+}
 
-  HAL_UART_Emul_DeInit(&g_UartEmulHandle[uart_id]);
+/**
+  * @brief  Check if an emulated uart is initialized
+  * @param  serial_id : one of the defined serial interface
+  * @retval 1 if used
+  */
+uint8_t uart_emul_is_used(uart_emul_id_e uart_id)
+{
+  return (uart_id < NB_UART_EMUL_MANAGED) && (g_uartEmul_config[uart_id].tim != NULL);
 }
 
 /**
@@ -268,41 +456,77 @@ int uart_emul_available(uart_emul_id_e uart_id)
   * @param  serial_id : one of the defined serial interface
   * @retval The first byte of incoming serial data available (or -1 if no data is available) - int
   */
-int8_t uart_emul_read(uart_emul_id_e uart_id)
+int uart_emul_read(uart_emul_id_e uart_id)
 {
-  int8_t data = -1;
+  uart_emul_conf_t *uart;
+  int data = -1;
+  uint32_t primask;
 
   if(uart_id>=NB_UART_EMUL_MANAGED) {
     return data;
   }
+  uart = &g_uartEmul_config[uart_id];
 
-  if(g_uartEmul_config[uart_id].data_available > 0) {
+  if(uart->data_available > 0) {
 
-    data = g_uartEmul_config[uart_id].rxpData[g_uartEmul_config[uart_id].begin++];
+    data = uart->rxpData[uart->begin++];
 
-    if(g_uartEmul_config[uart_id].begin >= UART_RCV_SIZE) {
-      g_uartEmul_config[uart_id].begin = 0;
+    if(uart->begin >= UART_RCV_SIZE) {
+      uart->begin = 0;
     }
 
-    g_uartEmul_config[uart_id].data_available--;
+    primask = __get_PRIMASK();
+    __disable_irq();
+    uart->data_available--;
+    __set_PRIMASK(primask);
   }
 
   return data;
 }
 
 /**
-  * @brief  write the data on the uart
+  * @brief  write the data on the uart, waits if the transmit buffer is full
+  *         (the byte is dropped when called from an interrupt handler)
   * @param  serial_id : one of the defined serial interface
   * @param  data : byte to write
   * @retval The number of bytes written
   */
 size_t uart_emul_write(uart_emul_id_e uart_id, uint8_t data)
 {
-  if(uart_id>=NB_UART_EMUL_MANAGED) {
+  uart_emul_conf_t *uart;
+  TIM_HandleTypeDef *handle;
+  uint8_t next;
+  uint32_t primask;
+
+  if((uart_id >= NB_UART_EMUL_MANAGED) || (g_uartEmul_config[uart_id].tim == NULL) ||
+     (g_uartEmul_config[uart_id].pin_tx == NC)) {
     return 0;
   }
-
-  while(HAL_UART_Emul_Transmit_DMA(&g_UartEmulHandle[uart_id], &data, 1) != HAL_OK);
+  uart = &g_uartEmul_config[uart_id];
+  handle = &(uart->tim->timer.handle);
+
+  next = (uart->txEnd + 1) % UART_EMUL_TX_SIZE;
+  while(next == uart->txBegin) {
+    // The bits can't be sent from a handler of same or higher priority
+    if(__get_IPSR() != 0) {
+      return 0;
+    }
+  }
+  uart->txpData[uart->txEnd] = data;
+  uart->txEnd = next;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  if(!uart->txActive) {
+    // Start bit now, the next bits on the compare events
+    uart->txActive = 1;
+    uart->txBit = uart->frameLength;
+    __HAL_TIM_SET_COMPARE(handle, uart->channel_tx, __HAL_TIM_GET_COUNTER(handle));
+    uart_emul_timer_irq(&(uart->tim->timer), uart->channel_tx / 4);
+    __HAL_TIM_CLEAR_FLAG(handle, TIM_FLAG_CC1 << (uart->channel_tx / 4));
+    __HAL_TIM_ENABLE_IT(handle, TIM_IT_CC1 << (uart->channel_tx / 4));
+  }
+  __set_PRIMASK(primask);
   return 1;
 }
 
@@ -312,9 +536,9 @@ size_t uart_emul_write(uart_emul_id_e uart_id, uint8_t data)
   * @param  serial_id : one of the defined serial interface
   * @retval The first byte of incoming serial data available (or -1 if no data is available) - int
   */
-int8_t uart_emul_peek(uart_emul_id_e uart_id)
+int uart_emul_peek(uart_emul_id_e uart_id)
 {
-  int8_t data = -1;
+  int data = -1;
 
   if(uart_id>=NB_UART_EMUL_MANAGED) {
     return data;
@@ -334,13 +558,67 @@ int8_t uart_emul_peek(uart_emul_id_e uart_id)
   */
 void uart_emul_flush(uart_emul_id_e uart_id)
 {
+  uint32_t primask;
+
   if(uart_id>=NB_UART_EMUL_MANAGED) {
     return;
   }
 
+  primask = __get_PRIMASK();
+  __disable_irq();
   g_uartEmul_config[uart_id].data_available = 0;
   g_uartEmul_config[uart_id].end = 0;
   g_uartEmul_config[uart_id].begin = 0;
+  g_uartEmul_config[uart_id].overflow = 0;
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  Wait for the end of the transmission
+  * @param  serial_id : one of the defined serial interface
+  * @retval None
+  */
+void uart_emul_flush_tx(uart_emul_id_e uart_id)
+{
+  if(uart_id>=NB_UART_EMUL_MANAGED) {
+    return;
+  }
+
+  while(g_uartEmul_config[uart_id].txActive);
+}
+
+/**
+  * @brief  Check if received bytes were lost, the buffer being full
+  * @param  serial_id : one of the defined serial interface
+  * @retval 1 if bytes were lost since the previous call
+  */
+uint8_t uart_emul_overflow(uart_emul_id_e uart_id)
+{
+  uint8_t overflow;
+
+  if(uart_id>=NB_UART_EMUL_MANAGED) {
+    return 0;
+  }
+
+  overflow = g_uartEmul_config[uart_id].overflow;
+  g_uartEmul_config[uart_id].overflow = 0;
+  return overflow;
+}
+
+/**
+  * @brief  Attach a function called from the interrupt handler each time a
+  *         byte is received
+  * @param  serial_id : one of the defined serial interface
+  * @param  irqHandle : function to call, NULL to detach
+  * @retval None
+  */
+void uart_emul_attached_handler(uart_emul_id_e uart_id, void (*irqHandle)(void))
+{
+  if(uart_id>=NB_UART_EMUL_MANAGED) {
+    return;
+  }
+
+  g_uartEmul_config[uart_id].rx_irqHandle = irqHandle;
 }
 
 /**
@@ -349,61 +627,126 @@ void uart_emul_flush(uart_emul_id_e uart_id)
   * @param  byte : byte to read
   * @retval None
   */
-static void uart_emul_getc(uart_emul_id_e uart_id, uint8_t byte)
+static void uart_emul_getc(uart_emul_conf_t *uart, uint8_t byte)
 {
-  if((uart_id >= NB_UART_EMUL_MANAGED) ||
-      (g_uartEmul_config[uart_id].data_available >= UART_RCV_SIZE)) {
+  if(uart->data_available >= UART_RCV_SIZE) {
+    uart->overflow = 1;
     return;
   }
 
-  g_uartEmul_config[uart_id].rxpData[g_uartEmul_config[uart_id].end++] = byte;
-  if(g_uartEmul_config[uart_id].end >= UART_RCV_SIZE) {
-    g_uartEmul_config[uart_id].end = 0;
+  uart->rxpData[uart->end++] = byte;
+  if(uart->end >= UART_RCV_SIZE) {
+    uart->end = 0;
   }
-  g_uartEmul_config[uart_id].data_available++;
+  uart->data_available++;
 }
 
 /**
-  * @brief
-  * @param  irq : pointer to function to call
+  * @brief  Falling edge on the RX pin: start bit. The EXTI line is masked
+  *         until the stop bit, the bits are sampled in their middle.
+  * @param  uart_id : one of the emulated uart
   * @retval None
   */
-void uart_emul_attached_handler(stimer_t *obj, void (*irqHandle)(void))
+static void uart_emul_rx_edge(uart_emul_id_e uart_id)
 {
-  obj->timer = TIMER_UART_EMULATED;
-  TimerHandleInit(obj, EMUL_TIMER_PERIOD - 1, (uint16_t)(HAL_RCC_GetHCLKFreq() / 1000) - 1); //50ms
-  g_uartEmul_config[UART1_EMUL_E].uart_rx_irqHandle = irqHandle;
-  g_uartEmul_config[UART1_EMUL_E]._timer = obj;
-  attachIntHandle(obj, uart_emul_timer_irq);
+  uart_emul_conf_t *uart = &g_uartEmul_config[uart_id];
+  TIM_HandleTypeDef *handle;
+  uint32_t now;
+
+  if(uart->tim == NULL) {
+    return;
+  }
+  handle = &(uart->tim->timer.handle);
+  now = __HAL_TIM_GET_COUNTER(handle);
+
+  UART_EMUL_EXTI_IMR &= ~((uint32_t)uart->mask_rx);
+  uart->rxFrame = 0;
+  uart->rxBit = 1;
+  __HAL_TIM_SET_COMPARE(handle, uart->channel_rx, (now + uart->bitTicks + uart->bitTicks / 2) & 0xFFFF);
+  __HAL_TIM_CLEAR_FLAG(handle, TIM_FLAG_CC1 << (uart->channel_rx / 4));
+  __HAL_TIM_ENABLE_IT(handle, TIM_IT_CC1 << (uart->channel_rx / 4));
 }
 
 /**
-  * @brief  Initializes the UART Emulation Transfer Complete.
-  * @param  huart: UART Emulation Handle
+  * @brief  Transmission: output the next bit, load the next byte at the
+  *         end of the stop bits
+  * @param  uart : instance
   * @retval None
   */
-void HAL_UART_Emul_RxCpltCallback(UART_Emul_HandleTypeDef *huart)
+static void uart_emul_tx_bit(uart_emul_conf_t *uart)
 {
-  uart_emul_getc(UART1_EMUL_E, *huart->pRxBuffPtr);
-  HAL_UART_Emul_Receive_DMA(&g_UartEmulHandle[UART1_EMUL_E], g_rx_data, 1);
-
-  if(g_uartEmul_config[UART1_EMUL_E].uart_rx_irqHandle != NULL) {
-    if(uart_emul_available(UART1_EMUL_E) < (UART_RCV_SIZE / 2)) {
-      setTimerCounter((stimer_t *)g_uartEmul_config[UART1_EMUL_E]._timer->timer, 0);
+  TIM_HandleTypeDef *handle = &(uart->tim->timer.handle);
+  uint32_t compare = __HAL_TIM_GET_COMPARE(handle, uart->channel_tx) + uart->bitTicks;
+
+  if(uart->txBit >= uart->frameLength) {
+    if(uart->txBegin == uart->txEnd) {
+      __HAL_TIM_DISABLE_IT(handle, TIM_IT_CC1 << (uart->channel_tx / 4));
+      uart->txActive = 0;
+      return;
     }
-    else if(uart_emul_available(UART1_EMUL_E) < (UART_RCV_SIZE/4*3)) {
-      setTimerCounter((stimer_t *)g_uartEmul_config[UART1_EMUL_E]._timer->timer, EMUL_TIMER_PERIOD - 1);
-    }
-    else {
-      g_uartEmul_config[UART1_EMUL_E].uart_rx_irqHandle();
+    uart->txFrame = uart_emul_format_frame(uart->txpData[uart->txBegin], uart->wordLength,
+                                           uart->parity, uart->stopBits);
+    uart->txBegin = (uart->txBegin + 1) % UART_EMUL_TX_SIZE;
+    uart->txBit = 0;
+  }
+
+  if((uart->txFrame >> uart->txBit) & 1) {
+    uart->port_tx->BSRR = uart->mask_tx;
+  } else {
+    uart->port_tx->BSRR = (uint32_t)uart->mask_tx << 16;
+  }
+  uart->txBit++;
+  __HAL_TIM_SET_COMPARE(handle, uart->channel_tx, compare & 0xFFFF);
+}
+
+/**
+  * @brief  Reception: sample the current bit, store the byte after the
+  *         first stop bit and wait for the next start bit
+  * @param  uart : instance
+  * @retval None
+  */
+static void uart_emul_rx_bit(uart_emul_conf_t *uart)
+{
+  TIM_HandleTypeDef *handle = &(uart->tim->timer.handle);
+  int data;
+
+  if((uart->port_rx->IDR & uart->mask_rx) != 0) {
+    uart->rxFrame |= 1U << uart->rxBit;
+  }
+  uart->rxBit++;
+  if(uart->rxBit < uart->wordLength + 2) {
+    __HAL_TIM_SET_COMPARE(handle, uart->channel_rx,
+                          (__HAL_TIM_GET_COMPARE(handle, uart->channel_rx) + uart->bitTicks) & 0xFFFF);
+    return;
+  }
+
+  __HAL_TIM_DISABLE_IT(handle, TIM_IT_CC1 << (uart->channel_rx / 4));
+  data = uart_emul_decode_frame(uart->rxFrame, uart->wordLength, uart->parity);
+  if(data >= 0) {
+    uart_emul_getc(uart, (uint8_t)data);
+    if(uart->rx_irqHandle != NULL) {
+      uart->rx_irqHandle();
     }
   }
+  // Falling edges of the data bits are ignored
+  __HAL_GPIO_EXTI_CLEAR_IT(uart->mask_rx);
+  UART_EMUL_EXTI_IMR |= uart->mask_rx;
 }
 
-/*void HAL_UART_Emul_ErrorCallback(UART_Emul_HandleTypeDef *huart)
+static void uart_emul_timer_irq(stimer_t *obj, uint32_t channel)
 {
-  printf("UART EMUL RX ERROR\n");
-}*/
+  uart_emul_conf_t *uart = ((uart_emul_timer_t *)obj)->uart[channel / 2];
+
+  if(uart == NULL) {
+    return;
+  }
+  // Channels 1 and 3: TX, 2 and 4: RX
+  if((channel % 2) == 0) {
+    uart_emul_tx_bit(uart);
+  } else {
+    uart_emul_rx_bit(uart);
+  }
+}
 
 /**
   * @}
@@ -419,5 +762,4 @@ void HAL_UART_Emul_RxCpltCallback(UART_Emul_HandleTypeDef *huart)
 #ifdef __cplusplus
 }
 #endif
-#endif //TIM1_BASE && UART_EMUL_RX && UART_EMUL_TX
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
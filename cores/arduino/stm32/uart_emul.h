@@ -42,6 +42,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "stm32_def.h"
 #include "timer.h"
+#include "uart_emul_frame.h"
 
 #ifdef __cplusplus
  extern "C" {
@@ -50,6 +51,9 @@
 /* Exported types ------------------------------------------------------------*/
 typedef enum {
   UART1_EMUL_E = 0,
+  UART2_EMUL_E,
+  UART3_EMUL_E,
+  UART4_EMUL_E,
   NB_UART_EMUL_MANAGED
 } uart_emul_id_e;
 
@@ -61,17 +65,25 @@ typedef enum {
 
 /* Exported constants --------------------------------------------------------*/
 #define UART_RCV_SIZE 128
+#define UART_EMUL_TX_SIZE 64
+
+/* Lowest baud rate, sets the prescaler of the timers */
+#define UART_EMUL_MIN_BAUDRATE                   1200
 
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
-void uart_emul_init(uart_emul_id_e uart_id, uint32_t baudRate);
+uint8_t uart_emul_init(uart_emul_id_e uart_id, PinName rx, PinName tx, uint32_t baudRate,
+                       uint8_t wordLength, uint8_t parity, uint8_t stopBits);
 void uart_emul_deinit(uart_emul_id_e uart_id);
+uint8_t uart_emul_is_used(uart_emul_id_e uart_id);
 int uart_emul_available(uart_emul_id_e uart_id);
-int8_t uart_emul_read(uart_emul_id_e uart_id);
+int uart_emul_read(uart_emul_id_e uart_id);
 size_t uart_emul_write(uart_emul_id_e uart_id, uint8_t data);
-int8_t uart_emul_peek(uart_emul_id_e uart_id);
+int uart_emul_peek(uart_emul_id_e uart_id);
 void uart_emul_flush(uart_emul_id_e uart_id);
-void uart_emul_attached_handler(stimer_t *obj, void (*irqHandle)(void));
+void uart_emul_flush_tx(uart_emul_id_e uart_id);
+uint8_t uart_emul_overflow(uart_emul_id_e uart_id);
+void uart_emul_attached_handler(uart_emul_id_e uart_id, void (*irqHandle)(void));
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,106 @@
+/**
+  ******************************************************************************
+  * @file    uart_emul_frame.c
+  * @brief   Frame format of the emulated UART: bits of a frame,
+  *          independent of the hardware so that it can be checked on a host
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+  *
+  * Redistribution and use in source and binary forms, with or without modification,
+  * are permitted provided that the following conditions are met:
+  *   1. Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *   2. Redistributions in binary form must reproduce the above copyright notice,
+  *      this list of conditions and the following disclaimer in the documentation
+  *      and/or other materials provided with the distribution.
+  *   3. Neither the name of STMicroelectronics nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "uart_emul_frame.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+  * @brief  Build the bits of a frame, sent from bit 0 (start bit)
+  * @param  data : byte to send, the unused upper bits are ignored
+  * @param  wordLength : UART_EMUL_WORDLENGTH_xB, parity bit included
+  * @param  parity : UART_EMUL_PARITY_NONE, _EVEN or _ODD
+  * @param  stopBits : UART_EMUL_STOPBITS_1 or _2
+  * @retval frame
+  */
+uint16_t uart_emul_format_frame(uint8_t data, uint8_t wordLength, uint8_t parity, uint8_t stopBits)
+{
+  uint8_t dataBits = (parity != UART_EMUL_PARITY_NONE) ? wordLength - 1 : wordLength;
+  uint16_t frame;
+  uint8_t ones = 0;
+  uint8_t i;
+
+  data &= (uint8_t)((1U << dataBits) - 1);
+  // start bit 0 at low level
+  frame = (uint16_t)data << 1;
+  if(parity != UART_EMUL_PARITY_NONE) {
+    for(i = 0; i < dataBits; i++) {
+      ones += (data >> i) & 1;
+    }
+    if(((ones & 1) != 0) == (parity == UART_EMUL_PARITY_EVEN)) {
+      frame |= 1U << wordLength;
+    }
+  }
+  frame |= ((1U << stopBits) - 1) << (wordLength + 1);
+  return frame;
+}
+
+/**
+  * @brief  Check and extract the data of a received frame
+  * @param  frame : bits of the frame, bit 0 is the start bit
+  * @param  wordLength : UART_EMUL_WORDLENGTH_xB, parity bit included
+  * @param  parity : UART_EMUL_PARITY_NONE, _EVEN or _ODD
+  * @retval data or -1 in case of frame or parity error
+  */
+int uart_emul_decode_frame(uint16_t frame, uint8_t wordLength, uint8_t parity)
+{
+  uint8_t dataBits = (parity != UART_EMUL_PARITY_NONE) ? wordLength - 1 : wordLength;
+  uint8_t data = (frame >> 1) & ((1U << dataBits) - 1);
+  uint8_t ones = 0;
+  uint8_t i;
+
+  // start bit low, first stop bit high
+  if(((frame & 1) != 0) || (((frame >> (wordLength + 1)) & 1) == 0)) {
+    return -1;
+  }
+  if(parity != UART_EMUL_PARITY_NONE) {
+    for(i = 0; i <= dataBits; i++) {
+      ones += (frame >> (i + 1)) & 1;
+    }
+    if(((ones & 1) != 0) == (parity == UART_EMUL_PARITY_EVEN)) {
+      return -1;
+    }
+  }
+  return data;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,71 @@
+/**
+  ******************************************************************************
+  * @file    uart_emul_frame.h
+  * @brief   Header for the frame format of the emulated UART
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+  *
+  * Redistribution and use in source and binary forms, with or without modification,
+  * are permitted provided that the following conditions are met:
+  *   1. Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *   2. Redistributions in binary form must reproduce the above copyright notice,
+  *      this list of conditions and the following disclaimer in the documentation
+  *      and/or other materials provided with the distribution.
+  *   3. Neither the name of STMicroelectronics nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __UART_EMUL_FRAME_H
+#define __UART_EMUL_FRAME_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Exported constants --------------------------------------------------------*/
+/* Word length, parity bit included as on the UART peripherals */
+#define UART_EMUL_WORDLENGTH_5B                  ((uint8_t)0x05)
+#define UART_EMUL_WORDLENGTH_6B                  ((uint8_t)0x06)
+#define UART_EMUL_WORDLENGTH_7B                  ((uint8_t)0x07)
+#define UART_EMUL_WORDLENGTH_8B                  ((uint8_t)0x08)
+#define UART_EMUL_WORDLENGTH_9B                  ((uint8_t)0x09)
+
+#define UART_EMUL_STOPBITS_1                     ((uint8_t)0x01)
+#define UART_EMUL_STOPBITS_2                     ((uint8_t)0x02)
+
+#define UART_EMUL_PARITY_NONE                    ((uint8_t)0x00)
+#define UART_EMUL_PARITY_EVEN                    ((uint8_t)0x01)
+#define UART_EMUL_PARITY_ODD                     ((uint8_t)0x02)
+
+/* Exported functions ------------------------------------------------------- */
+uint16_t uart_emul_format_frame(uint8_t data, uint8_t wordLength, uint8_t parity, uint8_t stopBits);
+int uart_emul_decode_frame(uint16_t frame, uint8_t wordLength, uint8_t parity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UART_EMUL_FRAME_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
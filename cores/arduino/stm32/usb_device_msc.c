@@ -0,0 +1,31 @@
+/*
+ * <Description>
+ *
+ * Copyright (C) 2017, STMicroelectronics - All Rights Reserved
+ * Author: YOUR NAME <> for STMicroelectronics.
+ *
+ * License type: GPLv2
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 as published by
+ * the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+#ifdef USBCON
+#ifdef USBD_USE_MSC
+
+#include "usbd_msc.c"
+#include "usbd_msc_bot.c"
+#include "usbd_msc_data.c"
+#include "usbd_msc_scsi.c"
+
+#endif //USBD_USE_MSC
+#endif //USBCON
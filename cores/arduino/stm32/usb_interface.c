@@ -95,6 +95,37 @@
 #ifdef USBD_USE_HID_COMPOSITE
 static USBD_HandleTypeDef hUSBD_Device_HID;
 #endif //USBD_USE_HID_COMPOSITE
+#ifdef USBD_USE_CDC
+static USBD_HandleTypeDef hUSBD_Device_CDC;
+#endif //USBD_USE_CDC
+#ifdef USBD_USE_MSC
+static USBD_HandleTypeDef hUSBD_Device_MSC;
+
+/* Storage reported until a block device is attached: no medium */
+static int8_t usbd_msc_nomedia_init(uint8_t lun);
+static int8_t usbd_msc_nomedia_capacity(uint8_t lun, uint32_t *block_num, uint16_t *block_size);
+static int8_t usbd_msc_nomedia_status(uint8_t lun);
+static int8_t usbd_msc_nomedia_io(uint8_t lun, uint8_t *buf, uint32_t blk_addr, uint16_t blk_len);
+static int8_t usbd_msc_nomedia_maxlun(void);
+
+static int8_t usbd_msc_nomedia_inquiry[STANDARD_INQUIRY_DATA_LEN] = {
+  0x00, 0x80, 0x02, 0x02, (STANDARD_INQUIRY_DATA_LEN - 5), 0x00, 0x00, 0x00,
+  'S', 'T', 'M', '3', '2', ' ', ' ', ' ',                                 /* Manufacturer : 8 bytes */
+  'N', 'o', ' ', 'm', 'e', 'd', 'i', 'u', 'm', ' ', ' ', ' ', ' ', ' ', ' ', ' ', /* Product : 16 bytes */
+  '0', '.', '0', '1',                                                     /* Version : 4 bytes */
+};
+
+static USBD_StorageTypeDef usbd_msc_nomedia = {
+  usbd_msc_nomedia_init,
+  usbd_msc_nomedia_capacity,
+  usbd_msc_nomedia_status,
+  usbd_msc_nomedia_status,
+  usbd_msc_nomedia_io,
+  usbd_msc_nomedia_io,
+  usbd_msc_nomedia_maxlun,
+  usbd_msc_nomedia_inquiry,
+};
+#endif //USBD_USE_MSC
 /**
   * @}
   */
@@ -128,6 +159,27 @@ void usbd_interface_init(void)
   /* Start Device Process */
   USBD_Start(&hUSBD_Device_HID);
 #endif // USBD_USE_HID_COMPOSITE
+#ifdef USBD_USE_CDC
+  /* Init Device Library */
+  USBD_Init(&hUSBD_Device_CDC, &CDC_Desc, 0);
+
+  /* Add Supported Class */
+  USBD_RegisterClass(&hUSBD_Device_CDC, USBD_CDC_SERIAL_CLASS);
+
+  /* Start Device Process */
+  USBD_Start(&hUSBD_Device_CDC);
+#endif // USBD_USE_CDC
+#ifdef USBD_USE_MSC
+  /* Init Device Library */
+  USBD_Init(&hUSBD_Device_MSC, &MSC_Desc, 0);
+
+  /* Add Supported Class */
+  USBD_RegisterClass(&hUSBD_Device_MSC, USBD_MSC_CLASS);
+  USBD_MSC_RegisterStorage(&hUSBD_Device_MSC, &usbd_msc_nomedia);
+
+  /* Start Device Process */
+  USBD_Start(&hUSBD_Device_MSC);
+#endif // USBD_USE_MSC
 }
 
 /**
@@ -154,6 +206,191 @@ void usbd_interface_keyboard_sendReport(uint8_t *report, uint16_t len)
 #endif // USBD_USE_HID_COMPOSITE
 }
 
+/**
+  * @brief  the host has configured the CDC device
+  * @param  none
+  * @retval 1 if configured
+  */
+uint8_t usbd_interface_cdc_configured(void)
+{
+#ifdef USBD_USE_CDC
+  return USBD_CDC_SERIAL_Configured(&hUSBD_Device_CDC);
+#else
+  return 0;
+#endif // USBD_USE_CDC
+}
+
+/**
+  * @brief  number of bytes received on the CDC interface
+  * @param  none
+  * @retval number of bytes
+  */
+uint32_t usbd_interface_cdc_available(void)
+{
+#ifdef USBD_USE_CDC
+  return USBD_CDC_SERIAL_Available(&hUSBD_Device_CDC);
+#else
+  return 0;
+#endif // USBD_USE_CDC
+}
+
+/**
+  * @brief  next byte received on the CDC interface
+  * @param  none
+  * @retval byte or -1
+  */
+int usbd_interface_cdc_peek(void)
+{
+#ifdef USBD_USE_CDC
+  return USBD_CDC_SERIAL_Peek(&hUSBD_Device_CDC);
+#else
+  return -1;
+#endif // USBD_USE_CDC
+}
+
+/**
+  * @brief  read the bytes received on the CDC interface
+  * @param  buf : data buffer
+  * @param  len : data length
+  * @retval number of bytes read
+  */
+uint32_t usbd_interface_cdc_read(uint8_t *buf, uint32_t len)
+{
+#ifdef USBD_USE_CDC
+  return USBD_CDC_SERIAL_Read(&hUSBD_Device_CDC, buf, len);
+#else
+  UNUSED(buf);
+  UNUSED(len);
+  return 0;
+#endif // USBD_USE_CDC
+}
+
+/**
+  * @brief  queue bytes to send on the CDC interface, never waits
+  * @param  buf : data buffer
+  * @param  len : data length
+  * @retval number of bytes queued
+  */
+uint32_t usbd_interface_cdc_write(const uint8_t *buf, uint32_t len)
+{
+#ifdef USBD_USE_CDC
+  return USBD_CDC_SERIAL_Write(&hUSBD_Device_CDC, buf, len);
+#else
+  UNUSED(buf);
+  UNUSED(len);
+  return 0;
+#endif // USBD_USE_CDC
+}
+
+/**
+  * @brief  free space of the CDC transmit buffer
+  * @param  none
+  * @retval number of bytes
+  */
+uint32_t usbd_interface_cdc_write_free(void)
+{
+#ifdef USBD_USE_CDC
+  return USBD_CDC_SERIAL_WriteFree(&hUSBD_Device_CDC);
+#else
+  return 0;
+#endif // USBD_USE_CDC
+}
+
+/**
+  * @brief  CDC transmission in progress
+  * @param  none
+  * @retval 1 while data is sent
+  */
+uint8_t usbd_interface_cdc_tx_pending(void)
+{
+#ifdef USBD_USE_CDC
+  return USBD_CDC_SERIAL_TxPending(&hUSBD_Device_CDC);
+#else
+  return 0;
+#endif // USBD_USE_CDC
+}
+
+/**
+  * @brief  control line state set by the host
+  * @param  none
+  * @retval DTR (bit 0) and RTS (bit 1)
+  */
+uint16_t usbd_interface_cdc_line_state(void)
+{
+#ifdef USBD_USE_CDC
+  return USBD_CDC_SERIAL_LineState(&hUSBD_Device_CDC);
+#else
+  return 0;
+#endif // USBD_USE_CDC
+}
+
+/**
+  * @brief  baud rate set by the host
+  * @param  none
+  * @retval baud rate
+  */
+uint32_t usbd_interface_cdc_baudrate(void)
+{
+#ifdef USBD_USE_CDC
+  return USBD_CDC_SERIAL_Baudrate(&hUSBD_Device_CDC);
+#else
+  return 0;
+#endif // USBD_USE_CDC
+}
+
+#ifdef USBD_USE_MSC
+/**
+  * @brief  set the storage accessed by the host through the MSC interface.
+  *         The host sees a medium change on its next request.
+  * @param  storage : storage callbacks, NULL to remove the medium
+  * @retval none
+  */
+void usbd_interface_msc_attach(USBD_StorageTypeDef *storage)
+{
+  uint32_t primask = __get_PRIMASK();
+
+  /* The callbacks are called from the USB interrupt */
+  __disable_irq();
+  USBD_MSC_RegisterStorage(&hUSBD_Device_MSC,
+                           (storage != NULL) ? storage : &usbd_msc_nomedia);
+  __set_PRIMASK(primask);
+}
+
+static int8_t usbd_msc_nomedia_init(uint8_t lun)
+{
+  UNUSED(lun);
+  return 0;
+}
+
+static int8_t usbd_msc_nomedia_capacity(uint8_t lun, uint32_t *block_num, uint16_t *block_size)
+{
+  UNUSED(lun);
+  *block_num = 0;
+  *block_size = 512;
+  return 0;
+}
+
+static int8_t usbd_msc_nomedia_status(uint8_t lun)
+{
+  UNUSED(lun);
+  return -1;
+}
+
+static int8_t usbd_msc_nomedia_io(uint8_t lun, uint8_t *buf, uint32_t blk_addr, uint16_t blk_len)
+{
+  UNUSED(lun);
+  UNUSED(buf);
+  UNUSED(blk_addr);
+  UNUSED(blk_len);
+  return -1;
+}
+
+static int8_t usbd_msc_nomedia_maxlun(void)
+{
+  return 0;
+}
+#endif // USBD_USE_MSC
+
 /**
   * @}
   */
@@ -48,11 +48,17 @@
 #error "This board does not support (yet?) USB HID! Select 'None' in the 'Tools->USB interface' menu"
 #elif defined(USBD_USE_CDC)
 #error "This board does not support (yet?) USB CDC! Select 'None' in the 'Tools->USB interface' menu"
+#elif defined(USBD_USE_MSC)
+#error "This board does not support (yet?) USB MSC! Select 'None' in the 'Tools->USB interface' menu"
 #else
 #error "This board does not support (yet?) USB! Select 'None' in the 'Tools->USB interface' menu"
 #endif
 #endif
 #include "usbd_hid_composite.h"
+#include "usbd_cdc_serial.h"
+#ifdef USBD_USE_MSC
+#include "usbd_msc.h"
+#endif
 
 #ifdef __cplusplus
  extern "C" {
@@ -68,6 +74,20 @@ void usbd_interface_init(void);
 void usbd_interface_mouse_sendReport(uint8_t *report, uint16_t len);
 void usbd_interface_keyboard_sendReport(uint8_t *report, uint16_t len);
 
+uint8_t usbd_interface_cdc_configured(void);
+uint32_t usbd_interface_cdc_available(void);
+int usbd_interface_cdc_peek(void);
+uint32_t usbd_interface_cdc_read(uint8_t *buf, uint32_t len);
+uint32_t usbd_interface_cdc_write(const uint8_t *buf, uint32_t len);
+uint32_t usbd_interface_cdc_write_free(void);
+uint8_t usbd_interface_cdc_tx_pending(void);
+uint16_t usbd_interface_cdc_line_state(void);
+uint32_t usbd_interface_cdc_baudrate(void);
+
+#ifdef USBD_USE_MSC
+void usbd_interface_msc_attach(USBD_StorageTypeDef *storage);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,708 @@
+/**
+  ******************************************************************************
+  * @file    usbd_cdc_serial.c
+  * @brief   This file provides the CDC ACM class used by SerialUSB.
+  *
+  * @verbatim
+  *
+  *          ===================================================================
+  *                                CDC Class  Description
+  *          ===================================================================
+  *           Abstract Control Model of the "Universal Serial Bus Class
+  *           Definitions for Communications Devices" version 1.2:
+  *             - Line coding and control line state requests
+  *             - One notification endpoint, never used
+  *             - One bulk IN and one bulk OUT data endpoints
+  *
+  *           The OUT endpoint is armed again as soon as a packet is received
+  *           while one of the CDC_SERIAL_RX_PACKETS buffers is free, so the
+  *           host does not wait for the sketch to read the previous packet.
+  *           The IN transfers are made directly from the transmit ring
+  *           buffer, several packets at once, without copy.
+  *
+  *  @endverbatim
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+  *
+  * Redistribution and use in source and binary forms, with or without modification,
+  * are permitted provided that the following conditions are met:
+  *   1. Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *   2. Redistributions in binary form must reproduce the above copyright notice,
+  *      this list of conditions and the following disclaimer in the documentation
+  *      and/or other materials provided with the distribution.
+  *   3. Neither the name of STMicroelectronics nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  ******************************************************************************
+  */
+
+#ifdef USBCON
+#ifdef USBD_USE_CDC
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "usbd_cdc_serial.h"
+#include "usbd_desc.h"
+#include "usbd_ctlreq.h"
+
+/* Private function prototypes -----------------------------------------------*/
+static uint8_t  USBD_CDC_SERIAL_Init (USBD_HandleTypeDef *pdev,
+                                      uint8_t cfgidx);
+
+static uint8_t  USBD_CDC_SERIAL_DeInit (USBD_HandleTypeDef *pdev,
+                                        uint8_t cfgidx);
+
+static uint8_t  USBD_CDC_SERIAL_Setup (USBD_HandleTypeDef *pdev,
+                                       USBD_SetupReqTypedef *req);
+
+static uint8_t  USBD_CDC_SERIAL_EP0_RxReady (USBD_HandleTypeDef *pdev);
+
+static uint8_t  USBD_CDC_SERIAL_DataIn (USBD_HandleTypeDef *pdev, uint8_t epnum);
+
+static uint8_t  USBD_CDC_SERIAL_DataOut (USBD_HandleTypeDef *pdev, uint8_t epnum);
+
+static uint8_t  *USBD_CDC_SERIAL_GetCfgDesc (uint16_t *length);
+
+static uint8_t  *USBD_CDC_SERIAL_GetDeviceQualifierDesc (uint16_t *length);
+
+static void     USBD_CDC_SERIAL_StartTx (USBD_HandleTypeDef *pdev,
+                                         USBD_CDC_SERIAL_HandleTypeDef *hcdc);
+
+/* Private variables ---------------------------------------------------------*/
+USBD_ClassTypeDef  USBD_CDC_SERIAL =
+{
+  USBD_CDC_SERIAL_Init,
+  USBD_CDC_SERIAL_DeInit,
+  USBD_CDC_SERIAL_Setup,
+  NULL,                        /* EP0_TxSent */
+  USBD_CDC_SERIAL_EP0_RxReady, /* EP0_RxReady */
+  USBD_CDC_SERIAL_DataIn,      /* DataIn */
+  USBD_CDC_SERIAL_DataOut,     /* DataOut */
+  NULL,                        /* SOF */
+  NULL,
+  NULL,
+  USBD_CDC_SERIAL_GetCfgDesc,
+  USBD_CDC_SERIAL_GetCfgDesc,
+  USBD_CDC_SERIAL_GetCfgDesc,
+  USBD_CDC_SERIAL_GetDeviceQualifierDesc,
+};
+
+/* Statically allocated: the buffers are too large for the heap of the
+   smallest devices */
+static USBD_CDC_SERIAL_HandleTypeDef USBD_CDC_SERIAL_Handle;
+
+/* USB CDC device Configuration Descriptor */
+__ALIGN_BEGIN static uint8_t USBD_CDC_SERIAL_CfgDesc[USB_CDC_SERIAL_CONFIG_DESC_SIZ] __ALIGN_END =
+{
+  0x09, /* bLength: Configuration Descriptor size */
+  USB_DESC_TYPE_CONFIGURATION, /* bDescriptorType: Configuration */
+  LOBYTE(USB_CDC_SERIAL_CONFIG_DESC_SIZ), /* wTotalLength: bytes returned */
+  HIBYTE(USB_CDC_SERIAL_CONFIG_DESC_SIZ),
+  0x02,         /* bNumInterfaces: 2 interfaces */
+  0x01,         /* bConfigurationValue: Configuration value */
+  0x00,         /* iConfiguration: Index of string descriptor describing the configuration */
+  0xC0,         /* bmAttributes: self powered */
+  0x32,         /* MaxPower 100 mA */
+
+  /*---------------------------------------------------------------------------*/
+  /* Interface Descriptor */
+  /* 09 */
+  0x09,         /* bLength: Interface Descriptor size */
+  USB_DESC_TYPE_INTERFACE, /* bDescriptorType: Interface */
+  CDC_SERIAL_CMD_INTERFACE, /* bInterfaceNumber: Number of Interface */
+  0x00,         /* bAlternateSetting: Alternate setting */
+  0x01,         /* bNumEndpoints: One endpoint used */
+  0x02,         /* bInterfaceClass: Communication Interface Class */
+  0x02,         /* bInterfaceSubClass: Abstract Control Model */
+  0x01,         /* bInterfaceProtocol: Common AT commands */
+  0x00,         /* iInterface */
+
+  /* Header Functional Descriptor */
+  /* 18 */
+  0x05,         /* bLength: Endpoint Descriptor size */
+  0x24,         /* bDescriptorType: CS_INTERFACE */
+  0x00,         /* bDescriptorSubtype: Header Func Desc */
+  0x10,         /* bcdCDC: spec release number */
+  0x01,
+
+  /* Call Management Functional Descriptor */
+  /* 23 */
+  0x05,         /* bFunctionLength */
+  0x24,         /* bDescriptorType: CS_INTERFACE */
+  0x01,         /* bDescriptorSubtype: Call Management Func Desc */
+  0x00,         /* bmCapabilities: D0+D1 */
+  CDC_SERIAL_DATA_INTERFACE, /* bDataInterface */
+
+  /* ACM Functional Descriptor */
+  /* 28 */
+  0x04,         /* bFunctionLength */
+  0x24,         /* bDescriptorType: CS_INTERFACE */
+  0x02,         /* bDescriptorSubtype: Abstract Control Management desc */
+  0x02,         /* bmCapabilities: line coding and control line state */
+
+  /* Union Functional Descriptor */
+  /* 32 */
+  0x05,         /* bFunctionLength */
+  0x24,         /* bDescriptorType: CS_INTERFACE */
+  0x06,         /* bDescriptorSubtype: Union func desc */
+  CDC_SERIAL_CMD_INTERFACE,  /* bMasterInterface: Communication class interface */
+  CDC_SERIAL_DATA_INTERFACE, /* bSlaveInterface0: Data Class Interface */
+
+  /* Endpoint 2 Descriptor */
+  /* 37 */
+  0x07,         /* bLength: Endpoint Descriptor size */
+  USB_DESC_TYPE_ENDPOINT, /* bDescriptorType: Endpoint */
+  CDC_SERIAL_CMD_EP, /* bEndpointAddress */
+  0x03,         /* bmAttributes: Interrupt */
+  LOBYTE(CDC_SERIAL_CMD_PACKET_SIZE), /* wMaxPacketSize */
+  HIBYTE(CDC_SERIAL_CMD_PACKET_SIZE),
+  CDC_SERIAL_FS_BINTERVAL, /* bInterval */
+
+  /*---------------------------------------------------------------------------*/
+  /* Data class interface descriptor */
+  /* 44 */
+  0x09,         /* bLength: Endpoint Descriptor size */
+  USB_DESC_TYPE_INTERFACE, /* bDescriptorType: Interface */
+  CDC_SERIAL_DATA_INTERFACE, /* bInterfaceNumber: Number of Interface */
+  0x00,         /* bAlternateSetting: Alternate setting */
+  0x02,         /* bNumEndpoints: Two endpoints used */
+  0x0A,         /* bInterfaceClass: CDC */
+  0x00,         /* bInterfaceSubClass */
+  0x00,         /* bInterfaceProtocol */
+  0x00,         /* iInterface */
+
+  /* Endpoint OUT Descriptor */
+  /* 53 */
+  0x07,         /* bLength: Endpoint Descriptor size */
+  USB_DESC_TYPE_ENDPOINT, /* bDescriptorType: Endpoint */
+  CDC_SERIAL_OUT_EP, /* bEndpointAddress */
+  0x02,         /* bmAttributes: Bulk */
+  LOBYTE(CDC_SERIAL_DATA_PACKET_SIZE), /* wMaxPacketSize */
+  HIBYTE(CDC_SERIAL_DATA_PACKET_SIZE),
+  0x00,         /* bInterval: ignore for Bulk transfer */
+
+  /* Endpoint IN Descriptor */
+  /* 60 */
+  0x07,         /* bLength: Endpoint Descriptor size */
+  USB_DESC_TYPE_ENDPOINT, /* bDescriptorType: Endpoint */
+  CDC_SERIAL_IN_EP, /* bEndpointAddress */
+  0x02,         /* bmAttributes: Bulk */
+  LOBYTE(CDC_SERIAL_DATA_PACKET_SIZE), /* wMaxPacketSize */
+  HIBYTE(CDC_SERIAL_DATA_PACKET_SIZE),
+  0x00          /* bInterval: ignore for Bulk transfer */
+  /* 67 */
+};
+
+/* USB Standard Device Descriptor */
+__ALIGN_BEGIN static uint8_t USBD_CDC_SERIAL_DeviceQualifierDesc[USB_LEN_DEV_QUALIFIER_DESC] __ALIGN_END =
+{
+  USB_LEN_DEV_QUALIFIER_DESC,
+  USB_DESC_TYPE_DEVICE_QUALIFIER,
+  0x00,
+  0x02,
+  0x00,
+  0x00,
+  0x00,
+  0x40,
+  0x01,
+  0x00,
+};
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  USBD_CDC_SERIAL_Init
+  *         Initialize the CDC interface
+  * @param  pdev: device instance
+  * @param  cfgidx: Configuration index
+  * @retval status
+  */
+static uint8_t  USBD_CDC_SERIAL_Init (USBD_HandleTypeDef *pdev,
+                                      uint8_t cfgidx)
+{
+  USBD_CDC_SERIAL_HandleTypeDef *hcdc = &USBD_CDC_SERIAL_Handle;
+  UNUSED(cfgidx);
+
+  memset(hcdc, 0, sizeof(USBD_CDC_SERIAL_HandleTypeDef));
+  hcdc->LineCoding.bitrate = 115200;
+  hcdc->LineCoding.datatype = 8;
+  hcdc->CmdOpCode = 0xFF;
+
+  USBD_LL_OpenEP(pdev, CDC_SERIAL_IN_EP, USBD_EP_TYPE_BULK,
+                 CDC_SERIAL_DATA_PACKET_SIZE);
+  USBD_LL_OpenEP(pdev, CDC_SERIAL_OUT_EP, USBD_EP_TYPE_BULK,
+                 CDC_SERIAL_DATA_PACKET_SIZE);
+  USBD_LL_OpenEP(pdev, CDC_SERIAL_CMD_EP, USBD_EP_TYPE_INTR,
+                 CDC_SERIAL_CMD_PACKET_SIZE);
+
+  pdev->pClassData = hcdc;
+
+  /* Prepare Out endpoint to receive the first packet */
+  USBD_LL_PrepareReceive(pdev, CDC_SERIAL_OUT_EP, hcdc->RxPacket[0],
+                         CDC_SERIAL_DATA_PACKET_SIZE);
+  return USBD_OK;
+}
+
+/**
+  * @brief  USBD_CDC_SERIAL_DeInit
+  *         DeInitialize the CDC layer
+  * @param  pdev: device instance
+  * @param  cfgidx: Configuration index
+  * @retval status
+  */
+static uint8_t  USBD_CDC_SERIAL_DeInit (USBD_HandleTypeDef *pdev,
+                                        uint8_t cfgidx)
+{
+  UNUSED(cfgidx);
+
+  USBD_LL_CloseEP(pdev, CDC_SERIAL_IN_EP);
+  USBD_LL_CloseEP(pdev, CDC_SERIAL_OUT_EP);
+  USBD_LL_CloseEP(pdev, CDC_SERIAL_CMD_EP);
+
+  pdev->pClassData = NULL;
+  return USBD_OK;
+}
+
+/**
+  * @brief  USBD_CDC_SERIAL_Setup
+  *         Handle the CDC specific requests
+  * @param  pdev: instance
+  * @param  req: usb requests
+  * @retval status
+  */
+static uint8_t  USBD_CDC_SERIAL_Setup (USBD_HandleTypeDef *pdev,
+                                       USBD_SetupReqTypedef *req)
+{
+  USBD_CDC_SERIAL_HandleTypeDef *hcdc = (USBD_CDC_SERIAL_HandleTypeDef *)pdev->pClassData;
+
+  if(hcdc == NULL)
+  {
+    USBD_CtlError(pdev, req);
+    return USBD_FAIL;
+  }
+
+  switch (req->bmRequest & USB_REQ_TYPE_MASK)
+  {
+  case USB_REQ_TYPE_CLASS :
+    if (req->wLength)
+    {
+      if (req->bmRequest & 0x80)
+      {
+        if (req->bRequest != CDC_GET_LINE_CODING)
+        {
+          USBD_CtlError(pdev, req);
+          return USBD_FAIL;
+        }
+        USBD_CtlSendData(pdev, (uint8_t *)&hcdc->LineCoding,
+                         MIN(sizeof(hcdc->LineCoding), req->wLength));
+      }
+      else
+      {
+        /* Data stage handled by USBD_CDC_SERIAL_EP0_RxReady */
+        hcdc->CmdOpCode = req->bRequest;
+        hcdc->CmdLength = MIN(sizeof(hcdc->CmdBuffer), req->wLength);
+        USBD_CtlPrepareRx(pdev, hcdc->CmdBuffer, hcdc->CmdLength);
+      }
+    }
+    else
+    {
+      switch (req->bRequest)
+      {
+      case CDC_SET_CONTROL_LINE_STATE:
+        hcdc->LineState = req->wValue;
+        break;
+
+      case CDC_SEND_BREAK:
+        break;
+
+      default:
+        USBD_CtlError(pdev, req);
+        return USBD_FAIL;
+      }
+    }
+    break;
+
+  case USB_REQ_TYPE_STANDARD:
+    switch (req->bRequest)
+    {
+    case USB_REQ_GET_INTERFACE :
+      USBD_CtlSendData(pdev, (uint8_t *)&hcdc->AltSetting, 1);
+      break;
+
+    case USB_REQ_SET_INTERFACE :
+      hcdc->AltSetting = (uint8_t)(req->wValue);
+      break;
+    }
+    break;
+  }
+  return USBD_OK;
+}
+
+/**
+  * @brief  USBD_CDC_SERIAL_EP0_RxReady
+  *         Data stage of a class request received
+  * @param  pdev: device instance
+  * @retval status
+  */
+static uint8_t  USBD_CDC_SERIAL_EP0_RxReady (USBD_HandleTypeDef *pdev)
+{
+  USBD_CDC_SERIAL_HandleTypeDef *hcdc = (USBD_CDC_SERIAL_HandleTypeDef *)pdev->pClassData;
+
+  if(hcdc == NULL)
+  {
+    return USBD_FAIL;
+  }
+  if ((hcdc->CmdOpCode == CDC_SET_LINE_CODING) &&
+      (hcdc->CmdLength >= sizeof(hcdc->LineCoding)))
+  {
+    memcpy(&hcdc->LineCoding, hcdc->CmdBuffer, sizeof(hcdc->LineCoding));
+  }
+  hcdc->CmdOpCode = 0xFF;
+  return USBD_OK;
+}
+
+/**
+  * @brief  USBD_CDC_SERIAL_DataIn
+  *         IN transfer completed: the data is released from the buffer and
+  *         the next transfer started
+  * @param  pdev: device instance
+  * @param  epnum: endpoint index
+  * @retval status
+  */
+static uint8_t  USBD_CDC_SERIAL_DataIn (USBD_HandleTypeDef *pdev, uint8_t epnum)
+{
+  USBD_CDC_SERIAL_HandleTypeDef *hcdc = (USBD_CDC_SERIAL_HandleTypeDef *)pdev->pClassData;
+
+  if ((hcdc == NULL) || (epnum != (CDC_SERIAL_IN_EP & 0x7F)))
+  {
+    return USBD_OK;
+  }
+  hcdc->TxTail += hcdc->TxLength;
+  /* A transfer ending on a full packet is not finished for the host until
+     a short or zero length packet is received */
+  hcdc->TxZlp = (hcdc->TxLength != 0) &&
+                ((hcdc->TxLength % CDC_SERIAL_DATA_PACKET_SIZE) == 0);
+  USBD_CDC_SERIAL_StartTx(pdev, hcdc);
+  return USBD_OK;
+}
+
+/**
+  * @brief  USBD_CDC_SERIAL_DataOut
+  *         OUT packet received: the endpoint is armed again with the next
+  *         free packet buffer, if any
+  * @param  pdev: device instance
+  * @param  epnum: endpoint index
+  * @retval status
+  */
+static uint8_t  USBD_CDC_SERIAL_DataOut (USBD_HandleTypeDef *pdev, uint8_t epnum)
+{
+  USBD_CDC_SERIAL_HandleTypeDef *hcdc = (USBD_CDC_SERIAL_HandleTypeDef *)pdev->pClassData;
+
+  if (hcdc == NULL)
+  {
+    return USBD_FAIL;
+  }
+  hcdc->RxLength[hcdc->RxTail] = USBD_LL_GetRxDataSize(pdev, epnum);
+  hcdc->RxTail = (hcdc->RxTail + 1) % CDC_SERIAL_RX_PACKETS;
+  hcdc->RxCount++;
+  if (hcdc->RxCount < CDC_SERIAL_RX_PACKETS)
+  {
+    USBD_LL_PrepareReceive(pdev, CDC_SERIAL_OUT_EP, hcdc->RxPacket[hcdc->RxTail],
+                           CDC_SERIAL_DATA_PACKET_SIZE);
+  }
+  else
+  {
+    /* The host gets NAKs until a packet is read */
+    hcdc->RxPaused = 1;
+  }
+  return USBD_OK;
+}
+
+/**
+  * @brief  USBD_CDC_SERIAL_StartTx
+  *         Start the IN transfer of the contiguous data of the buffer.
+  *         Called from the USB interrupt or with interrupts disabled.
+  * @param  pdev: device instance
+  * @param  hcdc: class data
+  * @retval none
+  */
+static void     USBD_CDC_SERIAL_StartTx (USBD_HandleTypeDef *pdev,
+                                         USBD_CDC_SERIAL_HandleTypeDef *hcdc)
+{
+  uint32_t used = hcdc->TxHead - hcdc->TxTail;
+  uint32_t offset = hcdc->TxTail & (CDC_SERIAL_TX_BUFFER_SIZE - 1);
+  uint32_t len;
+
+  if (used == 0)
+  {
+    if (hcdc->TxZlp)
+    {
+      hcdc->TxZlp = 0;
+      hcdc->TxLength = 0;
+      hcdc->TxBusy = 1;
+      USBD_LL_Transmit(pdev, CDC_SERIAL_IN_EP, hcdc->TxBuffer, 0);
+    }
+    else
+    {
+      hcdc->TxBusy = 0;
+    }
+    return;
+  }
+  len = MIN(used, CDC_SERIAL_TX_BUFFER_SIZE - offset);
+  len = MIN(len, CDC_SERIAL_TX_MAX_TRANSFER);
+  hcdc->TxLength = len;
+  hcdc->TxBusy = 1;
+  USBD_LL_Transmit(pdev, CDC_SERIAL_IN_EP, &hcdc->TxBuffer[offset], len);
+}
+
+/**
+  * @brief  USBD_CDC_SERIAL_RxRelease
+  *         Give back the packet being read to the receive ring
+  * @param  pdev: device instance
+  * @param  hcdc: class data
+  * @retval none
+  */
+static void     USBD_CDC_SERIAL_RxRelease (USBD_HandleTypeDef *pdev,
+                                           USBD_CDC_SERIAL_HandleTypeDef *hcdc)
+{
+  uint32_t primask = __get_PRIMASK();
+
+  hcdc->RxPos = 0;
+  hcdc->RxHead = (hcdc->RxHead + 1) % CDC_SERIAL_RX_PACKETS;
+  __disable_irq();
+  hcdc->RxCount--;
+  if (hcdc->RxPaused)
+  {
+    hcdc->RxPaused = 0;
+    USBD_LL_PrepareReceive(pdev, CDC_SERIAL_OUT_EP, hcdc->RxPacket[hcdc->RxTail],
+                           CDC_SERIAL_DATA_PACKET_SIZE);
+  }
+  __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  USBD_CDC_SERIAL_GetCfgDesc
+  *         return configuration descriptor
+  * @param  length : pointer data length
+  * @retval pointer to descriptor buffer
+  */
+static uint8_t  *USBD_CDC_SERIAL_GetCfgDesc (uint16_t *length)
+{
+  *length = sizeof (USBD_CDC_SERIAL_CfgDesc);
+  return USBD_CDC_SERIAL_CfgDesc;
+}
+
+/**
+  * @brief  USBD_CDC_SERIAL_GetDeviceQualifierDesc
+  *         return Device Qualifier descriptor
+  * @param  length : pointer data length
+  * @retval pointer to descriptor buffer
+  */
+static uint8_t  *USBD_CDC_SERIAL_GetDeviceQualifierDesc (uint16_t *length)
+{
+  *length = sizeof (USBD_CDC_SERIAL_DeviceQualifierDesc);
+  return USBD_CDC_SERIAL_DeviceQualifierDesc;
+}
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  USBD_CDC_SERIAL_Configured
+  * @param  pdev: device instance
+  * @retval 1 if the host has configured the device
+  */
+uint8_t  USBD_CDC_SERIAL_Configured (USBD_HandleTypeDef *pdev)
+{
+  return (pdev->dev_state == USBD_STATE_CONFIGURED) && (pdev->pClassData != NULL);
+}
+
+/**
+  * @brief  USBD_CDC_SERIAL_Available
+  * @param  pdev: device instance
+  * @retval number of received bytes not read yet
+  */
+uint32_t USBD_CDC_SERIAL_Available (USBD_HandleTypeDef *pdev)
+{
+  USBD_CDC_SERIAL_HandleTypeDef *hcdc = (USBD_CDC_SERIAL_HandleTypeDef *)pdev->pClassData;
+  uint32_t count, total = 0;
+  uint8_t idx;
+
+  if (hcdc == NULL)
+  {
+    return 0;
+  }
+  count = hcdc->RxCount;
+  idx = hcdc->RxHead;
+  while (count--)
+  {
+    total += hcdc->RxLength[idx];
+    idx = (idx + 1) % CDC_SERIAL_RX_PACKETS;
+  }
+  return (total > hcdc->RxPos) ? total - hcdc->RxPos : 0;
+}
+
+/**
+  * @brief  USBD_CDC_SERIAL_Peek
+  * @param  pdev: device instance
+  * @retval next received byte or -1 if none
+  */
+int      USBD_CDC_SERIAL_Peek (USBD_HandleTypeDef *pdev)
+{
+  USBD_CDC_SERIAL_HandleTypeDef *hcdc = (USBD_CDC_SERIAL_HandleTypeDef *)pdev->pClassData;
+
+  if (hcdc == NULL)
+  {
+    return -1;
+  }
+  /* Skip the zero length packets */
+  while ((hcdc->RxCount != 0) && (hcdc->RxPos >= hcdc->RxLength[hcdc->RxHead]))
+  {
+    USBD_CDC_SERIAL_RxRelease(pdev, hcdc);
+  }
+  if (hcdc->RxCount == 0)
+  {
+    return -1;
+  }
+  return hcdc->RxPacket[hcdc->RxHead][hcdc->RxPos];
+}
+
+/**
+  * @brief  USBD_CDC_SERIAL_Read
+  * @param  pdev: device instance
+  * @param  buf: destination
+  * @param  len: maximum number of bytes to read
+  * @retval number of bytes read
+  */
+uint32_t USBD_CDC_SERIAL_Read (USBD_HandleTypeDef *pdev, uint8_t *buf, uint32_t len)
+{
+  USBD_CDC_SERIAL_HandleTypeDef *hcdc = (USBD_CDC_SERIAL_HandleTypeDef *)pdev->pClassData;
+  uint32_t n = 0, chunk;
+
+  if (hcdc == NULL)
+  {
+    return 0;
+  }
+  while ((n < len) && (hcdc->RxCount != 0))
+  {
+    chunk = MIN(len - n, (uint32_t)(hcdc->RxLength[hcdc->RxHead] - hcdc->RxPos));
+    memcpy(&buf[n], &hcdc->RxPacket[hcdc->RxHead][hcdc->RxPos], chunk);
+    hcdc->RxPos += chunk;
+    n += chunk;
+    if (hcdc->RxPos >= hcdc->RxLength[hcdc->RxHead])
+    {
+      USBD_CDC_SERIAL_RxRelease(pdev, hcdc);
+    }
+  }
+  return n;
+}
+
+/**
+  * @brief  USBD_CDC_SERIAL_WriteFree
+  * @param  pdev: device instance
+  * @retval free space in the transmit buffer, 0 if not configured
+  */
+uint32_t USBD_CDC_SERIAL_WriteFree (USBD_HandleTypeDef *pdev)
+{
+  USBD_CDC_SERIAL_HandleTypeDef *hcdc = (USBD_CDC_SERIAL_HandleTypeDef *)pdev->pClassData;
+
+  if (!USBD_CDC_SERIAL_Configured(pdev))
+  {
+    return 0;
+  }
+  return CDC_SERIAL_TX_BUFFER_SIZE - (hcdc->TxHead - hcdc->TxTail);
+}
+
+/**
+  * @brief  USBD_CDC_SERIAL_Write
+  *         Copy data to the transmit buffer and start the transfer if the
+  *         endpoint is idle. Never waits.
+  * @param  pdev: device instance
+  * @param  buf: data
+  * @param  len: data length
+  * @retval number of bytes queued
+  */
+uint32_t USBD_CDC_SERIAL_Write (USBD_HandleTypeDef *pdev, const uint8_t *buf, uint32_t len)
+{
+  USBD_CDC_SERIAL_HandleTypeDef *hcdc = (USBD_CDC_SERIAL_HandleTypeDef *)pdev->pClassData;
+  uint32_t offset, chunk, primask;
+
+  len = MIN(len, USBD_CDC_SERIAL_WriteFree(pdev));
+  if (len == 0)
+  {
+    return 0;
+  }
+  offset = hcdc->TxHead & (CDC_SERIAL_TX_BUFFER_SIZE - 1);
+  chunk = MIN(len, CDC_SERIAL_TX_BUFFER_SIZE - offset);
+  memcpy(&hcdc->TxBuffer[offset], buf, chunk);
+  memcpy(hcdc->TxBuffer, &buf[chunk], len - chunk);
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  hcdc->TxHead += len;
+  if (!hcdc->TxBusy)
+  {
+    USBD_CDC_SERIAL_StartTx(pdev, hcdc);
+  }
+  __set_PRIMASK(primask);
+  return len;
+}
+
+/**
+  * @brief  USBD_CDC_SERIAL_TxPending
+  * @param  pdev: device instance
+  * @retval 1 while data is waiting or being sent
+  */
+uint8_t  USBD_CDC_SERIAL_TxPending (USBD_HandleTypeDef *pdev)
+{
+  USBD_CDC_SERIAL_HandleTypeDef *hcdc = (USBD_CDC_SERIAL_HandleTypeDef *)pdev->pClassData;
+
+  if (!USBD_CDC_SERIAL_Configured(pdev))
+  {
+    return 0;
+  }
+  return hcdc->TxBusy || (hcdc->TxHead != hcdc->TxTail);
+}
+
+/**
+  * @brief  USBD_CDC_SERIAL_LineState
+  * @param  pdev: device instance
+  * @retval last SET_CONTROL_LINE_STATE value (DTR and RTS bits)
+  */
+uint16_t USBD_CDC_SERIAL_LineState (USBD_HandleTypeDef *pdev)
+{
+  USBD_CDC_SERIAL_HandleTypeDef *hcdc = (USBD_CDC_SERIAL_HandleTypeDef *)pdev->pClassData;
+
+  return (hcdc != NULL) ? hcdc->LineState : 0;
+}
+
+/**
+  * @brief  USBD_CDC_SERIAL_Baudrate
+  * @param  pdev: device instance
+  * @retval baud rate set by the host, only informative
+  */
+uint32_t USBD_CDC_SERIAL_Baudrate (USBD_HandleTypeDef *pdev)
+{
+  USBD_CDC_SERIAL_HandleTypeDef *hcdc = (USBD_CDC_SERIAL_HandleTypeDef *)pdev->pClassData;
+
+  return (hcdc != NULL) ? hcdc->LineCoding.bitrate : 0;
+}
+
+#endif // USBD_USE_CDC
+#endif // USBCON
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
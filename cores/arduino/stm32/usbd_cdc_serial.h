@@ -0,0 +1,147 @@
+/**
+  ******************************************************************************
+  * @file    usbd_cdc_serial.h
+  * @brief   Header file for the usbd_cdc_serial.c file.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; COPYRIGHT(c) 2017 STMicroelectronics</center></h2>
+  *
+  * Redistribution and use in source and binary forms, with or without modification,
+  * are permitted provided that the following conditions are met:
+  *   1. Redistributions of source code must retain the above copyright notice,
+  *      this list of conditions and the following disclaimer.
+  *   2. Redistributions in binary form must reproduce the above copyright notice,
+  *      this list of conditions and the following disclaimer in the documentation
+  *      and/or other materials provided with the distribution.
+  *   3. Neither the name of STMicroelectronics nor the names of its contributors
+  *      may be used to endorse or promote products derived from this software
+  *      without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+  * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+  * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+  * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+  * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+  * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+  * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+  * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __USBD_CDC_SERIAL_H
+#define __USBD_CDC_SERIAL_H
+
+#ifdef USBCON
+#ifdef USBD_USE_CDC
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include  "usbd_ioreq.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define USB_CDC_SERIAL_CONFIG_DESC_SIZ  67
+
+#define CDC_SERIAL_CMD_INTERFACE        0x00
+#define CDC_SERIAL_DATA_INTERFACE       0x01
+
+#define CDC_SERIAL_IN_EP                0x81
+#define CDC_SERIAL_OUT_EP               0x01
+#define CDC_SERIAL_CMD_EP               0x82
+
+#define CDC_SERIAL_CMD_PACKET_SIZE      8
+#define CDC_SERIAL_DATA_PACKET_SIZE     64
+#define CDC_SERIAL_FS_BINTERVAL         0x10
+
+/* Number of OUT packets buffered: the next packet is received while the
+   previous ones are read */
+#ifndef CDC_SERIAL_RX_PACKETS
+#define CDC_SERIAL_RX_PACKETS           4
+#endif
+/* Transmit buffer, must be a power of 2 */
+#ifndef CDC_SERIAL_TX_BUFFER_SIZE
+#define CDC_SERIAL_TX_BUFFER_SIZE       1024
+#endif
+/* Largest IN transfer, several packets are sent without interrupt */
+#define CDC_SERIAL_TX_MAX_TRANSFER      (8 * CDC_SERIAL_DATA_PACKET_SIZE)
+
+/* CDC class requests */
+#define CDC_SEND_ENCAPSULATED_COMMAND   0x00
+#define CDC_GET_ENCAPSULATED_RESPONSE   0x01
+#define CDC_SET_LINE_CODING             0x20
+#define CDC_GET_LINE_CODING             0x21
+#define CDC_SET_CONTROL_LINE_STATE      0x22
+#define CDC_SEND_BREAK                  0x23
+
+/* SET_CONTROL_LINE_STATE bits */
+#define CDC_SERIAL_LINE_DTR             0x01
+#define CDC_SERIAL_LINE_RTS             0x02
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct
+{
+  uint32_t bitrate;
+  uint8_t  format;      /* stop bits: 0 = 1, 1 = 1.5, 2 = 2 */
+  uint8_t  paritytype;  /* 0 none, 1 odd, 2 even, 3 mark, 4 space */
+  uint8_t  datatype;    /* data bits: 5, 6, 7, 8 or 16 */
+} __attribute__((packed)) USBD_CDC_SERIAL_LineCodingTypeDef;
+
+typedef struct
+{
+  /* Receive: ring of OUT packets, filled by the interrupt */
+  uint8_t           RxPacket[CDC_SERIAL_RX_PACKETS][CDC_SERIAL_DATA_PACKET_SIZE];
+  volatile uint8_t  RxLength[CDC_SERIAL_RX_PACKETS];
+  volatile uint8_t  RxHead;     /* packet being read */
+  volatile uint8_t  RxTail;     /* packet being received */
+  volatile uint8_t  RxCount;    /* packets received not read yet */
+  volatile uint8_t  RxPaused;   /* no free packet, OUT endpoint not armed */
+  uint8_t           RxPos;      /* read position in the head packet */
+
+  /* Transmit: ring buffer, the IN transfers are made from it */
+  uint8_t           TxBuffer[CDC_SERIAL_TX_BUFFER_SIZE];
+  volatile uint32_t TxHead;     /* free running write index */
+  volatile uint32_t TxTail;     /* free running index of the transfer */
+  volatile uint32_t TxLength;   /* length of the transfer in progress */
+  volatile uint8_t  TxBusy;
+  volatile uint8_t  TxZlp;      /* last transfer ended on a full packet */
+
+  /* Control */
+  __ALIGN_BEGIN USBD_CDC_SERIAL_LineCodingTypeDef LineCoding __ALIGN_END;
+  __ALIGN_BEGIN uint8_t CmdBuffer[CDC_SERIAL_CMD_PACKET_SIZE] __ALIGN_END;
+  uint8_t           CmdOpCode;
+  uint8_t           CmdLength;
+  volatile uint16_t LineState;
+  uint32_t          AltSetting;
+} USBD_CDC_SERIAL_HandleTypeDef;
+
+/* Exported variables --------------------------------------------------------*/
+extern USBD_ClassTypeDef  USBD_CDC_SERIAL;
+#define USBD_CDC_SERIAL_CLASS    &USBD_CDC_SERIAL
+
+/* Exported functions ------------------------------------------------------- */
+uint32_t USBD_CDC_SERIAL_Available(USBD_HandleTypeDef *pdev);
+int      USBD_CDC_SERIAL_Peek(USBD_HandleTypeDef *pdev);
+uint32_t USBD_CDC_SERIAL_Read(USBD_HandleTypeDef *pdev, uint8_t *buf, uint32_t len);
+uint32_t USBD_CDC_SERIAL_Write(USBD_HandleTypeDef *pdev, const uint8_t *buf, uint32_t len);
+uint32_t USBD_CDC_SERIAL_WriteFree(USBD_HandleTypeDef *pdev);
+uint8_t  USBD_CDC_SERIAL_TxPending(USBD_HandleTypeDef *pdev);
+uint8_t  USBD_CDC_SERIAL_Configured(USBD_HandleTypeDef *pdev);
+uint16_t USBD_CDC_SERIAL_LineState(USBD_HandleTypeDef *pdev);
+uint32_t USBD_CDC_SERIAL_Baudrate(USBD_HandleTypeDef *pdev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // USBD_USE_CDC
+#endif // USBCON
+#endif  /* __USBD_CDC_SERIAL_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
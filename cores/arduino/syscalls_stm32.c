@@ -56,7 +56,6 @@
 
 #undef errno
 extern int errno ;
-extern int  _end ;
 
 /*----------------------------------------------------------------------------
  *        Exported functions
@@ -65,21 +64,7 @@ extern void _exit( int status ) ;
 extern void _kill( int pid, int sig ) ;
 extern int _getpid ( void ) ;
 
-extern caddr_t _sbrk ( int incr )
-{
-  static unsigned char *heap = NULL ;
-  unsigned char *prev_heap ;
-
-  if ( heap == NULL )
-  {
-    heap = (unsigned char *)&_end ;
-  }
-  prev_heap = heap;
-
-  heap += incr ;
-
-  return (caddr_t) prev_heap ;
-}
+/* _sbrk is in stm32/stm32_memory.c */
 
 extern int link( UNUSED(char *cOld), UNUSED(char *cNew) )
 {
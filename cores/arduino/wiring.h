@@ -47,7 +47,11 @@ extern "C"{
 #endif
 
 #ifdef __cplusplus
+#include "Coroutine.h"
+#include "StreamMatcher.h"
 #include "HardwareSerial.h"
+#include "USBSerial.h"
+#include "HardwareTimer.h"
 #include "Tone.h"
 #include "WCharacter.h"
 #include "WMath.h"
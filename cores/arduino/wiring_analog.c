@@ -89,10 +89,15 @@ void analogWrite(uint32_t ulPin, uint32_t ulValue) {
           do_init = 1;
           set_pin_configured(p, g_anOutputPinConfigured);
         }
-        ulValue = mapResolution(ulValue, _writeResolution, PWM_RESOLUTION);
-        pwm_start(p, PWM_FREQUENCY*PWM_MAX_DUTY_CYCLE,
-                   PWM_MAX_DUTY_CYCLE,
-                   ulValue, do_init);
+        if(pwm_start(p, PWM_FREQUENCY*PWM_MAX_DUTY_CYCLE,
+                     PWM_MAX_DUTY_CYCLE,
+                     mapResolution(ulValue, _writeResolution, PWM_RESOLUTION),
+                     do_init) == 0) {
+          // Timer used by another driver (Servo, Tone...): digital output
+          reset_pin_configured(p, g_anOutputPinConfigured);
+          pinMode(ulPin, OUTPUT);
+          digitalWrite(ulPin, (mapResolution(ulValue, _writeResolution, 8) < 128) ? LOW : HIGH);
+        }
       } else { //DIGITAL PIN ONLY
         // Defaults to digital write
         pinMode(ulPin, OUTPUT);
@@ -107,6 +112,86 @@ void analogWrite(uint32_t ulPin, uint32_t ulValue) {
   }
 }
 
+bool analogWriteBuffer(uint32_t ulPin, const uint16_t *buffer, uint32_t length, uint32_t sampleRate, bool loop)
+{
+#ifdef HAL_DAC_MODULE_ENABLED
+  PinName p = digitalPinToPinName(ulPin);
+  if((p != NC) && pin_in_pinmap(p, PinMap_DAC)) {
+    // Next analogWrite() initializes the channel again
+    reset_pin_configured(p, g_anOutputPinConfigured);
+    return dac_stream_start(p, (uint16_t *)buffer, length, sampleRate, loop, NULL);
+  }
+#else
+  UNUSED(ulPin);
+  UNUSED(buffer);
+  UNUSED(length);
+  UNUSED(sampleRate);
+  UNUSED(loop);
+#endif //HAL_DAC_MODULE_ENABLED
+  return false;
+}
+
+bool analogWriteStream(uint32_t ulPin, uint16_t *buffer, uint32_t length, uint32_t sampleRate,
+                       void (*refill)(uint16_t *samples, uint32_t count))
+{
+#ifdef HAL_DAC_MODULE_ENABLED
+  PinName p = digitalPinToPinName(ulPin);
+  if((p != NC) && pin_in_pinmap(p, PinMap_DAC) && (refill != NULL)) {
+    reset_pin_configured(p, g_anOutputPinConfigured);
+    return dac_stream_start(p, buffer, length, sampleRate, 1, refill);
+  }
+#else
+  UNUSED(ulPin);
+  UNUSED(buffer);
+  UNUSED(length);
+  UNUSED(sampleRate);
+  UNUSED(refill);
+#endif //HAL_DAC_MODULE_ENABLED
+  return false;
+}
+
+bool analogWriteWave(uint32_t ulPin, uint32_t wave, uint32_t frequency, uint32_t amplitude)
+{
+#ifdef HAL_DAC_MODULE_ENABLED
+  PinName p = digitalPinToPinName(ulPin);
+  if((p != NC) && pin_in_pinmap(p, PinMap_DAC) && (wave <= DAC_NOISE_WAVE)) {
+    reset_pin_configured(p, g_anOutputPinConfigured);
+    return dac_wave_start(p, (dacWave_t)wave, frequency, amplitude);
+  }
+#else
+  UNUSED(ulPin);
+  UNUSED(wave);
+  UNUSED(frequency);
+  UNUSED(amplitude);
+#endif //HAL_DAC_MODULE_ENABLED
+  return false;
+}
+
+void analogWriteStop(uint32_t ulPin)
+{
+#ifdef HAL_DAC_MODULE_ENABLED
+  PinName p = digitalPinToPinName(ulPin);
+  if(p != NC) {
+    dac_stream_stop(p);
+  }
+#else
+  UNUSED(ulPin);
+#endif //HAL_DAC_MODULE_ENABLED
+}
+
+bool analogWriteBusy(uint32_t ulPin)
+{
+#ifdef HAL_DAC_MODULE_ENABLED
+  PinName p = digitalPinToPinName(ulPin);
+  if(p != NC) {
+    return dac_stream_busy(p);
+  }
+#else
+  UNUSED(ulPin);
+#endif //HAL_DAC_MODULE_ENABLED
+  return false;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -72,6 +72,65 @@ extern void analogWriteResolution(int res);
 
 extern void analogOutputInit( void ) ;
 
+/*
+ * \brief Plays samples on a DAC pin at a timer triggered rate, transferred by DMA.
+ * Samples are 12-bit DAC values (0 to 4095), analogWriteResolution() does not apply.
+ * Uses TIM6 or TIM7, a call to analogWrite() on the pin stops the stream.
+ *
+ * \param ulPin
+ * \param buffer Samples, must stay valid while played
+ * \param length Number of samples, up to 65535
+ * \param sampleRate Samples per second, up to 1MHz
+ * \param loop Replay the buffer until analogWriteStop() if true, play it once otherwise
+ *
+ * \return false if the pin has no DAC DMA request or no trigger timer is free.
+ */
+extern bool analogWriteBuffer(uint32_t ulPin, const uint16_t *buffer, uint32_t length, uint32_t sampleRate, bool loop);
+
+/*
+ * \brief Plays a double buffered stream on a DAC pin. refill is called to fill the
+ * whole buffer before the start, then from the DMA interrupt to fill each half of
+ * the buffer while the other one is played.
+ *
+ * \param ulPin
+ * \param buffer Samples, must stay valid until analogWriteStop()
+ * \param length Number of samples, up to 65535
+ * \param sampleRate Samples per second, up to 1MHz
+ * \param refill Called with the samples to fill and their number
+ *
+ * \return false if the pin has no DAC DMA request or no trigger timer is free.
+ */
+extern bool analogWriteStream(uint32_t ulPin, uint16_t *buffer, uint32_t length, uint32_t sampleRate,
+                              void (*refill)(uint16_t *samples, uint32_t count));
+
+/*
+ * \brief Generates a waveform centered on the middle of the DAC range.
+ * DAC_TRIANGLE_WAVE and DAC_NOISE_WAVE use the DAC generators, their amplitude is
+ * rounded down to a power of 2 minus 1. DAC_SINE_WAVE is a table played by DMA.
+ *
+ * \param ulPin
+ * \param wave DAC_SINE_WAVE, DAC_TRIANGLE_WAVE or DAC_NOISE_WAVE
+ * \param frequency Signal frequency in Hz, samples per second for the noise
+ * \param amplitude Peak to peak amplitude, up to 4095
+ *
+ * \return false if the wave is not supported on this pin or no trigger timer is free.
+ */
+extern bool analogWriteWave(uint32_t ulPin, uint32_t wave, uint32_t frequency, uint32_t amplitude);
+
+/*
+ * \brief Stops the stream or wave of a DAC pin, the output keeps its last value.
+ *
+ * \param ulPin
+ */
+extern void analogWriteStop(uint32_t ulPin);
+
+/*
+ * \brief Returns true while a DAC pin plays a stream or a wave.
+ *
+ * \param ulPin
+ */
+extern bool analogWriteBusy(uint32_t ulPin);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,15 +18,155 @@
 
 #include "Arduino.h"
 
-/* Measures the length (in microseconds) of a pulse on the pin; state is HIGH
- * or LOW, the type of pulse to measure.  Works on pulses from 2-3 microseconds
- * to 3 minutes in length, but must be called at least a few dozen microseconds
- * before the start of the pulse.
- *
- * ATTENTION:
- * This function relies on micros() so cannot be used in noInterrupt() context
- */
-uint32_t pulseIn( uint32_t pin, uint32_t state, uint32_t timeout )
+// Maximum counter clock used to measure a pulse with a timer channel.
+// Prescaler is computed to not exceed it: 62.5ns resolution at 16MHz.
+#ifndef PULSEIN_TIMER_FREQ
+#define PULSEIN_TIMER_FREQ  16000000
+#endif
+
+// Number of pins which could be measured by timers at the same time
+#ifndef PULSEIN_CAPTURE_NB
+#define PULSEIN_CAPTURE_NB  4
+#endif
+
+typedef struct {
+  // Keep timer as first member: capture handlers cast stimer_t to pulseCapture_t
+  stimer_t timer;
+  bool used;
+  uint32_t pin;
+  uint32_t state;
+  uint32_t freq;
+  __IO uint32_t *portIn;
+  uint32_t bit;
+  volatile uint32_t overflows;
+  volatile uint32_t start;
+  volatile uint32_t width;
+  volatile uint32_t count;
+  volatile bool inPulse;
+} pulseCapture_t;
+
+static pulseCapture_t captures[PULSEIN_CAPTURE_NB];
+
+static inline uint32_t capturePolarity(uint32_t state)
+{
+  return (state ? TIM_INPUTCHANNELPOLARITY_RISING : TIM_INPUTCHANNELPOLARITY_FALLING);
+}
+
+static void captureOverflowIrq(stimer_t *obj)
+{
+  ((pulseCapture_t *)obj)->overflows++;
+}
+
+static void captureEdgeIrq(stimer_t *obj, uint32_t channel)
+{
+  pulseCapture_t *ctx = (pulseCapture_t *)obj;
+  uint32_t value = getCaptureRegister(obj, channel);
+  uint32_t overflows = ctx->overflows;
+
+  // Counter wrapped but update interrupt not yet handled:
+  // a low captured value belongs to the next period.
+  if(__HAL_TIM_GET_FLAG(&(obj->handle), TIM_FLAG_UPDATE) && (value < 0x8000)) {
+    overflows++;
+  }
+  value = (overflows << 16) | (value & 0xFFFF);
+
+  if(!ctx->inPulse) {
+    ctx->start = value;
+    ctx->inPulse = true;
+    setCapturePolarity(obj, channel, capturePolarity(!ctx->state));
+    // Pulse shorter than the interrupt latency: its end edge is lost
+    if((((*ctx->portIn & ctx->bit) != 0) != (ctx->state != 0)) &&
+       !__HAL_TIM_GET_FLAG(&(obj->handle), TIM_FLAG_CC1 << (channel >> 2))) {
+      ctx->inPulse = false;
+      setCapturePolarity(obj, channel, capturePolarity(ctx->state));
+    }
+  } else {
+    ctx->width = value - ctx->start;
+    ctx->count++;
+    ctx->inPulse = false;
+    setCapturePolarity(obj, channel, capturePolarity(ctx->state));
+  }
+}
+
+static pulseCapture_t *captureFind(uint32_t pin)
+{
+  for(uint8_t i = 0; i < PULSEIN_CAPTURE_NB; i++) {
+    if(captures[i].used && (captures[i].pin == pin)) {
+      return &captures[i];
+    }
+  }
+  return NULL;
+}
+
+static void captureStop(pulseCapture_t *ctx)
+{
+  TimerInputCaptureDeinit(&(ctx->timer));
+  TimerRelease(ctx->timer.timer, TIMER_USED_PULSEIN);
+  ctx->used = false;
+}
+
+// Start to measure pulses on a pin with its timer channel (see PinMap_PWM).
+// Return NULL if the pin has no timer channel or if the timer is already
+// used (PWM, Servo, Tone, another pulse measurement...), see TimerAcquire().
+static pulseCapture_t *captureStart(uint32_t pin, uint32_t state)
+{
+  pulseCapture_t *ctx = NULL;
+  PinName p = digitalPinToPinName(pin);
+  TIM_TypeDef *tim;
+  uint32_t timClkFreq;
+  uint32_t prescaler;
+
+  if(p == NC) {
+    return NULL;
+  }
+  tim = (TIM_TypeDef *)pinmap_peripheral(p, PinMap_PWM);
+  if((tim == NP) || (getTimerChannel(p) == 0) ||
+     STM_PIN_INVERTED(pinmap_function(p, PinMap_PWM))) {
+    return NULL;
+  }
+  for(uint8_t i = 0; i < PULSEIN_CAPTURE_NB; i++) {
+    if(!captures[i].used) {
+      ctx = &captures[i];
+      break;
+    }
+  }
+  // Each measurement owns its timer, a second one would reset the counter
+  if((ctx == NULL) || (getTimerUser(tim) != TIMER_FREE) ||
+     !TimerAcquire(tim, TIMER_USED_PULSEIN)) {
+    return NULL;
+  }
+
+  memset(ctx, 0, sizeof(pulseCapture_t));
+  ctx->used = true;
+  ctx->pin = pin;
+  ctx->state = state;
+  ctx->portIn = portInputRegister(digitalPinToPort(pin));
+  ctx->bit = digitalPinToBitMask(pin);
+
+  timClkFreq = getTimerClkFreq(tim);
+  prescaler = (timClkFreq + PULSEIN_TIMER_FREQ - 1) / PULSEIN_TIMER_FREQ;
+  if(prescaler == 0) {
+    prescaler = 1;
+  }
+  ctx->freq = timClkFreq / prescaler;
+
+  ctx->timer.pin = p;
+  ctx->timer.irqHandle = captureOverflowIrq;
+  // Keep the pull-up/down set by pinMode()
+  if(!TimerInputCaptureInit(&(ctx->timer), prescaler - 1, capturePolarity(state),
+                            digital_io_get_pull(p), captureEdgeIrq)) {
+    captureStop(ctx);
+    return NULL;
+  }
+  return ctx;
+}
+
+static inline uint32_t ticksToMicros(pulseCapture_t *ctx, uint32_t ticks)
+{
+  return (uint32_t)(((uint64_t)ticks * 1000000U) / ctx->freq);
+}
+
+static uint32_t pulseInPolling( uint32_t pin, uint32_t state, uint32_t timeout )
 {
   // Cache the port and bit of the pin in order to speed up the
   // pulse width measuring loop and achieve finer resolution.
@@ -57,15 +197,78 @@ uint32_t pulseIn( uint32_t pin, uint32_t state, uint32_t timeout )
   return (micros() - start);
 }
 
-/* Measures the length (in microseconds) of a pulse on the pin; state is HIGH
- * or LOW, the type of pulse to measure.  Works on pulses from 2-3 microseconds
- * to 3 minutes in length, but must be called at least a few dozen microseconds
- * before the start of the pulse.
- *
- * ATTENTION:
- * This function relies on micros() so cannot be used in noInterrupt() context
- */
+// Measure the pulse with the timer channel of the pin when available,
+// else sample the pin level in a loop.
+uint32_t pulseIn( uint32_t pin, uint32_t state, uint32_t timeout )
+{
+  uint32_t startMicros = micros();
+  pulseCapture_t *ctx = captureFind(pin);
+  bool oneShot = false;
+  uint32_t target;
+  uint32_t width = 0;
+
+  if((ctx != NULL) && (ctx->state != state)) {
+    // Pin already measured by pulseInAsync() for the other level
+    return pulseInPolling(pin, state, timeout);
+  }
+  if(ctx == NULL) {
+    ctx = captureStart(pin, state);
+    if(ctx == NULL) {
+      return pulseInPolling(pin, state, timeout);
+    }
+    oneShot = true;
+  }
+
+  // As with polling, a pulse already started is not measured
+  noInterrupts();
+  target = ctx->count + (ctx->inPulse ? 2 : 1);
+  interrupts();
+
+  while((int32_t)(ctx->count - target) < 0) {
+    if(micros() - startMicros > timeout) {
+      break;
+    }
+  }
+  if((int32_t)(ctx->count - target) >= 0) {
+    width = ticksToMicros(ctx, ctx->width);
+  }
+
+  if(oneShot) {
+    captureStop(ctx);
+  }
+  return width;
+}
+
 uint32_t pulseInLong(uint32_t pin, uint32_t state, uint32_t timeout)
 {
   return pulseIn(pin, state, timeout);
 }
+
+// Non-blocking measurement: first call starts the timer input capture,
+// then each call gives the width of the last complete pulse.
+bool pulseInAsync(uint32_t pin, uint32_t state, uint32_t &width)
+{
+  pulseCapture_t *ctx = captureFind(pin);
+
+  width = 0;
+  if((ctx != NULL) && (ctx->state != state)) {
+    captureStop(ctx);
+    ctx = NULL;
+  }
+  if(ctx == NULL) {
+    return (captureStart(pin, state) != NULL);
+  }
+  if(ctx->count != 0) {
+    width = ticksToMicros(ctx, ctx->width);
+  }
+  return true;
+}
+
+void pulseInAsyncStop(uint32_t pin)
+{
+  pulseCapture_t *ctx = captureFind(pin);
+
+  if(ctx != NULL) {
+    captureStop(ctx);
+  }
+}
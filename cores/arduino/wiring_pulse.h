@@ -28,6 +28,18 @@
  */
 extern uint32_t pulseIn( uint32_t pin, uint32_t state, uint32_t timeout = 1000000L ) ;
 extern uint32_t pulseInLong( uint32_t pin, uint32_t state, uint32_t timeout = 1000000L ) ;
+
+/*
+ * \brief Non-blocking pulse measurement, only available on pins with a timer
+ *        channel (see PinMap_PWM). First call starts the hardware capture.
+ *
+ * \param width Set to the width in microseconds of the last complete pulse,
+ *        0 if none yet.
+ * \return false if the pin could not be measured by a timer: no timer
+ *         channel, or its timer already used.
+ */
+extern bool pulseInAsync( uint32_t pin, uint32_t state, uint32_t &width ) ;
+extern void pulseInAsyncStop( uint32_t pin ) ;
 #endif
 
 #endif /* _WIRING_PULSE_ */
@@ -34,13 +34,55 @@ uint32_t micros( void )
  return GetCurrentMicro();
 }
 
+uint64_t micros64( void )
+{
+  return GetCurrentMicro64();
+}
+
+uint64_t nanos( void )
+{
+  return GetCurrentNano();
+}
+
+uint32_t cycles( void )
+{
+  return GetCurrentCycle();
+}
+
+static bool _ticklessIdle = false;
+
+void setTicklessIdle( bool enable )
+{
+  _ticklessIdle = enable;
+}
+
+// Sleep between checks: the core is woken up at least by the next tick,
+// or in tickless mode only at the deadline, the next core task or by
+// another interrupt.
 void delay( uint32_t ms )
 {
   if (ms == 0)
       return;
   uint32_t start = GetCurrentMilli();
+  uint32_t elapsed;
+  uint32_t idle;
   do {
       yield();
+      elapsed = GetCurrentMilli() - start;
+      if (elapsed >= ms)
+          break;
+      idle = ms - elapsed;
+#if defined(CORE_CALLBACK)
+      uint32_t due = CoreTaskNextDue();
+      if (due == 0)
+          continue;
+      if (due < idle)
+          idle = due;
+#endif
+      if (_ticklessIdle)
+          TimeBaseTicklessIdle(idle);
+      else
+          TimeBaseIdle();
   } while (GetCurrentMilli() - start < ms);
 }
 
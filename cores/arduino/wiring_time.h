@@ -46,6 +46,30 @@ extern uint32_t millis( void ) ;
  */
 extern uint32_t micros( void ) ;
 
+/**
+ * \brief Returns the number of microseconds since the board began running the current program.
+ *
+ * Same as micros() but on 64 bits: it never overflows, which makes it suitable for
+ * timestamping. It does not go back, even after the interrupts were masked for more than
+ * a millisecond, except on Cortex-M0/M0+ where they must not be masked for more than one.
+ */
+extern uint64_t micros64( void ) ;
+
+/**
+ * \brief Returns the number of nanoseconds since the board began running the current program.
+ *
+ * Resolution is one system clock cycle.
+ */
+extern uint64_t nanos( void ) ;
+
+/**
+ * \brief Returns the CPU cycle counter, to measure short durations: cycles() - start.
+ *
+ * On Cortex-M3/M4/M7 this is the DWT cycle counter, it does not count while the core
+ * sleeps. On Cortex-M0/M0+ it is derived from SysTick. It overflows on 32 bits.
+ */
+extern uint32_t cycles( void ) ;
+
 /**
  * \brief Pauses the program for the amount of time (in miliseconds) specified as parameter.
  * (There are 1000 milliseconds in a second.)
@@ -54,6 +78,17 @@ extern uint32_t micros( void ) ;
  */
 extern void delay( uint32_t dwMs ) ;
 
+/**
+ * \brief Enable or disable the tickless idle mode used by delay().
+ *
+ * By default delay() sleeps until the next millisecond tick. In tickless mode the
+ * tick interrupt is suppressed until the end of the delay (or until another interrupt
+ * occurs), millis() is updated on wakeup.
+ *
+ * \param enable true to enable tickless idle
+ */
+extern void setTicklessIdle( bool enable ) ;
+
 /**
  * \brief Pauses the program for the amount of time (in microseconds) specified as parameter.
  *
@@ -61,9 +96,22 @@ extern void delay( uint32_t dwMs ) ;
  */
 static inline void delayMicroseconds(uint32_t) __attribute__((always_inline, unused));
 static inline void delayMicroseconds(uint32_t usec){
+#ifdef CLOCK_DWT_CYCCNT
+  uint32_t start = DWT->CYCCNT;
+  uint32_t cyclesPerMicro = SystemCoreClock / 1000000U;
+
+  // By seconds first: the cycles of the whole delay may not fit in 32 bits
+  while(usec > 1000000U) {
+    while((DWT->CYCCNT - start) < (1000000U * cyclesPerMicro));
+    start += 1000000U * cyclesPerMicro;
+    usec -= 1000000U;
+  }
+  while((DWT->CYCCNT - start) < (usec * cyclesPerMicro));
+#else
   uint32_t start = GetCurrentMicro();
 
-  while((start+usec) > GetCurrentMicro());
+  while((GetCurrentMicro() - start) < usec);
+#endif
 }
 
 #ifdef __cplusplus
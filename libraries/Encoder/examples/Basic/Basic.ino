@@ -0,0 +1,29 @@
+/*
+  Basic
+
+  Print the position and the speed of a quadrature encoder.
+  Connect the A and B signals to two pins on the channels 1 and 2 of
+  the same timer, A0 and A1 on most Nucleo-64 boards.
+
+  This example code is in the public domain.
+*/
+
+#include "Encoder.h"
+
+Encoder knob(A0, A1);
+
+void setup() {
+  Serial.begin(9600);
+  if (!knob.isValid()) {
+    Serial.println("No encoder timer on these pins");
+  }
+}
+
+void loop() {
+  Serial.print("Position: ");
+  Serial.print((long)knob.read64());
+  Serial.print(" Speed: ");
+  Serial.print(knob.velocity());
+  Serial.println(" counts/s");
+  delay(500);
+}
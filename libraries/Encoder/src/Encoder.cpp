@@ -0,0 +1,182 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Quadrature encoder reading with the STM32 timers encoder mode.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "Encoder.h"
+
+// Encoder owning each timer, indexed as in timer.c (TIMx -> x - 1)
+static Encoder *Encoder_Handle[TIMER_NUM] = {NULL};
+
+Encoder::Encoder(uint32_t pinA, uint32_t pinB, uint8_t filter)
+{
+  PinName a = digitalPinToPinName(pinA);
+  PinName b = digitalPinToPinName(pinB);
+  TIM_TypeDef *tim;
+  uint32_t channels;
+
+  memset(&_timerObj, 0, sizeof(stimer_t));
+  _pinB = b;
+  _valid = false;
+  _counterBits = 16;
+  _overflows = 0;
+  _lastPosition = 0;
+  _lastTime = 0;
+
+  if((a == NC) || (b == NC)) {
+    return;
+  }
+  tim = (TIM_TypeDef *)pinmap_peripheral(a, PinMap_PWM);
+  if((tim == NP) || (tim != (TIM_TypeDef *)pinmap_peripheral(b, PinMap_PWM)) ||
+     !IS_TIM_ENCODER_INTERFACE_INSTANCE(tim)) {
+    return;
+  }
+  // One pin on channel 1 and the other on channel 2, not complementary outputs
+  channels = (1 << STM_PIN_CHANNEL(pinmap_function(a, PinMap_PWM))) |
+             (1 << STM_PIN_CHANNEL(pinmap_function(b, PinMap_PWM)));
+  if((channels != ((1 << 1) | (1 << 2))) ||
+     STM_PIN_INVERTED(pinmap_function(a, PinMap_PWM)) ||
+     STM_PIN_INVERTED(pinmap_function(b, PinMap_PWM))) {
+    return;
+  }
+  if((getTimerUser(tim) != TIMER_FREE) || !TimerAcquire(tim, TIMER_USED_ENCODER)) {
+    return;
+  }
+
+#if defined(IS_TIM_32B_COUNTER_INSTANCE)
+  if(IS_TIM_32B_COUNTER_INSTANCE(tim)) {
+    _counterBits = 32;
+  }
+#endif
+  Encoder_Handle[getTimerIndex(tim)] = this;
+  _timerObj.pin = a;
+  TimerEncoderInit(&_timerObj, b, GPIO_PULLUP, filter, overflowCallback);
+  _valid = true;
+}
+
+Encoder::~Encoder()
+{
+  if(!_valid) {
+    return;
+  }
+  TimerEncoderDeinit(&_timerObj, _pinB);
+  Encoder_Handle[getTimerIndex(_timerObj.timer)] = NULL;
+  TimerRelease(_timerObj.timer, TIMER_USED_ENCODER);
+  _valid = false;
+}
+
+bool Encoder::isValid(void)
+{
+  return _valid;
+}
+
+int32_t Encoder::read(void)
+{
+  return (int32_t)read64();
+}
+
+int64_t Encoder::read64(uint64_t *timestamp)
+{
+  TIM_HandleTypeDef *handle = &(_timerObj.handle);
+  uint32_t half = 1UL << (_counterBits - 1);
+  uint32_t primask;
+  int64_t overflows;
+  uint32_t count;
+
+  if(!_valid) {
+    return 0;
+  }
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  overflows = _overflows;
+  count = __HAL_TIM_GET_COUNTER(handle);
+  // Overflow not handled yet (interrupts disabled by the caller or higher
+  // priority context): the counter is read again to be sure it has wrapped.
+  if(__HAL_TIM_GET_FLAG(handle, TIM_FLAG_UPDATE) != RESET) {
+    count = __HAL_TIM_GET_COUNTER(handle);
+    overflows += (count < half) ? 1 : -1;
+  }
+  if(timestamp != NULL) {
+    *timestamp = micros64();
+  }
+  __set_PRIMASK(primask);
+
+  return overflows * ((int64_t)1 << _counterBits) + count;
+}
+
+void Encoder::write(int64_t position)
+{
+  TIM_HandleTypeDef *handle = &(_timerObj.handle);
+  uint32_t primask;
+
+  if(!_valid) {
+    return;
+  }
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  _overflows = (int32_t)(position >> _counterBits);
+  __HAL_TIM_SET_COUNTER(handle, (uint32_t)(position & (((int64_t)1 << _counterBits) - 1)));
+  __HAL_TIM_CLEAR_FLAG(handle, TIM_FLAG_UPDATE);
+  _lastPosition = position;
+  __set_PRIMASK(primask);
+}
+
+int32_t Encoder::readAndReset(void)
+{
+  int32_t position = read();
+
+  write(0);
+  return position;
+}
+
+float Encoder::velocity(void)
+{
+  uint64_t now;
+  int64_t position = read64(&now);
+  float speed = 0.0f;
+
+  if((_lastTime != 0) && (now != _lastTime)) {
+    speed = (float)(position - _lastPosition) * 1000000.0f / (float)(now - _lastTime);
+  }
+  _lastPosition = position;
+  _lastTime = now;
+  return speed;
+}
+
+// Update event: the counter wrapped, from the top to 0 when counting up,
+// from 0 to the top when counting down. The counter value gives the
+// direction even if the encoder moved back since.
+void Encoder::overflowCallback(stimer_t *obj)
+{
+  int8_t index = getTimerIndex(obj->timer);
+  Encoder *enc;
+
+  if(index < 0) {
+    return;
+  }
+  enc = Encoder_Handle[index];
+  if(enc != NULL) {
+    if(__HAL_TIM_GET_COUNTER(&(obj->handle)) < (1UL << (enc->_counterBits - 1))) {
+      enc->_overflows++;
+    } else {
+      enc->_overflows--;
+    }
+  }
+}
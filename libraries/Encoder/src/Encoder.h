@@ -0,0 +1,58 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Quadrature encoder reading with the STM32 timers encoder mode.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _ENCODER_H_
+#define _ENCODER_H_
+
+#include "Arduino.h"
+
+class Encoder {
+  public:
+    // pinA and pinB must be the channels 1 and 2 of the same timer (see
+    // PinMap_PWM), pull-ups are enabled. filter: input filter, 0 to 15.
+    Encoder(uint32_t pinA, uint32_t pinB, uint8_t filter = 0);
+    ~Encoder();
+
+    // false if the pins have no encoder capable timer or if it is used
+    bool isValid(void);
+
+    // Position in counts, 4 counts per encoder period
+    int32_t read(void);
+    // timestamp: if not NULL, time of the reading in microseconds (micros64())
+    int64_t read64(uint64_t *timestamp = NULL);
+    void write(int64_t position);
+    int32_t readAndReset(void);
+
+    // Counts per second since the previous call
+    float velocity(void);
+
+  private:
+    stimer_t _timerObj;
+    PinName _pinB;
+    bool _valid;
+    uint8_t _counterBits;         // 16 or 32
+    volatile int32_t _overflows;  // upper part of the position
+    int64_t _lastPosition;
+    uint64_t _lastTime;
+
+    static void overflowCallback(stimer_t *obj);
+};
+
+#endif // _ENCODER_H_
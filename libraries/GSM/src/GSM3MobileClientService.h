@@ -125,6 +125,7 @@ class GSM3MobileClientService : public Client
 			@param size			Buffer size
 			@return bytes read
 		 */
+		using Client::read;
 		int read(uint8_t *buf, size_t size);
 		
 		/** Read a character from response buffer
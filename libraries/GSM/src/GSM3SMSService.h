@@ -93,6 +93,7 @@ class GSM3SMSService : public Stream
 		/** Read one char for SMS buffer (advance circular buffer)
 			@return byte
 		 */
+		using Stream::read;
 		int read();
 		
 		/** Read a byte but do not advance the buffer header (circular buffer)
@@ -84,6 +84,7 @@ class GSM3ShieldV1DirectModemProvider : public GSM3ShieldV1BaseProvider, public
 			/** Read from circular buffer
 				@return character
 			 */
+			using Stream::read;
 			int read();
 			
 			/** Read from circular buffer, but do not delete it
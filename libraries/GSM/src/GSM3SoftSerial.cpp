@@ -52,8 +52,11 @@ void GSM3SoftSerial::begin(long speed)
   _activeObject=this;
   _flags=0;
 
-  uart_emul_init(UART1_EMUL_E,speed);
-  uart_emul_attached_handler(&_timer, this->handle_interrupt);
+#if defined(UART_EMUL_RX) && defined(UART_EMUL_TX)
+  uart_emul_init(UART1_EMUL_E, UART_EMUL_RX, UART_EMUL_TX, speed, UART_EMUL_WORDLENGTH_8B,
+                 UART_EMUL_PARITY_NONE, UART_EMUL_STOPBITS_1);
+  uart_emul_attached_handler(UART1_EMUL_E, this->handle_interrupt);
+#endif
 }
 
 void GSM3SoftSerial::close()
@@ -70,8 +70,6 @@ class GSM3SoftSerial : public GSM3CircularBufferManager
 
 		uint8_t _flags;
 
-		stimer_t _timer;
-
 		/** Receive
 		 */
 		void recv();
@@ -0,0 +1,39 @@
+/*
+  TimedWakeup
+
+  Blink the LED, then enter stop mode for one second.
+  The RTC wakeup timer wakes up the board, serial output is kept.
+  A button on USER_BTN also wakes it up.
+
+  This example code is in the public domain.
+*/
+
+#include "LowPower.h"
+
+volatile int pressed = 0;
+
+void onButton() {
+  pressed++;
+}
+
+void setup() {
+  Serial.begin(9600);
+  pinMode(LED_BUILTIN, OUTPUT);
+  pinMode(USER_BTN, INPUT);
+
+  LowPower.begin();
+  LowPower.attachInterruptWakeup(USER_BTN, onButton, FALLING);
+}
+
+void loop() {
+  digitalWrite(LED_BUILTIN, HIGH);
+  delay(100);
+  digitalWrite(LED_BUILTIN, LOW);
+
+  Serial.print("millis: ");
+  Serial.print(millis());
+  Serial.print(" button: ");
+  Serial.println(pressed);
+
+  LowPower.deepSleep(1000);
+}
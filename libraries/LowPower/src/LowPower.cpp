@@ -0,0 +1,69 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Low power API for STM32 boards.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "LowPower.h"
+
+STM32LowPower LowPower;
+
+STM32LowPower::STM32LowPower() :
+  _initialized(false),
+  _fromStandby(false)
+{
+}
+
+void STM32LowPower::begin(void)
+{
+  if (!_initialized) {
+    _fromStandby = LowPower_WakeUpFromStandby();
+    LowPower_init();
+    _initialized = true;
+  }
+}
+
+void STM32LowPower::idle(uint32_t ms)
+{
+  LowPower_sleep(ms);
+}
+
+void STM32LowPower::sleep(uint32_t ms)
+{
+  LowPower_sleep(ms);
+}
+
+void STM32LowPower::deepSleep(uint32_t ms)
+{
+  begin();
+  LowPower_stop(ms);
+}
+
+void STM32LowPower::shutdown(uint32_t ms)
+{
+  begin();
+  LowPower_shutdown(ms);
+}
+
+bool STM32LowPower::attachInterruptWakeup(uint32_t pin, void (*callback)(void), uint32_t mode)
+{
+  // EXTI interrupt wakes up the device from sleep and stop modes
+  attachInterrupt(pin, callback, mode);
+
+  return LowPower_EnableWakeUpPin(digitalPinToPinName(pin),
+                                  ((mode == FALLING) || (mode == LOW)) ? GPIO_MODE_IT_FALLING : GPIO_MODE_IT_RISING);
+}
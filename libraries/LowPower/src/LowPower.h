@@ -0,0 +1,65 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Low power API for STM32 boards.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _LOWPOWER_H_
+#define _LOWPOWER_H_
+
+#include "Arduino.h"
+
+#if !defined(HAL_PWR_MODULE_ENABLED)
+#error "LowPower requires HAL_PWR_MODULE_ENABLED in the variant HAL configuration"
+#endif
+
+class STM32LowPower {
+  public:
+    STM32LowPower();
+
+    // Clear standby flags and start the RTC used as wakeup timer
+    void begin(void);
+
+    // Sleep mode: core stopped, peripherals running, fast wakeup.
+    // ms = 0: until the next interrupt
+    void idle(uint32_t ms = 0);
+    void sleep(uint32_t ms = 0);
+
+    // Stop mode: all clocks stopped, RAM kept, wakeup by the RTC after ms
+    // or by a pin interrupt. ms = 0: pin interrupt only
+    void deepSleep(uint32_t ms = 0);
+
+    // Standby/shutdown mode: the board resets on wakeup by the RTC after ms
+    // or by a wakeup pin. ms = 0: wakeup pin only
+    void shutdown(uint32_t ms = 0);
+
+    // Interrupt on pin which also wakes up the device. In standby only the
+    // PWR wakeup pins (PA0, PC13...) are active, the callback is not called.
+    // Returns false if the pin cannot wake up the device from standby.
+    bool attachInterruptWakeup(uint32_t pin, void (*callback)(void), uint32_t mode);
+
+    // True if the last reset was a wakeup from standby/shutdown
+    bool wokeUpFromStandby(void) { return _fromStandby; }
+
+  private:
+    bool _initialized;
+    bool _fromStandby;
+};
+
+extern STM32LowPower LowPower;
+
+#endif /* _LOWPOWER_H_ */
@@ -27,6 +27,18 @@ static volatile int8_t timerChannel[_Nbr_16timers ];       // counter for the se
 uint8_t ServoCount = 0;                                    // the total number of attached servos
 stimer_t _timer;
 
+// Servos on a pin with a timer channel (see PinMap_PWM) are driven by hardware
+// PWM, without interrupt. The servos on the channels of a timer share its
+// HardwareTimer. The other servos are pulsed by ServoIrqHandle on TIMER_SERVO.
+typedef struct {
+  HardwareTimer *timer;
+  uint8_t count;                                           // servos using the timer
+} servoPwmTimer_t;
+
+static servoPwmTimer_t pwmTimers[TIMER_NUM];
+static HardwareTimer *servoPwm[MAX_SERVOS];                // NULL if the servo is pulsed by the ISR
+static uint8_t servoPwmChannel[MAX_SERVOS];
+
 // convenience macros
 #define SERVO_INDEX_TO_TIMER(_servo_nbr) ((timer16_Sequence_t)(_servo_nbr / SERVOS_PER_TIMER))   // returns the timer controlling this servo
 #define SERVO_INDEX_TO_CHANNEL(_servo_nbr) (_servo_nbr % SERVOS_PER_TIMER)                       // returns the index of the servo on this timer
@@ -56,6 +68,11 @@ static void ServoIrqHandle(stimer_t *obj, uint32_t channel)
   }
 
   timerChannel[SERVO_TIMER(timer_id)]++;    // increment to the next channel
+  while( SERVO_INDEX(SERVO_TIMER(timer_id),timerChannel[SERVO_TIMER(timer_id)]) < ServoCount &&
+         timerChannel[SERVO_TIMER(timer_id)] < SERVOS_PER_TIMER &&
+         servoPwm[SERVO_INDEX(SERVO_TIMER(timer_id),timerChannel[SERVO_TIMER(timer_id)])] != NULL ) {
+    timerChannel[SERVO_TIMER(timer_id)]++;  // skip the servos driven by hardware PWM
+  }
   if( SERVO_INDEX(SERVO_TIMER(timer_id),timerChannel[SERVO_TIMER(timer_id)]) < ServoCount &&
       timerChannel[SERVO_TIMER(timer_id)] < SERVOS_PER_TIMER ) {
     if(SERVO(SERVO_TIMER(timer_id),timerChannel[SERVO_TIMER(timer_id)]).Pin.isActive == true) {     // check if activated
@@ -74,31 +91,89 @@ static void ServoIrqHandle(stimer_t *obj, uint32_t channel)
   }
 }
 
-static void initISR(stimer_t *obj)
+static bool initISR(stimer_t *obj)
 {
+  // TIMER_SERVO could already be used by analogWrite, Tone, HardwareTimer...
+  if(!TimerAcquire(TIMER_SERVO, TIMER_USED_SERVO)) {
+    return false;
+  }
   /*
    * Timer clock set by default at 1us.
    * Period set to REFRESH_INTERVAL*3
    * Default pulse width set to DEFAULT_PULSE_WIDTH
    */
   TimerPulseInit(obj, REFRESH_INTERVAL*3, DEFAULT_PULSE_WIDTH, ServoIrqHandle);
+  return true;
 }
 
 static void finISR(stimer_t *obj)
 {
   TimerPulseDeinit(obj);
+  TimerRelease(TIMER_SERVO, TIMER_USED_SERVO);
 }
 
 static boolean isTimerActive(timer16_Sequence_t timer)
 {
-  // returns true if any servo is active on this timer
+  // returns true if any servo pulsed by the ISR is active on this timer
   for(uint8_t channel=0; channel < SERVOS_PER_TIMER; channel++) {
-    if(SERVO(timer,channel).Pin.isActive == true)
+    if(SERVO(timer,channel).Pin.isActive == true &&
+       servoPwm[SERVO_INDEX(timer,channel)] == NULL)
       return true;
   }
   return false;
 }
 
+static bool pwmAttach(uint8_t index, int pin)
+{
+  PinName p = digitalPinToPinName(pin);
+  TIM_TypeDef *tim;
+  HardwareTimer *timer;
+  int8_t timIndex;
+  uint8_t channel;
+
+  if ((p == NC) || !pin_in_pinmap(p, PinMap_PWM))
+    return false;
+  tim = (TIM_TypeDef *)pinmap_peripheral(p, PinMap_PWM);
+  timIndex = getTimerIndex(tim);
+  channel = STM_PIN_CHANNEL(pinmap_function(p, PinMap_PWM));
+  if ((timIndex < 0) || (channel < 1) || (channel > TIMER_CHANNELS))
+    return false;
+
+  timer = pwmTimers[timIndex].timer;
+  if (timer == NULL) {
+    timer = new HardwareTimer(tim);
+    if (!timer->isValid()) {                               // used by analogWrite, Tone...
+      delete timer;
+      return false;
+    }
+    timer->setOverflow(REFRESH_INTERVAL, MICROSEC_FORMAT); // 50Hz
+    timer->refresh();
+    timer->resume();
+    pwmTimers[timIndex].timer = timer;
+  }
+  pwmTimers[timIndex].count++;
+  servoPwm[index] = timer;
+  servoPwmChannel[index] = channel;
+
+  timer->setCaptureCompare(channel, servos[index].ticks, MICROSEC_FORMAT);
+  timer->setMode(channel, TIMER_OUTPUT_COMPARE_PWM1, p);
+  return true;
+}
+
+static void pwmDetach(uint8_t index)
+{
+  HardwareTimer *timer = servoPwm[index];
+  int8_t timIndex = getTimerIndex((TIM_TypeDef *)pinmap_peripheral(digitalPinToPinName(servos[index].Pin.nbr), PinMap_PWM));
+
+  timer->setMode(servoPwmChannel[index], TIMER_DISABLED);
+  pinMode(servos[index].Pin.nbr, OUTPUT);
+  servoPwm[index] = NULL;
+  if (--pwmTimers[timIndex].count == 0) {
+    delete timer;
+    pwmTimers[timIndex].timer = NULL;
+  }
+}
+
 /****************** end of static functions ******************************/
 
 Servo::Servo()
@@ -121,17 +196,29 @@ uint8_t Servo::attach(int pin, int min, int max)
   timer16_Sequence_t timer;
 
   if (this->servoIndex < MAX_SERVOS) {
-    pinMode(pin, OUTPUT);                                   // set servo pin to output
-    servos[this->servoIndex].Pin.nbr = pin;
-    // todo min/max check: abs(min - MIN_PULSE_WIDTH) /4 < 128
-    this->min  = (MIN_PULSE_WIDTH - min)/4; //resolution of min/max is 4 uS
-    this->max  = (MAX_PULSE_WIDTH - max)/4;
+    if (servos[this->servoIndex].Pin.isActive)
+      detach();                                             // attached to another pin
+    // hardware PWM if the pin has a free timer channel, else pulsed by the ISR
+    if (pwmAttach(this->servoIndex, pin)) {
+      servos[this->servoIndex].Pin.nbr = pin;
+      this->min  = (MIN_PULSE_WIDTH - min)/4;
+      this->max  = (MAX_PULSE_WIDTH - max)/4;
+      servos[this->servoIndex].Pin.isActive = true;
+      return this->servoIndex;
+    }
     // initialize the timer if it has not already been initialized
     timer = SERVO_INDEX_TO_TIMER(servoIndex);
     if (isTimerActive(timer) == false) {
       _timer.idx = timer;
-      initISR(&_timer);
+      if (!initISR(&_timer)) {
+        return INVALID_SERVO;                               // timer already in use
+      }
     }
+    pinMode(pin, OUTPUT);                                   // set servo pin to output
+    servos[this->servoIndex].Pin.nbr = pin;
+    // todo min/max check: abs(min - MIN_PULSE_WIDTH) /4 < 128
+    this->min  = (MIN_PULSE_WIDTH - min)/4; //resolution of min/max is 4 uS
+    this->max  = (MAX_PULSE_WIDTH - max)/4;
     servos[this->servoIndex].Pin.isActive = true;  // this must be set after the check for isTimerActive
   }
   return this->servoIndex;
@@ -141,7 +228,13 @@ void Servo::detach()
 {
   timer16_Sequence_t timer;
 
+  if (!attached())
+    return;
   servos[this->servoIndex].Pin.isActive = false;
+  if (servoPwm[this->servoIndex] != NULL) {
+    pwmDetach(this->servoIndex);
+    return;
+  }
   timer = SERVO_INDEX_TO_TIMER(servoIndex);
   if(isTimerActive(timer) == false) {
     finISR(&_timer);
@@ -175,6 +268,10 @@ void Servo::writeMicroseconds(int value)
       value = SERVO_MAX();
 
     servos[channel].ticks = value;
+    if (servoPwm[channel] != NULL) {
+      // preloaded, applied at the start of the next period
+      servoPwm[channel]->setCaptureCompare(servoPwmChannel[channel], value, MICROSEC_FORMAT);
+    }
   }
 }
 
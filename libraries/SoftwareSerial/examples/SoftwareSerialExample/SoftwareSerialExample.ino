@@ -0,0 +1,41 @@
+/*
+  SoftwareSerialExample
+
+  Forward the bytes received on two emulated serial ports to Serial, and
+  the bytes received on Serial to both ports.
+  Connect D2 to D3 and D4 to D5 to receive what is sent.
+
+  This example code is in the public domain.
+*/
+
+#include "SoftwareSerial.h"
+
+// RX, TX
+SoftwareSerial portOne(2, 3);
+SoftwareSerial portTwo(4, 5);
+
+void setup() {
+  Serial.begin(115200);
+  if (!portOne.begin(57600) || !portTwo.begin(9600, SERIAL_7E1)) {
+    Serial.println("No timer available");
+  }
+  portOne.println("Hello from port one");
+  portTwo.println("Hello from port two");
+}
+
+void loop() {
+  while (portOne.available()) {
+    Serial.write(portOne.read());
+  }
+  while (portTwo.available()) {
+    Serial.write(portTwo.read());
+  }
+  if (portOne.overflow() || portTwo.overflow()) {
+    Serial.println("Overflow");
+  }
+  while (Serial.available()) {
+    char c = Serial.read();
+    portOne.write(c);
+    portTwo.write(c);
+  }
+}
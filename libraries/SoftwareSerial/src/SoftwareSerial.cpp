@@ -0,0 +1,108 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Serial ports on any pins, emulated with the timers (see uart_emul.c).
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "SoftwareSerial.h"
+
+SoftwareSerial::SoftwareSerial(uint32_t rxPin, uint32_t txPin)
+{
+  _rx = (rxPin < NUM_DIGITAL_PINS) ? digitalPinToPinName(rxPin) : NC;
+  _tx = (txPin < NUM_DIGITAL_PINS) ? digitalPinToPinName(txPin) : NC;
+  _id = -1;
+}
+
+SoftwareSerial::~SoftwareSerial()
+{
+  end();
+}
+
+bool SoftwareSerial::begin(unsigned long speed, uint8_t config)
+{
+  // Same encoding as the AVR UCSRC register
+  uint8_t parity = UART_EMUL_PARITY_NONE;
+  uint8_t wordLength = 5 + ((config >> 1) & 0x03);
+  uint8_t stopBits = (config & 0x08) ? UART_EMUL_STOPBITS_2 : UART_EMUL_STOPBITS_1;
+  uint8_t id;
+
+  end();
+  if((config & 0x30) == 0x30) {
+    parity = UART_EMUL_PARITY_ODD;
+  } else if((config & 0x20) == 0x20) {
+    parity = UART_EMUL_PARITY_EVEN;
+  }
+  if(parity != UART_EMUL_PARITY_NONE) {
+    wordLength++;
+  }
+
+  for(id = 0; id < NB_UART_EMUL_MANAGED; id++) {
+    if(!uart_emul_is_used((uart_emul_id_e)id) &&
+       uart_emul_init((uart_emul_id_e)id, _rx, _tx, speed, wordLength, parity, stopBits)) {
+      _id = id;
+      return true;
+    }
+  }
+  return false;
+}
+
+void SoftwareSerial::end(void)
+{
+  if(_id < 0) {
+    return;
+  }
+  uart_emul_flush_tx((uart_emul_id_e)_id);
+  uart_emul_deinit((uart_emul_id_e)_id);
+  _id = -1;
+}
+
+bool SoftwareSerial::isListening(void)
+{
+  return (_id >= 0) && (_rx != NC);
+}
+
+bool SoftwareSerial::overflow(void)
+{
+  return (_id >= 0) && uart_emul_overflow((uart_emul_id_e)_id);
+}
+
+int SoftwareSerial::available(void)
+{
+  return (_id >= 0) ? uart_emul_available((uart_emul_id_e)_id) : 0;
+}
+
+int SoftwareSerial::peek(void)
+{
+  return (_id >= 0) ? uart_emul_peek((uart_emul_id_e)_id) : -1;
+}
+
+int SoftwareSerial::read(void)
+{
+  return (_id >= 0) ? uart_emul_read((uart_emul_id_e)_id) : -1;
+}
+
+void SoftwareSerial::flush(void)
+{
+  if(_id >= 0) {
+    uart_emul_flush_tx((uart_emul_id_e)_id);
+  }
+}
+
+size_t SoftwareSerial::write(uint8_t byte)
+{
+  return (_id >= 0) ? uart_emul_write((uart_emul_id_e)_id, byte) : 0;
+}
@@ -0,0 +1,62 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Serial ports on any pins, emulated with the timers (see uart_emul.c).
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _SOFTWARESERIAL_H_
+#define _SOFTWARESERIAL_H_
+
+#include "Arduino.h"
+
+class SoftwareSerial : public Stream {
+  public:
+    // rxPin or txPin could be NUM_DIGITAL_PINS to only transmit or receive.
+    // Two RX pins must not have the same number (PA1 and PB1 share an
+    // external interrupt line).
+    SoftwareSerial(uint32_t rxPin, uint32_t txPin);
+    ~SoftwareSerial();
+
+    // config: SERIAL_8N1... as HardwareSerial. Fails if all the emulated
+    // ports are used, if no timer with 4 channels is free or if the speed
+    // is too high for the timer clock.
+    bool begin(unsigned long speed, uint8_t config = SERIAL_8N1);
+    void end(void);
+
+    // All the ports receive at the same time, for compatibility only
+    bool listen(void) { return isListening(); }
+    bool isListening(void);
+    // true if received bytes were lost since the previous call
+    bool overflow(void);
+
+    virtual int available(void);
+    virtual int peek(void);
+    using Stream::read;
+    virtual int read(void);
+    // Wait for the end of the transmission
+    virtual void flush(void);
+    virtual size_t write(uint8_t byte);
+    using Print::write;
+    operator bool() { return isListening(); }
+
+  private:
+    PinName _rx;
+    PinName _tx;
+    int8_t _id;   // uart_emul_id_e, -1 if not started
+};
+
+#endif // _SOFTWARESERIAL_H_
@@ -0,0 +1,32 @@
+/*
+  LogDrive
+
+  Expose a SPI NOR flash (W25Q16, W25Q64...) as a USB drive. Select
+  'Mass storage' in the 'Tools->USB interface' menu and connect the flash
+  to the SPI pins, chip select on pin 10.
+  A blank flash must be formatted by the host the first time (FAT).
+
+  To expose the end of the internal flash instead, for example the last
+  256 KB of a 1 MB device, read only on the STM32F4:
+    FlashBlockDevice drive(0x080C0000, 0x40000);
+
+  This example code is in the public domain.
+*/
+
+#include "USBMassStorage.h"
+
+SPIFlashBlockDevice drive(10);
+
+void setup() {
+  Serial.begin(9600);
+  if (USBMassStorage.begin(drive)) {
+    Serial.print("Drive size: ");
+    Serial.print(drive.blockCount() / 2);
+    Serial.println(" KB");
+  } else {
+    Serial.println("No SPI flash found");
+  }
+}
+
+void loop() {
+}
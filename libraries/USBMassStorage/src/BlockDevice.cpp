@@ -0,0 +1,122 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Block device with a one erase unit cache, exposed by USBMassStorage.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "BlockDevice.h"
+
+BlockDevice::BlockDevice(uint8_t *cache, uint32_t eraseSize)
+{
+  _cache = cache;
+  _eraseSize = eraseSize;
+  _cacheAddr = 0;
+  _cacheValid = false;
+  _cacheDirty = false;
+}
+
+bool BlockDevice::isReadOnly(void)
+{
+  return (_cache == NULL) || (_eraseSize == 0);
+}
+
+bool BlockDevice::read(uint32_t block, uint8_t *buffer, uint32_t count)
+{
+  uint32_t addr = block * BLOCKDEVICE_BLOCK_SIZE;
+  uint32_t len = count * BLOCKDEVICE_BLOCK_SIZE;
+  uint32_t unit, n;
+
+  if((block + count) > blockCount()) {
+    return false;
+  }
+  if(isReadOnly()) {
+    return readRaw(addr, buffer, len);
+  }
+  while(len != 0) {
+    unit = addr - (addr % _eraseSize);
+    n = min(len, unit + _eraseSize - addr);
+    if(_cacheValid && (unit == _cacheAddr)) {
+      memcpy(buffer, &_cache[addr - unit], n);
+    } else if((n < _eraseSize) && !_cacheDirty) {
+      if(!readRaw(unit, _cache, _eraseSize)) {
+        _cacheValid = false;
+        return false;
+      }
+      _cacheAddr = unit;
+      _cacheValid = true;
+      memcpy(buffer, &_cache[addr - unit], n);
+    } else if(!readRaw(addr, buffer, n)) {
+      return false;
+    }
+    addr += n;
+    buffer += n;
+    len -= n;
+  }
+  return true;
+}
+
+bool BlockDevice::write(uint32_t block, const uint8_t *buffer, uint32_t count)
+{
+  uint32_t addr = block * BLOCKDEVICE_BLOCK_SIZE;
+  uint32_t len = count * BLOCKDEVICE_BLOCK_SIZE;
+  uint32_t unit, n;
+
+  if(isReadOnly() || ((block + count) > blockCount())) {
+    return false;
+  }
+  while(len != 0) {
+    unit = addr - (addr % _eraseSize);
+    n = min(len, unit + _eraseSize - addr);
+    if(!_cacheValid || (unit != _cacheAddr)) {
+      if(!sync()) {
+        return false;
+      }
+      _cacheValid = false;
+      // The unit is read only if partly overwritten
+      if((n < _eraseSize) && !readRaw(unit, _cache, _eraseSize)) {
+        return false;
+      }
+      _cacheAddr = unit;
+      _cacheValid = true;
+    }
+    memcpy(&_cache[addr - unit], buffer, n);
+    _cacheDirty = true;
+    addr += n;
+    buffer += n;
+    len -= n;
+  }
+  return true;
+}
+
+bool BlockDevice::sync(void)
+{
+  if(!_cacheDirty) {
+    return true;
+  }
+  _cacheDirty = false;
+  if(!writeUnit(_cacheAddr, _cache)) {
+    _cacheValid = false;
+    return false;
+  }
+  return true;
+}
+
+void BlockDevice::invalidate(void)
+{
+  _cacheValid = false;
+  _cacheDirty = false;
+}
@@ -0,0 +1,68 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Block device with a one erase unit cache, exposed by USBMassStorage.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _BLOCKDEVICE_H_
+#define _BLOCKDEVICE_H_
+
+#include "Arduino.h"
+
+// Size of the blocks seen by the host
+#define BLOCKDEVICE_BLOCK_SIZE  512
+
+// Base class of the storages. The memory is erased and written by units
+// (flash page or sector) of eraseSize bytes, a multiple of the block size,
+// kept in a cache:
+// - the writes of the host are coalesced in the cache and the unit is
+//   written once when another unit is written or on sync(),
+// - a partly read unit is loaded in the cache when it is not dirty, so the
+//   file system tables read again and again stay in memory.
+class BlockDevice {
+  public:
+    virtual bool begin(void) = 0;
+    // Number of BLOCKDEVICE_BLOCK_SIZE blocks
+    virtual uint32_t blockCount(void) = 0;
+    bool isReadOnly(void);
+
+    bool read(uint32_t block, uint8_t *buffer, uint32_t count);
+    bool write(uint32_t block, const uint8_t *buffer, uint32_t count);
+    // Write the cached unit if modified
+    bool sync(void);
+    // Forget the cache, the memory has been modified by another way
+    void invalidate(void);
+
+  protected:
+    // cache: eraseSize bytes, NULL for a read only device
+    BlockDevice(uint8_t *cache, uint32_t eraseSize);
+
+    // addr: offset in bytes from the start of the device
+    virtual bool readRaw(uint32_t addr, uint8_t *buffer, uint32_t len) = 0;
+    // Erase the unit at addr and program it with eraseSize bytes
+    virtual bool writeUnit(uint32_t addr, const uint8_t *data) = 0;
+
+    uint32_t _eraseSize;
+
+  private:
+    uint8_t *_cache;
+    uint32_t _cacheAddr;
+    bool _cacheValid;
+    bool _cacheDirty;
+};
+
+#endif // _BLOCKDEVICE_H_
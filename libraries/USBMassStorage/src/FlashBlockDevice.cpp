@@ -0,0 +1,117 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Block device in a region of the internal flash.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "FlashBlockDevice.h"
+
+#ifdef FLASHBLOCKDEVICE_WRITABLE
+FlashBlockDevice::FlashBlockDevice(uint32_t address, uint32_t size) :
+  BlockDevice(_page, FLASH_PAGE_SIZE)
+#else
+FlashBlockDevice::FlashBlockDevice(uint32_t address, uint32_t size) :
+  BlockDevice(NULL, 0)
+#endif
+{
+  _address = address;
+  _size = size;
+}
+
+bool FlashBlockDevice::begin(void)
+{
+  uint32_t align = isReadOnly() ? BLOCKDEVICE_BLOCK_SIZE : _eraseSize;
+
+  return (_address >= FLASH_BASE) && (_size != 0) &&
+         ((_size % align) == 0) && (isReadOnly() || ((_address % align) == 0));
+}
+
+uint32_t FlashBlockDevice::blockCount(void)
+{
+  return _size / BLOCKDEVICE_BLOCK_SIZE;
+}
+
+bool FlashBlockDevice::readRaw(uint32_t addr, uint8_t *buffer, uint32_t len)
+{
+  memcpy(buffer, (const void *)(_address + addr), len);
+  return true;
+}
+
+bool FlashBlockDevice::writeUnit(uint32_t addr, const uint8_t *data)
+{
+#ifdef FLASHBLOCKDEVICE_WRITABLE
+  FLASH_EraseInitTypeDef EraseInitStruct;
+  uint32_t address = _address + addr;
+  uint32_t pageError = 0;
+  uint64_t dword;
+  bool ok = false;
+
+  // Unchanged page: the host often writes again the same file system tables
+  if(memcmp((const void *)address, data, _eraseSize) == 0) {
+    return true;
+  }
+
+  EraseInitStruct.TypeErase = FLASH_TYPEERASE_PAGES;
+#ifdef STM32L4xx
+#ifdef FLASH_BANK_2
+  if(address >= (FLASH_BASE + FLASH_BANK_SIZE)) {
+    EraseInitStruct.Banks = FLASH_BANK_2;
+    EraseInitStruct.Page = (address - FLASH_BASE - FLASH_BANK_SIZE) / FLASH_PAGE_SIZE;
+  } else
+#endif
+  {
+    EraseInitStruct.Banks = FLASH_BANK_1;
+    EraseInitStruct.Page = (address - FLASH_BASE) / FLASH_PAGE_SIZE;
+  }
+#else
+#ifdef STM32F1xx
+#ifdef FLASH_BANK2_END
+  EraseInitStruct.Banks = (address > FLASH_BANK1_END) ? FLASH_BANK_2 : FLASH_BANK_1;
+#else
+  EraseInitStruct.Banks = FLASH_BANK_1;
+#endif
+#endif
+  EraseInitStruct.PageAddress = address;
+#endif
+  EraseInitStruct.NbPages = 1;
+
+  if(HAL_FLASH_Unlock() != HAL_OK) {
+    return false;
+  }
+#ifdef STM32L4xx
+  __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+#else
+  __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_WRPERR | FLASH_FLAG_PGERR);
+#endif
+  if(HAL_FLASHEx_Erase(&EraseInitStruct, &pageError) == HAL_OK) {
+    ok = true;
+    for(uint32_t i = 0; ok && (i < _eraseSize); i += sizeof(uint64_t)) {
+      memcpy(&dword, &data[i], sizeof(uint64_t));
+      // Erased value, nothing to program
+      if(dword != 0xFFFFFFFFFFFFFFFFULL) {
+        ok = (HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, address + i, dword) == HAL_OK);
+      }
+    }
+  }
+  HAL_FLASH_Lock();
+  return ok;
+#else
+  UNUSED(addr);
+  UNUSED(data);
+  return false;
+#endif
+}
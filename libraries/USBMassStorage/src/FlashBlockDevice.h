@@ -0,0 +1,55 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Block device in a region of the internal flash.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _FLASHBLOCKDEVICE_H_
+#define _FLASHBLOCKDEVICE_H_
+
+#include "BlockDevice.h"
+
+// Writable on the series with flash pages programmed by double words. The
+// sectors of the F2, F4 and F7 are too large to be cached, as are the
+// L0 and L1 which program by words: the region is read only there.
+#if defined(FLASH_TYPEERASE_PAGES) && defined(FLASH_TYPEPROGRAM_DOUBLEWORD) && \
+    defined(FLASH_PAGE_SIZE)
+#define FLASHBLOCKDEVICE_WRITABLE
+#endif
+
+class FlashBlockDevice : public BlockDevice {
+  public:
+    // address: start of the region, aligned on a flash page if writable
+    // size: multiple of the flash page size (or of 512 if read only)
+    FlashBlockDevice(uint32_t address, uint32_t size);
+
+    virtual bool begin(void);
+    virtual uint32_t blockCount(void);
+
+  protected:
+    virtual bool readRaw(uint32_t addr, uint8_t *buffer, uint32_t len);
+    virtual bool writeUnit(uint32_t addr, const uint8_t *data);
+
+  private:
+    uint32_t _address;
+    uint32_t _size;
+#ifdef FLASHBLOCKDEVICE_WRITABLE
+    uint8_t _page[FLASH_PAGE_SIZE] __attribute__((aligned(8)));
+#endif
+};
+
+#endif // _FLASHBLOCKDEVICE_H_
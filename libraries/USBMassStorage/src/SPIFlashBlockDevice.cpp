@@ -0,0 +1,161 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Block device on a SPI NOR flash (W25Q, MX25L, AT25SF... series).
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "SPIFlashBlockDevice.h"
+
+#define SPIFLASH_CMD_WRITE_ENABLE   0x06
+#define SPIFLASH_CMD_READ_STATUS    0x05
+#define SPIFLASH_CMD_FAST_READ      0x0B
+#define SPIFLASH_CMD_PAGE_PROGRAM   0x02
+#define SPIFLASH_CMD_SECTOR_ERASE   0x20
+#define SPIFLASH_CMD_JEDEC_ID       0x9F
+#define SPIFLASH_CMD_RELEASE_PD     0xAB
+
+#define SPIFLASH_STATUS_BUSY        0x01
+
+// Typical maximum times of the datasheets in milliseconds, with margin
+#define SPIFLASH_ERASE_TIMEOUT      500
+#define SPIFLASH_PROGRAM_TIMEOUT    10
+
+SPIFlashBlockDevice::SPIFlashBlockDevice(uint8_t csPin, SPIClass &spi, uint32_t clock) :
+  BlockDevice(_sector, SPIFLASH_SECTOR_SIZE)
+{
+  _spi = &spi;
+  _csPin = csPin;
+  _clock = clock;
+  _jedecId = 0;
+  _capacity = 0;
+}
+
+bool SPIFlashBlockDevice::begin(void)
+{
+  uint8_t id[3];
+
+  _spi->begin(_csPin);
+  _spi->beginTransaction(_csPin, SPISettings(_clock, MSBFIRST, SPI_MODE0));
+  _spi->transfer(_csPin, SPIFLASH_CMD_RELEASE_PD);
+  delayMicroseconds(50);
+
+  _spi->transfer(_csPin, SPIFLASH_CMD_JEDEC_ID, SPI_CONTINUE);
+  _spi->transfer(_csPin, id, sizeof(id));
+  _jedecId = (id[0] << 16) | (id[1] << 8) | id[2];
+
+  // Capacity code: 2^n bytes, from 64 KB to 16 MB
+  if((id[0] == 0x00) || (id[0] == 0xFF) || (id[2] < 16) || (id[2] > 24)) {
+    _capacity = 0;
+    return false;
+  }
+  _capacity = 1UL << id[2];
+  invalidate();
+  return true;
+}
+
+uint32_t SPIFlashBlockDevice::blockCount(void)
+{
+  return _capacity / BLOCKDEVICE_BLOCK_SIZE;
+}
+
+uint32_t SPIFlashBlockDevice::jedecId(void)
+{
+  return _jedecId;
+}
+
+void SPIFlashBlockDevice::command(uint8_t cmd, uint32_t addr, bool last)
+{
+  _spi->transfer(_csPin, cmd, SPI_CONTINUE);
+  _spi->transfer(_csPin, (uint8_t)(addr >> 16), SPI_CONTINUE);
+  _spi->transfer(_csPin, (uint8_t)(addr >> 8), SPI_CONTINUE);
+  _spi->transfer(_csPin, (uint8_t)addr, last ? SPI_LAST : SPI_CONTINUE);
+}
+
+// Called from the USB interrupt where millis() does not progress: the
+// status is polled every 10 microseconds.
+bool SPIFlashBlockDevice::waitReady(uint32_t timeout)
+{
+  uint8_t status;
+
+  for(uint32_t i = 0; i < (timeout * 100); i++) {
+    _spi->transfer(_csPin, SPIFLASH_CMD_READ_STATUS, SPI_CONTINUE);
+    status = _spi->transfer(_csPin, 0xFF);
+    if((status & SPIFLASH_STATUS_BUSY) == 0) {
+      return true;
+    }
+    delayMicroseconds(10);
+  }
+  return false;
+}
+
+bool SPIFlashBlockDevice::readRaw(uint32_t addr, uint8_t *buffer, uint32_t len)
+{
+  uint32_t n;
+
+  if(_capacity == 0) {
+    return false;
+  }
+  command(SPIFLASH_CMD_FAST_READ, addr, false);
+  _spi->transfer(_csPin, 0xFF, SPI_CONTINUE);   // dummy byte
+  // The transfers of the SPI driver are limited to 64 KB
+  while(len != 0) {
+    n = min(len, (uint32_t)0x8000);
+    len -= n;
+    _spi->transfer(_csPin, buffer, n, (len != 0) ? SPI_CONTINUE : SPI_LAST);
+    buffer += n;
+  }
+  return true;
+}
+
+// Erased pages are not programmed: shorter writes of partly filled sectors
+static bool isErased(const uint8_t *data, uint32_t len)
+{
+  while(len--) {
+    if(*data++ != 0xFF) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SPIFlashBlockDevice::writeUnit(uint32_t addr, const uint8_t *data)
+{
+  uint8_t rx[SPIFLASH_PAGE_SIZE];
+  uint32_t page;
+
+  if(_capacity == 0) {
+    return false;
+  }
+  _spi->transfer(_csPin, SPIFLASH_CMD_WRITE_ENABLE);
+  command(SPIFLASH_CMD_SECTOR_ERASE, addr, true);
+  if(!waitReady(SPIFLASH_ERASE_TIMEOUT)) {
+    return false;
+  }
+  for(page = 0; page < _eraseSize; page += SPIFLASH_PAGE_SIZE) {
+    if(isErased(&data[page], SPIFLASH_PAGE_SIZE)) {
+      continue;
+    }
+    _spi->transfer(_csPin, SPIFLASH_CMD_WRITE_ENABLE);
+    command(SPIFLASH_CMD_PAGE_PROGRAM, addr + page, false);
+    // rx: the data sent must not be overwritten by the received bytes
+    _spi->transfer(_csPin, (void *)&data[page], rx, SPIFLASH_PAGE_SIZE);
+    if(!waitReady(SPIFLASH_PROGRAM_TIMEOUT)) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,57 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Block device on a SPI NOR flash (W25Q, MX25L, AT25SF... series).
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _SPIFLASHBLOCKDEVICE_H_
+#define _SPIFLASHBLOCKDEVICE_H_
+
+#include "BlockDevice.h"
+#include "SPI.h"
+
+// 4 KB sectors erased with the 0x20 command, 256 bytes pages
+#define SPIFLASH_SECTOR_SIZE  4096
+#define SPIFLASH_PAGE_SIZE    256
+
+class SPIFlashBlockDevice : public BlockDevice {
+  public:
+    // csPin: chip select, driven by the SPI library
+    SPIFlashBlockDevice(uint8_t csPin, SPIClass &spi = SPI, uint32_t clock = 20000000);
+
+    // Reads the JEDEC ID to get the capacity, up to 16 MB (3 bytes addresses)
+    virtual bool begin(void);
+    virtual uint32_t blockCount(void);
+    uint32_t jedecId(void);
+
+  protected:
+    virtual bool readRaw(uint32_t addr, uint8_t *buffer, uint32_t len);
+    virtual bool writeUnit(uint32_t addr, const uint8_t *data);
+
+  private:
+    SPIClass *_spi;
+    uint8_t _csPin;
+    uint32_t _clock;
+    uint32_t _jedecId;
+    uint32_t _capacity;
+    uint8_t _sector[SPIFLASH_SECTOR_SIZE];
+
+    void command(uint8_t cmd, uint32_t addr, bool last);
+    bool waitReady(uint32_t timeout);
+};
+
+#endif // _SPIFLASHBLOCKDEVICE_H_
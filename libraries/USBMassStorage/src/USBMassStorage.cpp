@@ -0,0 +1,162 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  USB mass storage device exposing a BlockDevice to the host.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "USBMassStorage.h"
+
+#if defined(USB_OTG_FS)
+#define USBMASSSTORAGE_IRQn OTG_FS_IRQn
+#else
+#define USBMASSSTORAGE_IRQn USB_IRQn
+#endif
+
+USBMassStorageClass USBMassStorage;
+
+static BlockDevice *_device = NULL;
+static bool _readOnly = false;
+static volatile uint32_t _lastWrite = 0;
+
+static int8_t storageInit(uint8_t lun);
+static int8_t storageGetCapacity(uint8_t lun, uint32_t *block_num, uint16_t *block_size);
+static int8_t storageIsReady(uint8_t lun);
+static int8_t storageIsWriteProtected(uint8_t lun);
+static int8_t storageRead(uint8_t lun, uint8_t *buf, uint32_t blk_addr, uint16_t blk_len);
+static int8_t storageWrite(uint8_t lun, uint8_t *buf, uint32_t blk_addr, uint16_t blk_len);
+static int8_t storageGetMaxLun(void);
+
+static int8_t storageInquiry[STANDARD_INQUIRY_DATA_LEN] = {
+  0x00, (int8_t)0x80, 0x02, 0x02, (STANDARD_INQUIRY_DATA_LEN - 5), 0x00, 0x00, 0x00,
+  'S', 'T', 'M', '3', '2', ' ', ' ', ' ',                                 // Manufacturer: 8 bytes
+  'M', 'a', 's', 's', ' ', 'S', 't', 'o', 'r', 'a', 'g', 'e', ' ', ' ', ' ', ' ', // Product: 16 bytes
+  '1', '.', '0', '0',                                                     // Version: 4 bytes
+};
+
+static USBD_StorageTypeDef storage = {
+  storageInit,
+  storageGetCapacity,
+  storageIsReady,
+  storageIsWriteProtected,
+  storageRead,
+  storageWrite,
+  storageGetMaxLun,
+  storageInquiry,
+};
+
+bool USBMassStorageClass::begin(BlockDevice &device, bool readOnly)
+{
+  end();
+  if(!device.begin()) {
+    return false;
+  }
+  _device = &device;
+  _readOnly = readOnly || device.isReadOnly();
+  usbd_interface_msc_attach(&storage);
+  return true;
+}
+
+void USBMassStorageClass::end(void)
+{
+  if(_device != NULL) {
+    usbd_interface_msc_attach(NULL);
+    sync();
+    _device = NULL;
+  }
+}
+
+bool USBMassStorageClass::isAttached(void)
+{
+  return _device != NULL;
+}
+
+bool USBMassStorageClass::sync(void)
+{
+  bool ret = true;
+
+  // Not during a transfer of the USB interrupt. Only this interrupt is
+  // masked: writing a unit may be long.
+  NVIC_DisableIRQ(USBMASSSTORAGE_IRQn);
+  if(_device != NULL) {
+    ret = _device->sync();
+  }
+  NVIC_EnableIRQ(USBMASSSTORAGE_IRQn);
+  return ret;
+}
+
+// Storage callbacks, called from the USB interrupt
+
+static int8_t storageInit(uint8_t lun)
+{
+  UNUSED(lun);
+  return 0;
+}
+
+static int8_t storageGetCapacity(uint8_t lun, uint32_t *block_num, uint16_t *block_size)
+{
+  UNUSED(lun);
+  if(_device == NULL) {
+    return -1;
+  }
+  *block_num = _device->blockCount();
+  *block_size = BLOCKDEVICE_BLOCK_SIZE;
+  return 0;
+}
+
+static int8_t storageIsReady(uint8_t lun)
+{
+  UNUSED(lun);
+  if(_device == NULL) {
+    return -1;
+  }
+  // Also called before each read and write: the cache is kept while the
+  // host is writing
+  if((millis() - _lastWrite) >= USBMASSSTORAGE_SYNC_DELAY) {
+    _device->sync();
+  }
+  return 0;
+}
+
+static int8_t storageIsWriteProtected(uint8_t lun)
+{
+  UNUSED(lun);
+  return _readOnly ? 1 : 0;
+}
+
+static int8_t storageRead(uint8_t lun, uint8_t *buf, uint32_t blk_addr, uint16_t blk_len)
+{
+  UNUSED(lun);
+  if((_device == NULL) || !_device->read(blk_addr, buf, blk_len)) {
+    return -1;
+  }
+  return 0;
+}
+
+static int8_t storageWrite(uint8_t lun, uint8_t *buf, uint32_t blk_addr, uint16_t blk_len)
+{
+  UNUSED(lun);
+  if((_device == NULL) || _readOnly || !_device->write(blk_addr, buf, blk_len)) {
+    return -1;
+  }
+  _lastWrite = millis();
+  return 0;
+}
+
+static int8_t storageGetMaxLun(void)
+{
+  return 0;
+}
@@ -0,0 +1,55 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  USB mass storage device exposing a BlockDevice to the host.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef _USBMASSSTORAGE_H_
+#define _USBMASSSTORAGE_H_
+
+#include "BlockDevice.h"
+#include "FlashBlockDevice.h"
+#include "SPIFlashBlockDevice.h"
+
+#if !defined(USBCON) || !defined(USBD_USE_MSC)
+#error "Select 'Mass storage' in the 'Tools->USB interface' menu"
+#endif
+
+// The cached unit is written when the host has not written for this time
+// and polls the drive (about every second), so it is not lost if the
+// cable is removed without ejecting the drive.
+#ifndef USBMASSSTORAGE_SYNC_DELAY
+#define USBMASSSTORAGE_SYNC_DELAY 200
+#endif
+
+// The device is accessed from the USB interrupt: the sketch must not use it
+// (nor the SPI bus of a SPIFlashBlockDevice) between begin() and end().
+class USBMassStorageClass {
+  public:
+    // Calls device.begin(). readOnly: the host cannot write even if the
+    // device could.
+    bool begin(BlockDevice &device, bool readOnly = false);
+    // The host sees the medium removed
+    void end(void);
+    bool isAttached(void);
+    // Write the cached data now
+    bool sync(void);
+};
+
+extern USBMassStorageClass USBMassStorage;
+
+#endif // _USBMASSSTORAGE_H_
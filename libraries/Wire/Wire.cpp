@@ -301,6 +301,22 @@ int TwoWire::read(void)
   return value;
 }
 
+// must be called in:
+// slave rx event callback
+// or after requestFrom(address, numBytes)
+int TwoWire::read(uint8_t *buffer, size_t size)
+{
+  size_t count = rxBufferLength - rxBufferIndex;
+
+  if(count > size){
+    count = size;
+  }
+  memcpy(buffer, &rxBuffer[rxBufferIndex], count);
+  rxBufferIndex += count;
+
+  return count;
+}
+
 // must be called in:
 // slave rx event callback
 // or after requestFrom(address, numBytes)
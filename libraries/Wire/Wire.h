@@ -76,7 +76,9 @@ class TwoWire : public Stream
     virtual size_t write(uint8_t);
     virtual size_t write(const uint8_t *, size_t);
     virtual int available(void);
+    using Stream::read;
     virtual int read(void);
+    virtual int read(uint8_t *, size_t);
     virtual int peek(void);
     virtual void flush(void);
     void onReceive( void (*)(int) );
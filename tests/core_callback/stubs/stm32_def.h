@@ -0,0 +1,14 @@
+/*
+ * Host stub of stm32_def.h, for tests/core_callback only: the tick is
+ * provided by the test. Included first with -include, its guard hides the
+ * real stm32_def.h.
+ */
+#ifndef _STM32_DEF_
+#define _STM32_DEF_
+
+#include <stddef.h>
+#include <stdint.h>
+
+uint32_t HAL_GetTick(void);
+
+#endif /* _STM32_DEF_ */
@@ -0,0 +1,6 @@
+/*
+ * Host stub of the variant header, for tests/core_callback only.
+ */
+#ifndef _VARIANT_ARDUINO_STM32_
+#define _VARIANT_ARDUINO_STM32_
+#endif
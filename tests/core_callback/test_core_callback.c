@@ -0,0 +1,335 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Host test of the core tasks scheduler (stm32/core_callback.c).
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+/*
+ * Built and run on the host, from the root of the repository:
+ *   cc -Wall -DCORE_CALLBACK -I tests/core_callback/stubs \
+ *      -include tests/core_callback/stubs/stm32_def.h -I cores/arduino/stm32 \
+ *      -o /tmp/test_core_callback tests/core_callback/test_core_callback.c \
+ *      cores/arduino/stm32/core_callback.c
+ *   /tmp/test_core_callback
+ * HAL_GetTick() returns the tick set by the test.
+ * Prints the failed checks and exits with 1 if any.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "core_callback.h"
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                     \
+    if(!(cond)) {                                 \
+      printf("FAIL line %d: ", __LINE__);         \
+      printf(__VA_ARGS__);                        \
+      printf("\n");                               \
+      failures++;                                 \
+    }                                             \
+  } while(0)
+
+static uint32_t tick;
+
+uint32_t HAL_GetTick(void)
+{
+  return tick;
+}
+
+#define NB_TASKS  CALLBACK_LIST_SIZE
+
+// Calls of the tasks, in order
+static int calls[64];
+static int nbCalls;
+static int callCount[NB_TASKS];
+
+static void (*unregisterFrom)(void);
+static uint8_t reenter;
+
+static void task_called(int id)
+{
+  if(nbCalls < (int)(sizeof(calls) / sizeof(calls[0]))) {
+    calls[nbCalls] = id;
+  }
+  nbCalls++;
+  callCount[id]++;
+  if(reenter) {
+    CoreCallback();
+  }
+}
+
+#define TASK(n) static void task##n(void) { task_called(n); }
+TASK(0) TASK(1) TASK(2) TASK(3) TASK(4) TASK(5) TASK(6) TASK(7)
+
+static void (*const tasks[NB_TASKS])(void) = {
+  task0, task1, task2, task3, task4, task5, task6, task7
+};
+
+static void self_unregister(void)
+{
+  unregisterCoreTask(self_unregister);
+  task_called(0);
+  if(unregisterFrom != NULL) {
+    unregisterCoreTask(unregisterFrom);
+  }
+}
+
+static void reset(uint32_t now)
+{
+  int i;
+
+  for(i = 0; i < NB_TASKS; i++) {
+    unregisterCoreTask(tasks[i]);
+    callCount[i] = 0;
+  }
+  unregisterCoreTask(self_unregister);
+  unregisterFrom = NULL;
+  reenter = 0;
+  nbCalls = 0;
+  tick = now;
+}
+
+static void pass(void)
+{
+  nbCalls = 0;
+  CoreCallback();
+}
+
+static void test_period(void)
+{
+  reset(1000);
+  CHECK(CoreTaskNextDue() == 0xFFFFFFFF, "no task: %u", (unsigned)CoreTaskNextDue());
+  CHECK(registerCoreTask(task0, 10, CORE_TASK_PRIORITY_DEFAULT), "register");
+  CHECK(CoreTaskNextDue() == 0, "first call at the next pass");
+  pass();
+  CHECK(nbCalls == 1, "first pass: %d calls", nbCalls);
+  CHECK(CoreTaskNextDue() == 10, "next due: %u", (unsigned)CoreTaskNextDue());
+  tick += 9;
+  pass();
+  CHECK(nbCalls == 0, "not due yet: %d calls", nbCalls);
+  CHECK(CoreTaskNextDue() == 1, "next due: %u", (unsigned)CoreTaskNextDue());
+  tick += 1;
+  pass();
+  CHECK(nbCalls == 1, "due: %d calls", nbCalls);
+  // Late by 2.5 periods: called once, then rescheduled from now
+  tick += 35;
+  pass();
+  CHECK(nbCalls == 1, "late: %d calls", nbCalls);
+  CHECK(CoreTaskNextDue() == 10, "after late: %u", (unsigned)CoreTaskNextDue());
+  // Late by less than a period: keeps its phase
+  tick += 13;
+  pass();
+  CHECK(CoreTaskNextDue() == 7, "phase kept: %u", (unsigned)CoreTaskNextDue());
+}
+
+static void test_wrap(void)
+{
+  reset(0xFFFFFFF0);
+  registerCoreTask(task0, 20, CORE_TASK_PRIORITY_DEFAULT);
+  pass();
+  CHECK(CoreTaskNextDue() == 20, "next due before wrap: %u", (unsigned)CoreTaskNextDue());
+  tick = 0x00000003;
+  pass();
+  CHECK(nbCalls == 0, "19 ms across the wrap: %d calls", nbCalls);
+  CHECK(CoreTaskNextDue() == 1, "next due across wrap: %u", (unsigned)CoreTaskNextDue());
+  tick = 0x00000004;
+  pass();
+  CHECK(nbCalls == 1, "20 ms across the wrap: %d calls", nbCalls);
+
+  // Heap order across the wrap: 0xFFFFFFFA runs before 0x00000005
+  reset(0xFFFFFFF0);
+  registerCoreTask(task1, 21, CORE_TASK_PRIORITY_DEFAULT);
+  registerCoreTask(task2, 10, CORE_TASK_PRIORITY_DEFAULT);
+  pass();
+  CHECK(nbCalls == 2, "first pass: %d calls", nbCalls);
+  CHECK(CoreTaskNextDue() == 10, "next due: %u", (unsigned)CoreTaskNextDue());
+  tick = 0xFFFFFFFA;
+  pass();
+  CHECK((nbCalls == 1) && (calls[0] == 2), "before the wrap: %d calls", nbCalls);
+  tick = 0x00000004;
+  pass();
+  CHECK((nbCalls == 1) && (calls[0] == 2), "after the wrap, task1 not due: %d calls", nbCalls);
+  CHECK(CoreTaskNextDue() == 1, "task1 due at 5: %u", (unsigned)CoreTaskNextDue());
+  tick = 0x00000005;
+  pass();
+  CHECK((nbCalls == 1) && (calls[0] == 1), "task1 at 5: %d calls", nbCalls);
+}
+
+static void test_priority(void)
+{
+  reset(0);
+  registerCoreTask(task0, 5, CORE_TASK_PRIORITY_LOW);
+  registerCoreTask(task1, 5, CORE_TASK_PRIORITY_HIGH);
+  registerCoreTask(task2, 5, CORE_TASK_PRIORITY_DEFAULT);
+  registerCoreCallback(task3);
+  pass();
+  CHECK(nbCalls == 4, "all due: %d calls", nbCalls);
+  CHECK((calls[0] == 1) && (calls[1] == 2 || calls[1] == 3) &&
+        (calls[2] == 2 || calls[2] == 3) && (calls[3] == 0),
+        "order %d %d %d %d", calls[0], calls[1], calls[2], calls[3]);
+}
+
+// The callbacks called at each pass do not keep delay() from sleeping
+static void test_every_pass(void)
+{
+  reset(0);
+  registerCoreCallback(task0);
+  CHECK(CoreTaskNextDue() == 0xFFFFFFFF, "callback only: %u", (unsigned)CoreTaskNextDue());
+  pass();
+  pass();
+  CHECK(callCount[0] == 2, "called at each pass: %d", callCount[0]);
+  registerCoreTask(task1, 50, CORE_TASK_PRIORITY_DEFAULT);
+  pass();
+  CHECK(CoreTaskNextDue() == 50, "periodic task only: %u", (unsigned)CoreTaskNextDue());
+  tick += 20;
+  pass();
+  CHECK((nbCalls == 1) && (calls[0] == 0), "callback only: %d calls", nbCalls);
+  CHECK(CoreTaskNextDue() == 30, "next periodic: %u", (unsigned)CoreTaskNextDue());
+
+  // From every pass to periodic and back
+  registerCoreTask(task0, 100, CORE_TASK_PRIORITY_DEFAULT);
+  pass();
+  CHECK(callCount[0] == 5, "periodic from now: %d", callCount[0]);
+  tick += 30;
+  pass();
+  CHECK(callCount[0] == 5, "not due: %d", callCount[0]);
+  registerCoreCallback(task0);
+  pass();
+  pass();
+  CHECK(callCount[0] == 7, "back to each pass: %d", callCount[0]);
+  CHECK(CoreTaskNextDue() == 50, "periodic task only: %u", (unsigned)CoreTaskNextDue());
+
+  // Woken up: due at once
+  wakeCoreTask(task0);
+  CHECK(CoreTaskNextDue() == 0, "woken up: %u", (unsigned)CoreTaskNextDue());
+  pass();
+  CHECK(CoreTaskNextDue() == 50, "wake up cleared: %u", (unsigned)CoreTaskNextDue());
+}
+
+static void test_wake(void)
+{
+  reset(0);
+  registerCoreTask(task0, 1000, CORE_TASK_PRIORITY_DEFAULT);
+  pass();
+  tick += 10;
+  wakeCoreTask(task0);
+  CHECK(CoreTaskNextDue() == 0, "woken up: %u", (unsigned)CoreTaskNextDue());
+  pass();
+  CHECK(nbCalls == 1, "woken up: %d calls", nbCalls);
+  CHECK(CoreTaskNextDue() == 1000, "rescheduled from the wake up: %u", (unsigned)CoreTaskNextDue());
+}
+
+static void test_register_unregister(void)
+{
+  int i;
+
+  reset(0);
+  for(i = 0; i < NB_TASKS; i++) {
+    CHECK(registerCoreTask(tasks[i], i + 1, CORE_TASK_PRIORITY_DEFAULT), "register %d", i);
+  }
+  CHECK(!registerCoreTask(self_unregister, 1, CORE_TASK_PRIORITY_DEFAULT), "list full");
+  CHECK(registerCoreTask(tasks[3], 7, CORE_TASK_PRIORITY_HIGH), "registered again");
+  unregisterCoreTask(tasks[7]);
+  CHECK(registerCoreTask(self_unregister, 1, CORE_TASK_PRIORITY_HIGH), "slot freed");
+
+  // Unregistered by itself, and another due task unregistered from it
+  unregisterFrom = tasks[0];
+  pass();
+  CHECK(callCount[0] == 1, "self_unregister: %d", callCount[0]);
+  tick += 1;
+  pass();
+  CHECK(callCount[0] == 1, "self_unregister called again: %d", callCount[0]);
+  for(i = 0; i < nbCalls; i++) {
+    CHECK(calls[i] != 0, "task0 called after its removal");
+  }
+
+  // The calls from a task are ignored
+  reset(0);
+  reenter = 1;
+  registerCoreTask(task0, 1, CORE_TASK_PRIORITY_DEFAULT);
+  pass();
+  CHECK(nbCalls == 1, "reentered: %d calls", nbCalls);
+}
+
+// Random periods and steps across the wrap, against a plain model
+static void test_random(void)
+{
+  uint32_t next[NB_TASKS];
+  uint32_t period[NB_TASKS];
+  uint8_t priority[NB_TASKS];
+  int expected[NB_TASKS];
+  int i, step, n, lastPriority;
+
+  srand(1);
+  reset(0xFFFF0000);
+  for(i = 0; i < NB_TASKS; i++) {
+    period[i] = 1 + rand() % 200;
+    priority[i] = rand() % 3;
+    next[i] = tick;
+    registerCoreTask(tasks[i], period[i], priority[i]);
+  }
+  for(step = 0; step < 200000; step++) {
+    n = 0;
+    for(i = 0; i < NB_TASKS; i++) {
+      expected[i] = ((int32_t)(tick - next[i]) >= 0);
+      n += expected[i];
+    }
+    for(i = 0; i < NB_TASKS; i++) {
+      callCount[i] = 0;
+    }
+    pass();
+    CHECK(nbCalls == n, "tick %08x: %d calls, expected %d", (unsigned)tick, nbCalls, n);
+    lastPriority = CORE_TASK_PRIORITY_HIGH;
+    for(i = 0; i < nbCalls && i < 64; i++) {
+      CHECK(priority[calls[i]] <= lastPriority, "tick %08x: priority order", (unsigned)tick);
+      lastPriority = priority[calls[i]];
+    }
+    for(i = 0; i < NB_TASKS; i++) {
+      CHECK(callCount[i] == expected[i], "tick %08x: task %d", (unsigned)tick, i);
+      if(expected[i]) {
+        next[i] += period[i];
+        if((int32_t)(tick - next[i]) >= 0) {
+          next[i] = tick + period[i];
+        }
+      }
+    }
+    if(failures > 10) {
+      return;
+    }
+    tick += (rand() % 8 == 0) ? rand() % 400 : rand() % 4;
+  }
+  CHECK((int32_t)(tick - 0xFFFF0000) > 0x10000, "the tick did not wrap");
+}
+
+int main(void)
+{
+  test_period();
+  test_wrap();
+  test_priority();
+  test_every_pass();
+  test_wake();
+  test_register_unregister();
+  test_random();
+
+  if(failures != 0) {
+    printf("%d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("core_callback: all checks passed\n");
+  return 0;
+}
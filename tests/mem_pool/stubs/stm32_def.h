@@ -0,0 +1,26 @@
+/*
+ * Host stub of stm32_def.h, for tests/mem_pool only. Included first with
+ * -include, its guard hides the real stm32_def.h. The interrupts are not
+ * masked on the host, and the heap of the pools is the test one, a model
+ * of a small first fit heap.
+ */
+#ifndef _STM32_DEF_
+#define _STM32_DEF_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+static inline uint32_t __get_PRIMASK(void) { return 0; }
+static inline void __set_PRIMASK(uint32_t primask) { (void)primask; }
+static inline void __disable_irq(void) { }
+
+void *test_malloc(size_t size);
+void *test_realloc(void *ptr, size_t size);
+void test_free(void *ptr);
+
+#define malloc(size)        test_malloc(size)
+#define realloc(ptr, size)  test_realloc(ptr, size)
+#define free(ptr)           test_free(ptr)
+
+#endif /* _STM32_DEF_ */
@@ -0,0 +1,17 @@
+/*
+ * Host stub of the variant header, for tests/mem_pool only: the size
+ * classes of the pools under test.
+ */
+#ifndef _VARIANT_ARDUINO_STM32_
+#define _VARIANT_ARDUINO_STM32_
+
+#define MEM_POOL_1_SIZE    16
+#define MEM_POOL_1_COUNT   64
+#define MEM_POOL_2_SIZE    32
+#define MEM_POOL_2_COUNT   48
+#define MEM_POOL_3_SIZE    64
+#define MEM_POOL_3_COUNT   24
+#define MEM_POOL_4_SIZE    128
+#define MEM_POOL_4_COUNT   8
+
+#endif
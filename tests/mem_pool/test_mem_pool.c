@@ -0,0 +1,422 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Host test and fragmentation benchmark of the pool allocator (stm32/mem_pool.c).
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+/*
+ * Built and run on the host, from the root of the repository:
+ *   cc -Wall -I tests/mem_pool/stubs -include tests/mem_pool/stubs/stm32_def.h \
+ *      -I cores/arduino/stm32 -o /tmp/test_mem_pool \
+ *      tests/mem_pool/test_mem_pool.c cores/arduino/stm32/mem_pool.c
+ *   /tmp/test_mem_pool
+ * The pools are those of tests/mem_pool/stubs/variant.h. malloc() of the
+ * pools is a first fit heap of a few KB, as newlib's on a small part,
+ * used by the fragmentation benchmark.
+ * Prints the failed checks and exits with 1 if any.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "mem_pool.h"
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                     \
+    if(!(cond)) {                                 \
+      printf("FAIL line %d: ", __LINE__);         \
+      printf(__VA_ARGS__);                        \
+      printf("\n");                               \
+      failures++;                                 \
+    }                                             \
+  } while(0)
+
+/* Test heap ---------------------------------------------------------------*/
+// Blocks of a header and the data, chained by their size, first fit,
+// adjacent free blocks merged
+#define HEAP_MAX    (16 * 1024)
+#define HEAP_ALIGN  8
+
+typedef struct {
+  uint32_t size;              // block size, header included
+  uint32_t used;
+} heap_block_t;
+
+static uint64_t heap[HEAP_MAX / 8];
+static uint32_t heapSize;
+static uint32_t heapCalls;
+
+#define HEAP_BLOCK(offset)  ((heap_block_t *)((uint8_t *)heap + (offset)))
+#define HEAP_HEADER         ((uint32_t)sizeof(heap_block_t))
+
+static void heap_init(uint32_t size)
+{
+  heapSize = size;
+  HEAP_BLOCK(0)->size = size;
+  HEAP_BLOCK(0)->used = 0;
+}
+
+static void heap_merge(void)
+{
+  uint32_t offset = 0;
+  heap_block_t *block, *next;
+
+  while(offset < heapSize) {
+    block = HEAP_BLOCK(offset);
+    while(!block->used && (offset + block->size < heapSize) &&
+          !(next = HEAP_BLOCK(offset + block->size))->used) {
+      block->size += next->size;
+    }
+    offset += block->size;
+  }
+}
+
+void *test_malloc(size_t size)
+{
+  uint32_t need = HEAP_HEADER + (((uint32_t)size + HEAP_ALIGN - 1) & ~(HEAP_ALIGN - 1));
+  uint32_t offset = 0;
+  heap_block_t *block;
+
+  heapCalls++;
+  while(offset < heapSize) {
+    block = HEAP_BLOCK(offset);
+    if(!block->used && (block->size >= need)) {
+      if(block->size - need >= HEAP_HEADER + HEAP_ALIGN) {
+        HEAP_BLOCK(offset + need)->size = block->size - need;
+        HEAP_BLOCK(offset + need)->used = 0;
+        block->size = need;
+      }
+      block->used = 1;
+      return (uint8_t *)block + HEAP_HEADER;
+    }
+    offset += block->size;
+  }
+  return NULL;
+}
+
+void test_free(void *ptr)
+{
+  if(ptr == NULL) {
+    return;
+  }
+  heapCalls++;
+  ((heap_block_t *)((uint8_t *)ptr - HEAP_HEADER))->used = 0;
+  heap_merge();
+}
+
+void *test_realloc(void *ptr, size_t size)
+{
+  heap_block_t *block;
+  void *newptr;
+
+  if(ptr == NULL) {
+    return test_malloc(size);
+  }
+  block = (heap_block_t *)((uint8_t *)ptr - HEAP_HEADER);
+  if(block->size - HEAP_HEADER >= size) {
+    heapCalls++;
+    return ptr;
+  }
+  newptr = test_malloc(size);
+  if(newptr != NULL) {
+    memcpy(newptr, ptr, block->size - HEAP_HEADER);
+    test_free(ptr);
+  }
+  return newptr;
+}
+
+static int in_heap(void *ptr)
+{
+  return ((uint8_t *)ptr >= (uint8_t *)heap) && ((uint8_t *)ptr < (uint8_t *)heap + heapSize);
+}
+
+// Largest free block, data bytes, and number of free blocks
+static uint32_t heap_largest_free(uint32_t *fragments)
+{
+  uint32_t offset = 0;
+  uint32_t largest = 0;
+  heap_block_t *block;
+
+  *fragments = 0;
+  while(offset < heapSize) {
+    block = HEAP_BLOCK(offset);
+    if(!block->used) {
+      (*fragments)++;
+      if(block->size - HEAP_HEADER > largest) {
+        largest = block->size - HEAP_HEADER;
+      }
+    }
+    offset += block->size;
+  }
+  return largest;
+}
+
+/* Tests -------------------------------------------------------------------*/
+static const uint16_t blockSizes[MEM_POOL_NUM] = {
+  MEM_POOL_1_SIZE, MEM_POOL_2_SIZE, MEM_POOL_3_SIZE, MEM_POOL_4_SIZE
+};
+static const uint16_t blockCounts[MEM_POOL_NUM] = {
+  MEM_POOL_1_COUNT, MEM_POOL_2_COUNT, MEM_POOL_3_COUNT, MEM_POOL_4_COUNT
+};
+
+static mem_pool_stats_t stats(uint8_t index)
+{
+  mem_pool_stats_t s;
+
+  memset(&s, 0, sizeof(s));
+  mem_pool_get_stats(index, &s);
+  return s;
+}
+
+static void test_stats(void)
+{
+  mem_pool_stats_t s;
+  uint8_t i;
+
+  for(i = 0; i < MEM_POOL_NUM; i++) {
+    CHECK(mem_pool_get_stats(i, &s), "pool %d", i);
+    CHECK((s.blockSize == blockSizes[i]) && (s.count == blockCounts[i]) && (s.used == 0),
+          "pool %d: size %u count %u used %u", i, s.blockSize, s.count, s.used);
+  }
+  CHECK(!mem_pool_get_stats(MEM_POOL_NUM, &s), "no pool %d", MEM_POOL_NUM);
+}
+
+// Each request in the smallest class that fits, then the bigger ones when
+// it is empty, then the heap
+static void test_exhaustion(void)
+{
+  static void *ptrs[MEM_POOL_1_COUNT + MEM_POOL_2_COUNT + MEM_POOL_3_COUNT + MEM_POOL_4_COUNT + 4];
+  uint32_t fallbacks = stats(0).fallbacks;
+  int n = 0;
+  int i, j;
+
+  heap_init(4096);
+  heapCalls = 0;
+  for(i = 0; i < MEM_POOL_NUM; i++) {
+    for(j = 0; j < blockCounts[i]; j++) {
+      ptrs[n] = mem_pool_alloc(1 + (n % MEM_POOL_1_SIZE));
+      CHECK((ptrs[n] != NULL) && !in_heap(ptrs[n]), "block %d from the pools", n);
+      CHECK(((uintptr_t)ptrs[n] % 8) == 0, "block %d aligned", n);
+      memset(ptrs[n], n, 1 + (n % MEM_POOL_1_SIZE));
+      n++;
+    }
+    CHECK(stats(i).used == blockCounts[i], "pool %d full: %u", i, stats(i).used);
+  }
+  CHECK(heapCalls == 0, "heap used while a pool fits: %u", heapCalls);
+  CHECK(stats(0).fallbacks == fallbacks + MEM_POOL_2_COUNT + MEM_POOL_3_COUNT + MEM_POOL_4_COUNT,
+        "fallbacks of pool 0: %u", stats(0).fallbacks);
+  for(i = 0; i < n; i++) {
+    for(j = 0; j < 1 + (i % MEM_POOL_1_SIZE); j++) {
+      if(((uint8_t *)ptrs[i])[j] != (uint8_t)i) {
+        CHECK(0, "block %d overwritten", i);
+        break;
+      }
+    }
+  }
+
+  // All full: only the heap, and nothing for the interrupts
+  CHECK(mem_pool_alloc_isr(1) == NULL, "isr allocation with all pools full");
+  CHECK(heapCalls == 0, "heap used by the isr allocation");
+  ptrs[n] = mem_pool_alloc(8);
+  CHECK((ptrs[n] != NULL) && in_heap(ptrs[n]), "fallback to malloc");
+  n++;
+
+  // A freed block is used again, the last freed first
+  mem_pool_free(ptrs[5]);
+  mem_pool_free(ptrs[7]);
+  CHECK(stats(0).used == MEM_POOL_1_COUNT - 2, "freed: %u", stats(0).used);
+  CHECK(mem_pool_alloc_isr(MEM_POOL_1_SIZE) == ptrs[7], "last freed first");
+  CHECK(mem_pool_alloc(1) == ptrs[5], "then the previous one");
+
+  heapCalls = 0;
+  for(i = 0; i < n; i++) {
+    mem_pool_free(ptrs[i]);
+  }
+  CHECK(heapCalls == 1, "only the malloc'ed block to free(): %u", heapCalls);
+  for(i = 0; i < MEM_POOL_NUM; i++) {
+    CHECK(stats(i).used == 0, "pool %d empty: %u", i, stats(i).used);
+    CHECK(stats(i).usedMax == blockCounts[i], "pool %d high water mark: %u", i, stats(i).usedMax);
+  }
+}
+
+static void test_big(void)
+{
+  void *ptr;
+
+  heap_init(4096);
+  ptr = mem_pool_alloc(MEM_POOL_4_SIZE + 1);
+  CHECK((ptr != NULL) && in_heap(ptr), "bigger than the classes: malloc");
+  mem_pool_free(ptr);
+  CHECK(mem_pool_alloc_isr(MEM_POOL_4_SIZE + 1) == NULL, "bigger than the classes in isr");
+  CHECK(mem_pool_alloc(8192) == NULL, "no memory left");
+  mem_pool_free(NULL);
+}
+
+static void test_realloc_moves(void)
+{
+  char *ptr, *grown;
+
+  heap_init(4096);
+  ptr = mem_pool_realloc(NULL, 5);
+  CHECK((ptr != NULL) && !in_heap(ptr) && (stats(0).used == 1), "realloc of NULL");
+  strcpy(ptr, "abcd");
+  CHECK(mem_pool_realloc(ptr, MEM_POOL_1_SIZE) == ptr, "fits in the block: kept");
+  grown = mem_pool_realloc(ptr, MEM_POOL_1_SIZE + 1);
+  CHECK((grown != ptr) && (stats(0).used == 0) && (stats(1).used == 1), "to the next class");
+  CHECK(strcmp(grown, "abcd") == 0, "content kept: %s", grown);
+  ptr = mem_pool_realloc(grown, MEM_POOL_4_SIZE + 100);
+  CHECK(in_heap(ptr) && (stats(1).used == 0), "out of the classes: malloc");
+  CHECK(strcmp(ptr, "abcd") == 0, "content kept: %s", ptr);
+  grown = mem_pool_realloc(ptr, 1000);
+  CHECK(in_heap(grown) && (strcmp(grown, "abcd") == 0), "heap block: realloc");
+  CHECK(mem_pool_realloc(grown, 8192) == NULL, "no memory left");
+  CHECK(strcmp(grown, "abcd") == 0, "kept on failure");
+  mem_pool_free(grown);
+}
+
+/* Fragmentation benchmark -------------------------------------------------*/
+// Long uptime of a sketch: short Strings built and dropped, a few growing
+// by concatenation, and some larger buffers (modem, JSON). Every PROBE_STEPS
+// a PROBE_SIZE buffer is requested, as a modem frame, to see if the free
+// memory is still in one piece. The pools keep their storage when unused,
+// so their largest free block is smaller: that is only reported, the
+// checks are on the heap calls and the fragments.
+#ifndef SLOTS
+#define SLOTS       140
+#endif
+#define STEPS       200000
+#define PROBE_STEPS 100
+#define PROBE_SIZE  1024
+#define POOL_BYTES  (MEM_POOL_1_SIZE * MEM_POOL_1_COUNT + MEM_POOL_2_SIZE * MEM_POOL_2_COUNT + \
+                     MEM_POOL_3_SIZE * MEM_POOL_3_COUNT + MEM_POOL_4_SIZE * MEM_POOL_4_COUNT)
+#define HEAP_BYTES  4096
+
+typedef struct {
+  uint32_t failed;
+  uint32_t probeFailed;
+  uint32_t heapCalls;
+  uint32_t largest;
+  uint32_t fragments;
+} bench_result_t;
+
+static size_t bench_size(void)
+{
+  int r = rand() % 100;
+
+  if(r < 70) {
+    return 4 + rand() % 21;
+  }
+  if(r < 90) {
+    return 25 + rand() % 36;
+  }
+  if(r < 98) {
+    return 61 + rand() % 60;
+  }
+  return 200 + rand() % 200;
+}
+
+static void bench(int pools, bench_result_t *result)
+{
+  void *slots[SLOTS];
+  size_t sizes[SLOTS];
+  void *ptr;
+  int step, i;
+
+  memset(slots, 0, sizeof(slots));
+  memset(result, 0, sizeof(*result));
+  // Same memory for both: the pools storage goes to the heap without them
+  heap_init(pools ? HEAP_BYTES : HEAP_BYTES + POOL_BYTES);
+  heapCalls = 0;
+  srand(1);
+  for(step = 0; step < STEPS; step++) {
+    i = rand() % SLOTS;
+    if(slots[i] == NULL) {
+      sizes[i] = bench_size();
+      slots[i] = pools ? mem_pool_alloc(sizes[i]) : test_malloc(sizes[i]);
+      result->failed += (slots[i] == NULL);
+    } else if((sizes[i] < 120) && (rand() % 4 == 0)) {
+      sizes[i] += 1 + rand() % 16;
+      ptr = pools ? mem_pool_realloc(slots[i], sizes[i]) : test_realloc(slots[i], sizes[i]);
+      if(ptr != NULL) {
+        slots[i] = ptr;
+      } else {
+        result->failed++;
+      }
+    } else {
+      if(pools) {
+        mem_pool_free(slots[i]);
+      } else {
+        test_free(slots[i]);
+      }
+      slots[i] = NULL;
+    }
+    if((step % PROBE_STEPS) == 0) {
+      ptr = pools ? mem_pool_alloc(PROBE_SIZE) : test_malloc(PROBE_SIZE);
+      result->probeFailed += (ptr == NULL);
+      if(pools) {
+        mem_pool_free(ptr);
+      } else {
+        test_free(ptr);
+      }
+    }
+  }
+  result->heapCalls = heapCalls;
+  result->largest = heap_largest_free(&result->fragments);
+  for(i = 0; i < SLOTS; i++) {
+    if(pools) {
+      mem_pool_free(slots[i]);
+    } else {
+      test_free(slots[i]);
+    }
+  }
+}
+
+static void test_fragmentation(void)
+{
+  bench_result_t heapOnly, withPools;
+
+  bench(0, &heapOnly);
+  bench(1, &withPools);
+  printf("fragmentation, %d steps, %d bytes in all:\n", STEPS, HEAP_BYTES + POOL_BYTES);
+  printf("  malloc only: %5u failed, %4u/%u %d byte buffers failed, %6u heap calls,\n"
+         "               largest free block %5u, %3u free blocks\n",
+         heapOnly.failed, heapOnly.probeFailed, STEPS / PROBE_STEPS, PROBE_SIZE,
+         heapOnly.heapCalls, heapOnly.largest, heapOnly.fragments);
+  printf("  with pools:  %5u failed, %4u/%u %d byte buffers failed, %6u heap calls,\n"
+         "               largest free block %5u, %3u free blocks\n",
+         withPools.failed, withPools.probeFailed, STEPS / PROBE_STEPS, PROBE_SIZE,
+         withPools.heapCalls, withPools.largest, withPools.fragments);
+  CHECK(withPools.failed <= heapOnly.failed, "more failures with the pools");
+  CHECK(withPools.heapCalls < heapOnly.heapCalls / 10, "heap calls with the pools");
+  CHECK(withPools.fragments <= heapOnly.fragments, "more fragments with the pools");
+}
+
+int main(void)
+{
+  test_stats();
+  test_exhaustion();
+  test_big();
+  test_realloc_moves();
+  test_fragmentation();
+
+  if(failures != 0) {
+    printf("%d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("mem_pool: all checks passed\n");
+  return 0;
+}
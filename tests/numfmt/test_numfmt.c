@@ -0,0 +1,281 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Host test of the number formatting of numfmt.c.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+/*
+ * Built and run on the host, from the root of the repository:
+ *   cc -Wall -I cores/arduino -o /tmp/test_numfmt \
+ *      tests/numfmt/test_numfmt.c cores/arduino/numfmt.c -lm
+ *   /tmp/test_numfmt
+ * Prints the failed checks and exits with 1 if any.
+ */
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include "numfmt.h"
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                     \
+    if(!(cond)) {                                 \
+      printf("FAIL line %d: ", __LINE__);         \
+      printf(__VA_ARGS__);                        \
+      printf("\n");                               \
+      failures++;                                 \
+    }                                             \
+  } while(0)
+
+// Exact ties are rounded away from zero, printf rounds them to even
+static int is_tie(double value, int prec)
+{
+  char ref[80];
+  char *digit;
+
+  snprintf(ref, sizeof(ref), "%.30f", fabs(value));
+  digit = strchr(ref, '.') + 1 + prec;
+  return (digit[0] == '5') && (strspn(digit + 1, "0") == strlen(digit + 1));
+}
+
+// Values with a short binary fraction: all the digits are exact, at any
+// precision, and must be those of printf
+static void test_exact(void)
+{
+  static const double values[] = {
+    0.0, 0.5, -0.5, 0.25, 0.125, -0.375, 0.75, 1.5, 3.0, 12345.0625, 4294967040.0
+  };
+  char buf[NUMFMT_DOUBLE_SIZE];
+  char ref[80];
+  unsigned i;
+  int prec;
+
+  for(i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    for(prec = 0; prec <= NUMFMT_DOUBLE_MAX_PREC; prec++) {
+      if(is_tie(values[i], prec)) {
+        continue;
+      }
+      numfmt_double(buf, values[i], prec);
+      snprintf(ref, sizeof(ref), "%.*f", prec, values[i]);
+      CHECK(strcmp(buf, ref) == 0, "%g prec %d: %s, expected %s", values[i], prec, buf, ref);
+    }
+  }
+}
+
+static void test_long_fractions(void)
+{
+  char buf[NUMFMT_DOUBLE_SIZE];
+
+  numfmt_double(buf, 0.5, 19);
+  CHECK(strcmp(buf, "0.5000000000000000000") == 0, "0.5 prec 19: %s", buf);
+  numfmt_double(buf, -0.5, 19);
+  CHECK(strcmp(buf, "-0.5000000000000000000") == 0, "-0.5 prec 19: %s", buf);
+  numfmt_double(buf, 0.999, 19);
+  CHECK(strcmp(buf, "0.9990000000000000000") == 0, "0.999 prec 19: %s", buf);
+  numfmt_double(buf, 0.999, 18);
+  CHECK(strcmp(buf, "0.999000000000000000") == 0, "0.999 prec 18: %s", buf);
+  // Clamped to NUMFMT_DOUBLE_MAX_PREC
+  numfmt_double(buf, 0.25, 30);
+  CHECK(strcmp(buf, "0.2500000000000000000") == 0, "0.25 prec 30: %s", buf);
+}
+
+// Any value: right number of digits, and as close to the value as the
+// precision and the double allow
+static void test_random(void)
+{
+  char buf[NUMFMT_DOUBLE_SIZE];
+  double value, parsed, tolerance;
+  char *point;
+  int i, prec;
+
+  srand(1);
+  for(i = 0; i < 100000; i++) {
+    value = (rand() / (double)RAND_MAX - 0.5) * pow(10, rand() % 10);
+    prec = rand() % (NUMFMT_DOUBLE_MAX_PREC + 1);
+    numfmt_double(buf, value, prec);
+    parsed = strtod(buf, NULL);
+    tolerance = 0.5 * pow(10, -prec) * 1.001 + fabs(value) * 1e-15;
+    CHECK(fabs(parsed - value) <= tolerance, "%.17g prec %d: %s", value, prec, buf);
+    point = strchr(buf, '.');
+    CHECK((prec == 0) ? (point == NULL) : ((point != NULL) && (strlen(point + 1) == (size_t)prec)),
+          "%.17g prec %d: %s, wrong number of digits", value, prec, buf);
+  }
+}
+
+static void test_special(void)
+{
+  char buf[NUMFMT_DOUBLE_SIZE];
+
+  numfmt_double(buf, NAN, 2);
+  CHECK(strcmp(buf, "nan") == 0, "nan: %s", buf);
+  numfmt_double(buf, -INFINITY, 2);
+  CHECK(strcmp(buf, "inf") == 0, "inf: %s", buf);
+  numfmt_double(buf, 5e9, 2);
+  CHECK(strcmp(buf, "ovf") == 0, "ovf: %s", buf);
+  numfmt_double(buf, 0.999, 2);
+  CHECK(strcmp(buf, "1.00") == 0, "0.999 prec 2: %s", buf);
+}
+
+static size_t format(char *buf, size_t size, const char *fmt, ...)
+  __attribute__((format(printf, 3, 4)));
+
+static size_t format(char *buf, size_t size, const char *fmt, ...)
+{
+  va_list ap;
+  size_t n;
+
+  va_start(ap, fmt);
+  n = numfmt_vformat(buf, size, NULL, NULL, fmt, ap);
+  va_end(ap);
+  return n;
+}
+
+// Without the format check of the compiler
+static size_t numfmt_format_unchecked(char *buf, size_t size, const char *fmt, ...)
+{
+  va_list ap;
+  size_t n;
+
+  va_start(ap, fmt);
+  n = numfmt_vformat(buf, size, NULL, NULL, fmt, ap);
+  va_end(ap);
+  return n;
+}
+
+// Same text and length as snprintf
+#define CHECK_PRINTF(fmt, ...) do {                                         \
+    char buf[128], ref[128];                                                \
+    size_t n = format(buf, sizeof(buf), fmt, __VA_ARGS__);                  \
+    int r = snprintf(ref, sizeof(ref), fmt, __VA_ARGS__);                   \
+    CHECK((strcmp(buf, ref) == 0) && (n == (size_t)r),                      \
+          "\"%s\": \"%s\" (%u), expected \"%s\" (%d)", fmt, buf, (unsigned)n, ref, r); \
+  } while(0)
+
+static void test_printf_integers(void)
+{
+  CHECK_PRINTF("%d %i %u", -12345, 0, 4000000000U);
+  CHECK_PRINTF("%x %X %o %#x %#X %#o", 0xbeefU, 0xbeefU, 8U, 255U, 255U, 8U);
+  CHECK_PRINTF("%#x %#o %#.0o %.0d|", 0U, 0U, 0U, 0);
+  CHECK_PRINTF("%5d|%-5d|%05d|%+d|% d|%+05d", 42, 42, -42, 42, 42, 42);
+  CHECK_PRINTF("%.5d|%8.5d|%-8.3x", -42, 42, 42U);
+  CHECK_PRINTF("%*d|%-*d|%.*d", 6, 1, 6, 2, 4, 3);
+  CHECK_PRINTF("%*d|", -6, 1);
+  CHECK_PRINTF("%ld %lu %lx", -2147483647L - 1, 4294967295UL, 0xdeadbeefUL);
+  CHECK_PRINTF("%lld %llu %llx %#llo", -9223372036854775807LL - 1,
+               18446744073709551615ULL, 0x123456789abcdefULL, 01234567012345670ULL);
+  CHECK_PRINTF("%zu %zd %td %jd", (size_t)123, (ssize_t)-1, (ptrdiff_t)-2, (intmax_t)-3);
+}
+
+// int promoted arguments are converted back to the short type
+static void test_printf_short(void)
+{
+  CHECK_PRINTF("%hd %hi %hu %hx", 70000, 32768, -1, 0x12345);
+  CHECK_PRINTF("%hhd %hhi %hhu %hhx %hho", 300, 128, -1, 0x1ff, 0x1ff);
+  CHECK_PRINTF("%hd %hhd", (short)-5, (signed char)-5);
+}
+
+static void test_printf_text(void)
+{
+  CHECK_PRINTF("%c|%3c|%-3c|", 'a', 'b', 'c');
+  CHECK_PRINTF("%s|%8s|%-8s|%.2s|%8.3s|", "abc", "abc", "abc", "abc", "abcdef");
+  CHECK_PRINTF("%d%%|%5s%%", 100, "x");
+  CHECK_PRINTF("%p", (void *)(uintptr_t)0x20001234UL);
+  CHECK_PRINTF("%s", "a long text, longer than the ones above, to cross the limit");
+}
+
+static void test_printf_float(void)
+{
+  static const double values[] = {
+    0.0, 1.0, -1.0, 0.1, 0.3, 1.7, 12.76, 100.0, 123456.0, 1234567.0,
+    0.000123456, 0.00001234, 1e-10, -2.6e-7, 6.02214076e23, 1.0e100, 9.9999999,
+    99999.97, 4294967040.0, 5e9, 12345678901234.0, 1e-300, 1.7976931348623157e308
+  };
+  // No exact ties and 15 significant digits at most: the scaling by powers
+  // of 10 is not exact, the ties may be rounded either way and the digits
+  // beyond the precision of the double differ
+  static const char *formats[] = {
+    "%e", "%.0e", "%.2e", "%#.0e", "%E", "%.12e", "%15.3e", "%-15.3e|", "%+015.3e",
+    "%g", "%.0g", "%.1g", "%.3g", "%#g", "%#.3g", "%G", "%.10g", "%12g|", "%-12g|",
+    "%+g", "% g", "%010g", "%.15g", "%#.15g"
+  };
+  char buf[128];
+  unsigned i, j;
+
+  for(i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    for(j = 0; j < sizeof(formats) / sizeof(formats[0]); j++) {
+      CHECK_PRINTF(formats[j], values[i]);
+    }
+    if(fabs(values[i]) <= 4294967040.0) {
+      CHECK_PRINTF("%f|%.0f|%#.0f|%.3f|%12.2f|%-12.2f|%012.2f|%+.1f|% .1f",
+                   values[i], values[i], values[i], values[i], values[i],
+                   values[i], values[i], values[i], values[i]);
+    }
+  }
+  CHECK_PRINTF("%f %e %g %F %E %G", NAN, INFINITY, -INFINITY, NAN, INFINITY, -INFINITY);
+  CHECK_PRINTF("%08f|%-6e|", INFINITY, NAN);
+  // Digits after the 19th are zeros
+  CHECK_PRINTF("%.25f", 0.5);
+  CHECK_PRINTF("%.22e", 1.5);
+  // Rounded up to the next power of 10 (glibc writes "1.e+06" for %#g)
+  format(buf, sizeof(buf), "%g|%#g|%.3e", 999999.7, 999999.7, 9.9996);
+  CHECK(strcmp(buf, "1e+06|1.00000e+06|1.000e+01") == 0, "carry: %s", buf);
+  // Beyond the fixed range of numfmt_double
+  format(buf, sizeof(buf), "%f", 5e9);
+  CHECK(strcmp(buf, "ovf") == 0, "%%f 5e9: %s", buf);
+  format(buf, sizeof(buf), "%.25g", 1e20);
+  CHECK(strcmp(buf, "1e+20") == 0, "%%.25g 1e20: %s", buf);
+}
+
+static void test_printf_output(void)
+{
+  char buf[8];
+  size_t n;
+
+  // Truncated like vsnprintf, the length is the whole one
+  n = format(buf, sizeof(buf), "%d-%s", 123456, "abcdef");
+  CHECK((n == 13) && (strcmp(buf, "123456-") == 0), "truncated: %s (%u)", buf, (unsigned)n);
+  n = format(buf, 0, "%d", 1);
+  CHECK(n == 1, "size 0: %u", (unsigned)n);
+  // Unknown conversions are written as is
+  n = numfmt_format_unchecked(buf, sizeof(buf), "%y%", 0);
+  CHECK((n == 3) && (strcmp(buf, "%y%") == 0), "unknown: %s (%u)", buf, (unsigned)n);
+}
+
+int main(void)
+{
+  test_exact();
+  test_long_fractions();
+  test_random();
+  test_special();
+  test_printf_integers();
+  test_printf_short();
+  test_printf_text();
+  test_printf_float();
+  test_printf_output();
+
+  if(failures != 0) {
+    printf("%d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("numfmt: all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,15 @@
+/*
+ * Host stub of stm32_def.h, for tests/timer_alloc only. Included first with
+ * -include, its guard hides the real stm32_def.h. The interrupts are not
+ * masked on the host.
+ */
+#ifndef _STM32_DEF_
+#define _STM32_DEF_
+
+#include <stdint.h>
+
+static inline uint32_t __get_PRIMASK(void) { return 0; }
+static inline void __set_PRIMASK(uint32_t primask) { (void)primask; }
+static inline void __disable_irq(void) { }
+
+#endif /* _STM32_DEF_ */
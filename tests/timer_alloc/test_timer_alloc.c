@@ -0,0 +1,159 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+  Host test of the timer allocator and of the tone timer period
+  (timer_alloc.c).
+  Host test of the timer allocator and of the tone timer period of timer_alloc.c.
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+/*
+ * Built and run on the host, from the root of the repository:
+ *   cc -Wall -include tests/timer_alloc/stubs/stm32_def.h -I cores/arduino/stm32 \
+ *      -o /tmp/test_timer_alloc \
+ *      tests/timer_alloc/test_timer_alloc.c cores/arduino/stm32/timer_alloc.c
+ *   /tmp/test_timer_alloc
+ * Prints the failed checks and exits with 1 if any.
+ */
+
+#include <stdio.h>
+#include "timer_alloc.h"
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                     \
+    if(!(cond)) {                                 \
+      printf("FAIL line %d: ", __LINE__);         \
+      printf(__VA_ARGS__);                        \
+      printf("\n");                               \
+      failures++;                                 \
+    }                                             \
+  } while(0)
+
+// Reference: first prescaler counting cycles in 0xFFFF ticks or less
+static uint32_t smallest_prescaler(uint32_t cycles)
+{
+  uint32_t p;
+
+  for(p = 1; p < 0xFFFF; p++) {
+    if(((uint64_t)cycles + p - 1) / p <= 0xFFFF) {
+      return p;
+    }
+  }
+  return 0;
+}
+
+static void check_period(uint32_t cycles)
+{
+  uint32_t prescaler = 0, period = 0;
+  uint32_t expected = (cycles == 0) ? 0 : smallest_prescaler(cycles);
+  uint64_t counted;
+  uint8_t ok = timer_compute_period(cycles, &prescaler, &period);
+
+  CHECK(ok == (expected != 0), "cycles %lu: returned %u", (unsigned long)cycles, ok);
+  if(!ok || (expected == 0)) {
+    return;
+  }
+  CHECK(prescaler == expected, "cycles %lu: prescaler %lu, expected %lu",
+        (unsigned long)cycles, (unsigned long)prescaler, (unsigned long)expected);
+  CHECK(period <= 0xFFFE, "cycles %lu: period %lu", (unsigned long)cycles, (unsigned long)period);
+  // The division truncates: at most one tick of the prescaled clock short
+  counted = (uint64_t)prescaler * (period + 1);
+  CHECK((counted <= cycles) && (cycles - counted < prescaler), "cycles %lu: %lu x %lu",
+        (unsigned long)cycles, (unsigned long)prescaler, (unsigned long)(period + 1));
+}
+
+static void test_period(void)
+{
+  static const uint32_t edges[] = {
+    0, 1, 2, 0xFFFE, 0xFFFF, 0x10000, 0x10001, 2 * 0xFFFF, 2 * 0xFFFF + 1,
+    0xFFFFUL * 0xFFFE - 1, 0xFFFFUL * 0xFFFE, 0xFFFFUL * 0xFFFE + 1,
+    0xFFFFFFFF
+  };
+  uint32_t cycles, f;
+  unsigned i;
+
+  for(i = 0; i < sizeof(edges) / sizeof(edges[0]); i++) {
+    check_period(edges[i]);
+  }
+  for(cycles = 1; cycles < 0x40000; cycles += 7) {
+    check_period(cycles);
+  }
+  for(cycles = 0x40000; cycles < 0xF0000000UL; cycles += cycles / 97) {
+    check_period(cycles);
+  }
+  // tone(): the timer counts half periods, on a 84 MHz and a 16 MHz clock
+  for(f = 1; f <= 65535; f++) {
+    check_period(84000000UL / (2 * f));
+    check_period(16000000UL / (2 * f));
+  }
+}
+
+static void test_alloc(void)
+{
+  unsigned i;
+
+  CHECK(timer_alloc_user(2) == TIMER_FREE, "free at start");
+  CHECK(timer_alloc_acquire(2, TIMER_USED_PWM), "first reference");
+  CHECK(timer_alloc_user(2) == TIMER_USED_PWM, "owner");
+  CHECK(timer_alloc_acquire(2, TIMER_USED_PWM), "second reference, same user");
+  CHECK(!timer_alloc_acquire(2, TIMER_USED_TONE), "other user refused");
+  CHECK(timer_alloc_acquire(3, TIMER_USED_TONE), "other timer");
+
+  // Released by its owner only, free after the last reference
+  timer_alloc_release(2, TIMER_USED_TONE);
+  CHECK(timer_alloc_user(2) == TIMER_USED_PWM, "released by another user");
+  timer_alloc_release(2, TIMER_USED_PWM);
+  CHECK(timer_alloc_user(2) == TIMER_USED_PWM, "one reference left");
+  timer_alloc_release(2, TIMER_USED_PWM);
+  CHECK(timer_alloc_user(2) == TIMER_FREE, "free after the last reference");
+  timer_alloc_release(2, TIMER_USED_PWM);
+  CHECK(timer_alloc_acquire(2, TIMER_USED_SERVO), "no reference below 0");
+  timer_alloc_release(2, TIMER_USED_SERVO);
+  CHECK(timer_alloc_user(2) == TIMER_FREE, "free again");
+  CHECK(timer_alloc_user(3) == TIMER_USED_TONE, "other timer kept");
+  timer_alloc_release(3, TIMER_USED_TONE);
+
+  // 255 references at most
+  for(i = 0; i < 255; i++) {
+    CHECK(timer_alloc_acquire(5, TIMER_USED_PWM), "reference %u", i + 1);
+  }
+  CHECK(!timer_alloc_acquire(5, TIMER_USED_PWM), "reference 256");
+  for(i = 0; i < 255; i++) {
+    timer_alloc_release(5, TIMER_USED_PWM);
+  }
+  CHECK(timer_alloc_user(5) == TIMER_FREE, "free after 255 releases");
+
+  // Not a timer, not a user
+  CHECK(!timer_alloc_acquire(-1, TIMER_USED_PWM), "index -1");
+  CHECK(!timer_alloc_acquire(TIMER_NUM, TIMER_USED_PWM), "index TIMER_NUM");
+  CHECK(timer_alloc_user(-1) == TIMER_FREE, "user of index -1");
+  timer_alloc_release(-1, TIMER_USED_PWM);
+  CHECK(!timer_alloc_acquire(0, TIMER_FREE), "TIMER_FREE is not a user");
+  CHECK(timer_alloc_user(0) == TIMER_FREE, "still free");
+}
+
+int main(void)
+{
+  test_period();
+  test_alloc();
+
+  if(failures != 0) {
+    printf("%d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("timer_alloc: all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,158 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Host test of the emulated UART frame format (stm32/uart_emul_frame.c).
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+/*
+ * Built and run on the host, from the root of the repository:
+ *   cc -Wall -I cores/arduino/stm32 -o /tmp/test_uart_emul_frame \
+ *      tests/uart_emul_frame/test_uart_emul_frame.c cores/arduino/stm32/uart_emul_frame.c
+ *   /tmp/test_uart_emul_frame
+ * Prints the failed checks and exits with 1 if any.
+ */
+
+#include <stdio.h>
+#include "uart_emul_frame.h"
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                     \
+    if(!(cond)) {                                 \
+      printf("FAIL line %d: ", __LINE__);         \
+      printf(__VA_ARGS__);                        \
+      printf("\n");                               \
+      failures++;                                 \
+    }                                             \
+  } while(0)
+
+static const char *parity_name[] = {"N", "E", "O"};
+
+// Frame built bit by bit as it is seen on the line, LSB first
+static uint16_t reference_frame(uint8_t data, uint8_t wordLength, uint8_t parity, uint8_t stopBits)
+{
+  uint8_t dataBits = (parity != UART_EMUL_PARITY_NONE) ? wordLength - 1 : wordLength;
+  uint16_t frame = 0;
+  uint8_t bit = 0;
+  uint8_t ones = 0;
+  uint8_t i;
+
+  bit++;                          // start bit, low
+  for(i = 0; i < dataBits; i++) {
+    if((i < 8) && ((data >> i) & 1)) {
+      frame |= 1U << bit;
+      ones++;
+    }
+    bit++;
+  }
+  if(parity != UART_EMUL_PARITY_NONE) {
+    // even: total number of ones even, odd: total number of ones odd
+    if((parity == UART_EMUL_PARITY_EVEN) ? (ones & 1) : !(ones & 1)) {
+      frame |= 1U << bit;
+    }
+    bit++;
+  }
+  for(i = 0; i < stopBits; i++) {
+    frame |= 1U << bit++;
+  }
+  return frame;
+}
+
+static void test_known_frames(void)
+{
+  // 'A' = 0x41: start 0, 1000001 0 (LSB first), stop 1
+  CHECK(uart_emul_format_frame(0x41, UART_EMUL_WORDLENGTH_8B, UART_EMUL_PARITY_NONE,
+                               UART_EMUL_STOPBITS_1) == 0x282, "8N1 0x41");
+  CHECK(uart_emul_format_frame(0x41, UART_EMUL_WORDLENGTH_8B, UART_EMUL_PARITY_NONE,
+                               UART_EMUL_STOPBITS_2) == 0x682, "8N2 0x41");
+  // 7 data bits + parity: 0x41 has two ones
+  CHECK(uart_emul_format_frame(0x41, UART_EMUL_WORDLENGTH_8B, UART_EMUL_PARITY_EVEN,
+                               UART_EMUL_STOPBITS_1) == 0x282, "7E1 0x41");
+  CHECK(uart_emul_format_frame(0x41, UART_EMUL_WORDLENGTH_8B, UART_EMUL_PARITY_ODD,
+                               UART_EMUL_STOPBITS_1) == 0x382, "7O1 0x41");
+  // 8 data bits + parity: 0x01 has one one
+  CHECK(uart_emul_format_frame(0x01, UART_EMUL_WORDLENGTH_9B, UART_EMUL_PARITY_EVEN,
+                               UART_EMUL_STOPBITS_1) == 0x602, "8E1 0x01");
+  CHECK(uart_emul_format_frame(0x01, UART_EMUL_WORDLENGTH_9B, UART_EMUL_PARITY_ODD,
+                               UART_EMUL_STOPBITS_1) == 0x402, "8O1 0x01");
+  // 5 data bits: upper bits of the byte ignored
+  CHECK(uart_emul_format_frame(0xFF, UART_EMUL_WORDLENGTH_5B, UART_EMUL_PARITY_NONE,
+                               UART_EMUL_STOPBITS_1) == 0x7E, "5N1 0xFF");
+}
+
+static void test_round_trip(void)
+{
+  uint8_t wordLength, parity, stopBits;
+  uint16_t frame;
+  int data, expected, bit, decoded;
+
+  for(wordLength = UART_EMUL_WORDLENGTH_5B; wordLength <= UART_EMUL_WORDLENGTH_9B; wordLength++) {
+    for(parity = UART_EMUL_PARITY_NONE; parity <= UART_EMUL_PARITY_ODD; parity++) {
+      uint8_t dataBits = (parity != UART_EMUL_PARITY_NONE) ? wordLength - 1 : wordLength;
+      uint8_t dataMask = (dataBits >= 8) ? 0xFF : (uint8_t)((1U << dataBits) - 1);
+
+      // A word of 5 bits with parity has only 4 data bits: not a UART format
+      if(dataBits < 5) {
+        continue;
+      }
+      for(stopBits = UART_EMUL_STOPBITS_1; stopBits <= UART_EMUL_STOPBITS_2; stopBits++) {
+        for(data = 0; data < 256; data++) {
+          expected = data & dataMask;
+          frame = uart_emul_format_frame(data, wordLength, parity, stopBits);
+          CHECK(frame == reference_frame(data, wordLength, parity, stopBits),
+                "%d%s%d 0x%02X: frame 0x%03X", dataBits, parity_name[parity], stopBits, data, frame);
+
+          decoded = uart_emul_decode_frame(frame, wordLength, parity);
+          CHECK(decoded == expected, "%d%s%d 0x%02X: decoded %d",
+                dataBits, parity_name[parity], stopBits, data, decoded);
+
+          // Start bit high
+          decoded = uart_emul_decode_frame(frame | 1, wordLength, parity);
+          CHECK(decoded == -1, "%d%s%d 0x%02X: bad start bit accepted",
+                dataBits, parity_name[parity], stopBits, data);
+
+          // First stop bit low
+          decoded = uart_emul_decode_frame(frame & ~(1U << (wordLength + 1)), wordLength, parity);
+          CHECK(decoded == -1, "%d%s%d 0x%02X: bad stop bit accepted",
+                dataBits, parity_name[parity], stopBits, data);
+
+          if(parity != UART_EMUL_PARITY_NONE) {
+            // Any single bit flipped in the data or the parity bit
+            for(bit = 1; bit <= wordLength; bit++) {
+              decoded = uart_emul_decode_frame(frame ^ (1U << bit), wordLength, parity);
+              CHECK(decoded == -1, "%d%s%d 0x%02X: bit %d flipped, parity error not detected",
+                    dataBits, parity_name[parity], stopBits, data, bit);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+int main(void)
+{
+  test_known_frames();
+  test_round_trip();
+
+  if(failures != 0) {
+    printf("%d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("uart_emul_frame: all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,29 @@
+/*
+ * Host stub of stm32_def.h, for tests/wstring only. Included first with
+ * -include, its guard hides the real stm32_def.h. The heap calls of String
+ * go to the counting heap of the test.
+ */
+#ifndef _STM32_DEF_
+#define _STM32_DEF_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void *test_malloc(size_t size);
+void *test_realloc(void *ptr, size_t size);
+void test_free(void *ptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define malloc(size)        test_malloc(size)
+#define realloc(ptr, size)  test_realloc(ptr, size)
+#define free(ptr)           test_free(ptr)
+
+#endif /* _STM32_DEF_ */
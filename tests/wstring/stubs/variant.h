@@ -0,0 +1,7 @@
+/*
+ * Host stub of the variant header, for tests/wstring only: no memory
+ * pools, String uses malloc/realloc/free.
+ */
+#ifndef _VARIANT_ARDUINO_STM32_
+#define _VARIANT_ARDUINO_STM32_
+#endif
@@ -0,0 +1,411 @@
+/*
+  Copyright (c) 2017 STMicroelectronics. All right reserved.
+
+  Host test and benchmark of the String buffers (WString.cpp).
+
+  This library is free software; you can redistribute it and/or
+  modify it under the terms of the GNU Lesser General Public
+  License as published by the Free Software Foundation; either
+  version 2.1 of the License, or (at your option) any later version.
+
+  This library is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+  See the GNU Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this library; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+/*
+ * Built and run on the host, from the root of the repository:
+ *   gcc -Wall -I tests/wstring/stubs \
+ *      -include tests/wstring/stubs/stm32_def.h -I cores/arduino -I cores/arduino/stm32 \
+ *      -o /tmp/test_wstring tests/wstring/test_wstring.cpp cores/arduino/WString.cpp \
+ *      cores/arduino/itoa.c cores/arduino/numfmt.c cores/arduino/avr/dtostrf.c -lstdc++
+ *   /tmp/test_wstring
+ * The heap of String is the one of the test: it counts the calls, can fail
+ * above a size, and always moves on realloc, the old block being
+ * overwritten, so a stale pointer shows.
+ * Prints the failed checks and exits with 1 if any.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include <utility>
+#include "WString.h"
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                     \
+    if(!(cond)) {                                 \
+      printf("FAIL line %d: ", __LINE__);         \
+      printf(__VA_ARGS__);                        \
+      printf("\n");                               \
+      failures++;                                 \
+    }                                             \
+  } while(0)
+
+/* Test heap ---------------------------------------------------------------*/
+// Block size kept before the data, the macros of stm32_def.h bypassed
+#define HEAP_HEADER 16
+
+static unsigned heapCalls;
+static size_t failAbove = (size_t)-1;
+
+extern "C" void *test_malloc(size_t size)
+{
+  uint8_t *block;
+
+  heapCalls++;
+  if(size > failAbove) {
+    return NULL;
+  }
+  block = (uint8_t *)(malloc)(HEAP_HEADER + size);
+  *(size_t *)block = size;
+  return block + HEAP_HEADER;
+}
+
+extern "C" void test_free(void *ptr)
+{
+  uint8_t *block;
+
+  if(ptr == NULL) {
+    return;
+  }
+  heapCalls++;
+  block = (uint8_t *)ptr - HEAP_HEADER;
+  memset(ptr, '#', *(size_t *)block);
+  (free)(block);
+}
+
+extern "C" void *test_realloc(void *ptr, size_t size)
+{
+  void *newptr;
+  size_t oldSize;
+
+  if(ptr == NULL) {
+    return test_malloc(size);
+  }
+  oldSize = *(size_t *)((uint8_t *)ptr - HEAP_HEADER);
+  newptr = test_malloc(size);
+  if(newptr != NULL) {
+    memcpy(newptr, ptr, (oldSize < size) ? oldSize : size);
+    heapCalls--;
+    test_free(ptr);
+  }
+  return newptr;
+}
+
+/* Tests -------------------------------------------------------------------*/
+class TestString : public String
+{
+public:
+  TestString(const char *cstr = "") : String(cstr) {}
+  TestString(const String &str) : String(str) {}
+  TestString(const TestString &str) : String(str) {}
+  TestString(String &&rval) : String(std::move(rval)) {}
+  TestString(TestString &&rval) : String(std::move(rval)) {}
+  TestString(int value) : String(value) {}
+  TestString & operator = (const TestString &rhs) { String::operator = (rhs); return *this; }
+  TestString & operator = (TestString &&rval) { String::operator = (std::move(rval)); return *this; }
+
+  unsigned int cap(void) const { return capacity; }
+  bool heap(void) const { return isHeap(); }
+  bool valid(void) const { return buffer != NULL; }
+};
+
+static const char *repeat(char c, unsigned int n)
+{
+  static char buf[256];
+
+  memset(buf, c, n);
+  buf[n] = 0;
+  return buf;
+}
+
+// Capacity after a first allocation of n characters: n + 1 bytes rounded
+// to 8
+static unsigned int rounded(unsigned int n)
+{
+  return ((n + 8) & ~7U) - 1;
+}
+
+static void test_sso_boundary(void)
+{
+  unsigned int n;
+
+  CHECK(STRING_SSO_SIZE == 12, "tests written for STRING_SSO_SIZE 12");
+  for(n = 0; n <= STRING_SSO_SIZE + 1; n++) {
+    heapCalls = 0;
+    {
+      TestString s(repeat('a', n));
+      bool inline_ = (n < STRING_SSO_SIZE);
+
+      CHECK(s.heap() == !inline_, "length %u: on the heap %d", n, s.heap());
+      CHECK(s.cap() == (inline_ ? STRING_SSO_SIZE - 1 : rounded(n)),
+            "length %u: capacity %u", n, s.cap());
+      CHECK((s.length() == n) && (strcmp(s.c_str(), repeat('a', n)) == 0), "length %u: content", n);
+    }
+    CHECK(heapCalls == ((n < STRING_SSO_SIZE) ? 0U : 2U), "length %u: %u heap calls", n, heapCalls);
+  }
+
+  // Growing out of the object: 1.5 times the inline capacity, rounded
+  TestString s(repeat('b', STRING_SSO_SIZE - 1));
+  heapCalls = 0;
+  s += 'c';
+  CHECK(s.heap() && (s.cap() == rounded((STRING_SSO_SIZE - 1) * 3 / 2)),
+        "out of the object: capacity %u", s.cap());
+  CHECK(heapCalls == 1, "out of the object: %u heap calls", heapCalls);
+  CHECK(strcmp(s.c_str(), "bbbbbbbbbbbc") == 0, "out of the object: %s", s.c_str());
+
+  // 32-bit integers fit
+  heapCalls = 0;
+  {
+    TestString i(-2147483647 - 1);
+    CHECK(!i.heap() && (strcmp(i.c_str(), "-2147483648") == 0), "INT_MIN: %s", i.c_str());
+  }
+  CHECK(heapCalls == 0, "INT_MIN: %u heap calls", heapCalls);
+}
+
+static void test_growth(void)
+{
+  TestString s(repeat('x', STRING_SSO_SIZE));
+  unsigned int previous = s.cap();
+  unsigned int grows = 0;
+  unsigned int i;
+
+  heapCalls = 0;
+  for(i = 0; i < 1000; i++) {
+    s += (char)('0' + i % 10);
+    if(s.cap() != previous) {
+      CHECK(s.cap() >= previous + previous / 2, "capacity %u after %u", s.cap(), previous);
+      CHECK(((s.cap() + 1) % 8) == 0, "capacity %u not rounded", s.cap());
+      CHECK(s.cap() == rounded(previous + previous / 2), "capacity %u after %u", s.cap(), previous);
+      previous = s.cap();
+      grows++;
+    }
+  }
+  CHECK(heapCalls == grows, "%u heap calls for %u grows", heapCalls, grows);
+  CHECK(grows <= 12, "1000 appends: %u grows", grows);
+  CHECK(s.length() == STRING_SSO_SIZE + 1000, "length %u", s.length());
+  for(i = 0; i < 1000; i++) {
+    if(s[STRING_SSO_SIZE + i] != (char)('0' + i % 10)) {
+      CHECK(0, "content at %u", i);
+      break;
+    }
+  }
+
+  // reserve() gives the exact size asked
+  TestString r;
+  CHECK(r.reserve(100) && (r.cap() == rounded(100)), "reserve: capacity %u", r.cap());
+
+  // Out of memory for 1.5 times: the exact size is retried
+  TestString t(repeat('y', 40));
+  CHECK(t.cap() == 47, "capacity %u", t.cap());
+  failAbove = 60;
+  t += repeat('z', 8);
+  CHECK((t.length() == 48) && (t.cap() == 48), "exact retry: length %u capacity %u", t.length(), t.cap());
+  t += repeat('z', 20);
+  CHECK((t.length() == 48) && (t.cap() == 48), "no memory: length %u capacity %u", t.length(), t.cap());
+  failAbove = (size_t)-1;
+}
+
+static void test_move(void)
+{
+  // Short string: copied from the other object, no heap
+  heapCalls = 0;
+  {
+    TestString a("short");
+    TestString b(std::move(a));
+    CHECK(!b.heap() && (strcmp(b.c_str(), "short") == 0), "moved short: %s", b.c_str());
+    CHECK(!a.valid() && (a.length() == 0), "moved from short: still valid");
+    a = "again";
+    CHECK(strcmp(a.c_str(), "again") == 0, "used after the move: %s", a.c_str());
+  }
+  CHECK(heapCalls == 0, "move short: %u heap calls", heapCalls);
+
+  // Heap string: buffer taken, no heap call
+  TestString c(repeat('h', 30));
+  const char *buffer = c.c_str();
+  heapCalls = 0;
+  TestString d(std::move(c));
+  CHECK(d.heap() && (d.c_str() == buffer), "moved heap: buffer not taken");
+  CHECK(!c.valid(), "moved from heap: still valid");
+  CHECK(heapCalls == 0, "move heap: %u heap calls", heapCalls);
+
+  // To a string with room: copied in place, the source kept empty
+  TestString e(repeat('e', 40));
+  TestString f("fits");
+  buffer = e.c_str();
+  heapCalls = 0;
+  e = std::move(f);
+  CHECK((e.c_str() == buffer) && (strcmp(e.c_str(), "fits") == 0), "moved in place: %s", e.c_str());
+  CHECK(f.valid() && (f.length() == 0), "source of an in place move");
+  CHECK(heapCalls == 0, "move in place: %u heap calls", heapCalls);
+
+  // Short string to a short string
+  TestString g("g");
+  TestString h("hhh");
+  g = std::move(h);
+  CHECK(!g.heap() && (strcmp(g.c_str(), "hhh") == 0), "moved short to short: %s", g.c_str());
+
+  // From an invalid string, and to itself
+  TestString invalid(repeat('i', 20));
+  TestString moved(std::move(invalid));
+  TestString target("target");
+  target = std::move(invalid);
+  CHECK(!target.valid(), "moved from invalid: still valid");
+  moved = std::move(moved);
+  CHECK(strcmp(moved.c_str(), repeat('i', 20)) == 0, "moved to itself: %s", moved.c_str());
+}
+
+static void test_self_concat(void)
+{
+  static const unsigned int lengths[] = {3, 5, 6, 8, 11, 12, 20, 23, 24, 100};
+  char expected[512];
+  unsigned int i;
+
+  for(i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+    TestString s;
+    unsigned int n = lengths[i];
+    unsigned int j;
+
+    for(j = 0; j < n; j++) {
+      s += (char)('a' + j % 26);
+    }
+    memcpy(expected, s.c_str(), n);
+    memcpy(expected + n, s.c_str(), n);
+    expected[2 * n] = 0;
+    s += s;
+    CHECK((s.length() == 2 * n) && (strcmp(s.c_str(), expected) == 0),
+          "s += s, length %u: %s", n, s.c_str());
+
+    // A part of itself
+    expected[2 * n] = 0;
+    strcat(expected, s.c_str() + n);
+    s.concat(s.c_str() + n);
+    CHECK((s.length() == 3 * n) && (strcmp(s.c_str(), expected) == 0),
+          "s.concat(s.c_str() + n), length %u: %s", n, s.c_str());
+  }
+
+  TestString t("ab");
+  TestString u = t + t;
+  CHECK(strcmp(u.c_str(), "abab") == 0, "t + t: %s", u.c_str());
+}
+
+static void test_numbers(void)
+{
+  unsigned int i;
+
+  heapCalls = 0;
+  for(i = 0; i < 100; i++) {
+    TestString k((int)i);
+    k += ":";
+    k += (int)(i * 7);
+    char expected[16];
+    snprintf(expected, sizeof(expected), "%u:%u", i, i * 7);
+    CHECK(strcmp(k.c_str(), expected) == 0, "%s, expected %s", k.c_str(), expected);
+  }
+  CHECK(heapCalls == 0, "short numbers: %u heap calls", heapCalls);
+
+  TestString l(1234567);
+  heapCalls = 0;
+  l += 7654321L;
+  CHECK(strcmp(l.c_str(), "12345677654321") == 0, "long concat: %s", l.c_str());
+  CHECK(heapCalls == 1, "long concat: %u heap calls", heapCalls);
+  heapCalls = 0;
+  l += 1.5;
+  CHECK(strcmp(l.c_str(), "123456776543211.50") == 0, "float concat: %s", l.c_str());
+  CHECK(heapCalls == 0, "float concat: %u heap calls", heapCalls);
+}
+
+/* Benchmark ---------------------------------------------------------------*/
+// Heap calls and host time of typical sketch patterns. The heap calls are
+// what the target saves; the host time only gives the order of magnitude.
+static double elapsed_ns(const struct timespec *start)
+{
+  struct timespec end;
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  return (end.tv_sec - start->tv_sec) * 1e9 + (end.tv_nsec - start->tv_nsec);
+}
+
+static void bench_report(const char *name, unsigned runs, const struct timespec *start)
+{
+  double ns = elapsed_ns(start);
+
+  printf("  %-40s %6.1f heap calls, %8.0f ns\n", name, (double)heapCalls / runs, ns / runs);
+}
+
+static void bench(void)
+{
+  struct timespec start;
+  const unsigned runs = 1000;
+  unsigned r, i;
+
+  printf("String patterns, per run:\n");
+
+  heapCalls = 0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(r = 0; r < runs; r++) {
+    String s;
+    for(i = 0; i < 200; i++) {
+      s += 'x';
+    }
+  }
+  bench_report("200 x s += 'x'", runs, &start);
+  CHECK(heapCalls / runs <= 10, "s += 'x': %u heap calls", heapCalls / runs);
+
+  heapCalls = 0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(r = 0; r < runs; r++) {
+    for(i = 0; i < 100; i++) {
+      String k(i);
+      k += ":";
+      k += i * 7;
+    }
+  }
+  bench_report("100 x String k(i); k += \":\"; k += i * 7", runs, &start);
+  CHECK(heapCalls == 0, "short numbers: %u heap calls", heapCalls);
+
+  heapCalls = 0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(r = 0; r < runs; r++) {
+    String line = String("T=") + 21.5 + " H=" + 40 + " P=" + 1013;
+  }
+  bench_report("String(\"T=\") + 21.5 + \" H=\" + ...", runs, &start);
+
+  heapCalls = 0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for(r = 0; r < runs; r++) {
+    String json = "{";
+    for(i = 0; i < 10; i++) {
+      json += "\"k";
+      json += i;
+      json += "\":";
+      json += i * 100;
+      json += ',';
+    }
+    json += '}';
+  }
+  bench_report("JSON object of 10 members", runs, &start);
+}
+
+int main(void)
+{
+  test_sso_boundary();
+  test_growth();
+  test_move();
+  test_self_concat();
+  test_numbers();
+  bench();
+
+  if(failures != 0) {
+    printf("%d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("wstring: all checks passed\n");
+  return 0;
+}
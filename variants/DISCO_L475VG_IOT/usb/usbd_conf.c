@@ -330,6 +330,10 @@ USBD_StatusTypeDef USBD_LL_Init(USBD_HandleTypeDef *pdev)
   HAL_PCDEx_SetRxFiFo(&g_hpcd, 0x36);
   HAL_PCDEx_SetTxFiFo(&g_hpcd, 0, 0x32);
   HAL_PCDEx_SetTxFiFo(&g_hpcd, 1, 0xC8);
+#ifdef USBD_USE_CDC
+  /* CDC notification endpoint */
+  HAL_PCDEx_SetTxFiFo(&g_hpcd, 2, 0x10);
+#endif
 
   return USBD_OK;
 }
@@ -64,6 +64,12 @@
 #ifdef USBD_USE_HID_COMPOSITE
 extern USBD_DescriptorsTypeDef HID_Desc;
 #endif
+#ifdef USBD_USE_CDC
+extern USBD_DescriptorsTypeDef CDC_Desc;
+#endif
+#ifdef USBD_USE_MSC
+extern USBD_DescriptorsTypeDef MSC_Desc;
+#endif
 
 uint8_t *USBD_DeviceDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
 uint8_t *USBD_LangIDStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
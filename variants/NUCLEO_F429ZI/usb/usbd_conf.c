@@ -350,8 +350,14 @@ USBD_StatusTypeDef USBD_LL_Init(USBD_HandleTypeDef *pdev)
   HAL_PCD_Init(&g_hpcd);
 
   HAL_PCDEx_SetRxFiFo(&g_hpcd, 0x80);
+#if defined(USBD_USE_CDC) || defined(USBD_USE_MSC)
+  /* Two packets of the bulk IN endpoint, 320 words in total */
+  HAL_PCDEx_SetTxFiFo(&g_hpcd, 0, 0x20);
+  HAL_PCDEx_SetTxFiFo(&g_hpcd, 1, 0x40);
+#else
   HAL_PCDEx_SetTxFiFo(&g_hpcd, 0, 0x40);
   HAL_PCDEx_SetTxFiFo(&g_hpcd, 1, 0x10);
+#endif
   HAL_PCDEx_SetTxFiFo(&g_hpcd, 2, 0x10);
 
   return USBD_OK;
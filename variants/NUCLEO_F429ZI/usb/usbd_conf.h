@@ -65,6 +65,8 @@
 #define USBD_MAX_STR_DESC_SIZ                 0x100
 #define USBD_SUPPORT_USER_STRING              0
 #define USBD_SELF_POWERED                     1
+/* Size of the MSC transfers to and from the storage, multiple of 512 */
+#define MSC_MEDIA_PACKET                      4096
 #define USBD_DEBUG_LEVEL                      3
 
 /* Exported macro ------------------------------------------------------------*/
@@ -60,7 +60,20 @@
 #define  USB_SIZ_STRING_SERIAL       0x1A
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
+#ifdef USBD_USE_HID_COMPOSITE
 extern USBD_DescriptorsTypeDef HID_Desc;
+#endif
+#ifdef USBD_USE_CDC
+extern USBD_DescriptorsTypeDef CDC_Desc;
+#endif
+#ifdef USBD_USE_MSC
+extern USBD_DescriptorsTypeDef MSC_Desc;
+#endif
+
+uint8_t *USBD_DeviceDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+uint8_t *USBD_LangIDStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+uint8_t *USBD_ManufacturerStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
+uint8_t *USBD_SerialStrDescriptor(USBD_SpeedTypeDef speed, uint16_t *length);
 #endif // USBCON
 #endif /* __USBD_DESC_H */
 
@@ -70,7 +70,7 @@
 #define HAL_PWR_MODULE_ENABLED
 #define HAL_RCC_MODULE_ENABLED
 // #define HAL_RNG_MODULE_ENABLED
-// #define HAL_RTC_MODULE_ENABLED
+#define HAL_RTC_MODULE_ENABLED
 #define HAL_SPI_MODULE_ENABLED
 #define HAL_TIM_MODULE_ENABLED
 // #define HAL_TSC_MODULE_ENABLED
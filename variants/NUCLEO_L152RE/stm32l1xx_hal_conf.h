@@ -72,7 +72,7 @@
 /*#define HAL_PCD_MODULE_ENABLED*/
 #define HAL_PWR_MODULE_ENABLED
 #define HAL_RCC_MODULE_ENABLED
-/*#define HAL_RTC_MODULE_ENABLED*/
+#define HAL_RTC_MODULE_ENABLED
 /*#define HAL_SD_MODULE_ENABLED*/
 /*#define HAL_SMARTCARD_MODULE_ENABLED*/
 #define HAL_SPI_MODULE_ENABLED
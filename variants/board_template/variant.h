@@ -110,7 +110,7 @@ enum {
 // DEBUG_UART could be redefined to print on another instance than 'Serial'
 //#define DEBUG_UART              ((USART_TypeDef *) U(S)ARTX) // ex: USART3
 
-// UART Emulation (uncomment if needed, required TIM1)
+// UART Emulation pins used by the GSM library (uncomment if needed)
 //#define UART_EMUL_RX            PX_n // PinName used for RX
 //#define UART_EMUL_TX            PX_n // PinName used for TX
 